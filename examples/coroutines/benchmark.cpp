@@ -0,0 +1,166 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/* Include the C++ DDS API. */
+#include "dds/dds.hpp"
+
+/* Include the optional coroutine layer, which needs C++20. */
+#include "org/eclipse/cyclonedds/core/Coroutines.hpp"
+
+/* Include data type and specific traits to be used with the C++ DDS API. */
+#include "Benchmark.hpp"
+
+using namespace org::eclipse::cyclonedds;
+
+#if defined(CYCLONEDDS_HAS_COROUTINES)
+
+typedef dds::sub::DataReader<Benchmark::Sample> Reader;
+
+/* Shared by all logical subscribers of one run. */
+struct Progress
+{
+    explicit Progress(size_t subscribers) : remaining(subscribers) { }
+    std::atomic<size_t> remaining;
+};
+
+static uint32_t count_valid(const dds::sub::LoanedSamples<Benchmark::Sample>& samples)
+{
+    uint32_t n = 0;
+    for (auto it = samples.begin(); it != samples.end(); ++it) {
+        if (it->info().valid()) {
+            n++;
+        }
+    }
+    return n;
+}
+
+/* Approach 1: every logical subscriber blocks a thread in a WaitSet of its own. */
+static void waitset_subscriber(Reader reader, uint32_t samples, Progress& progress)
+{
+    dds::core::cond::WaitSet waitset;
+    dds::sub::cond::ReadCondition rc(reader, dds::sub::status::DataState::any());
+    waitset += rc;
+
+    uint32_t received = 0;
+    while (received < samples) {
+        waitset.wait(dds::core::Duration::from_secs(10));
+        received += count_valid(reader.take());
+    }
+    progress.remaining--;
+}
+
+/* Approach 2: every logical subscriber is a coroutine, the scheduler resumes
+ * them on a few threads. */
+static core::Task coroutine_subscriber(core::CoroutineScheduler& scheduler,
+                                       Reader reader, uint32_t samples, Progress& progress)
+{
+    uint32_t received = 0;
+    while (received < samples) {
+        received += count_valid(co_await scheduler.take(reader));
+    }
+    progress.remaining--;
+}
+
+static void publish(dds::pub::DataWriter<Benchmark::Sample>& writer,
+                    size_t subscribers, uint32_t samples, Progress& progress)
+{
+    while (writer.publication_matched_status().current_count() < static_cast<int32_t>(subscribers)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < samples; i++) {
+        writer << Benchmark::Sample(static_cast<int32_t>(i));
+    }
+    while (progress.remaining > 0) {
+        std::this_thread::yield();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    double ms = std::chrono::duration<double, std::milli>(elapsed).count();
+    std::cout << "  " << ms << " ms, "
+              << (static_cast<double>(samples) * static_cast<double>(subscribers) * 1000.0 / ms)
+              << " deliveries/s" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    size_t subscribers = (argc > 1) ? std::strtoul(argv[1], NULL, 10) : 100;
+    uint32_t samples = (argc > 2) ? static_cast<uint32_t>(std::strtoul(argv[2], NULL, 10)) : 1000;
+    uint32_t threads = (argc > 3) ? static_cast<uint32_t>(std::strtoul(argv[3], NULL, 10)) : 2;
+
+    try {
+        dds::domain::DomainParticipant participant(domain::default_id());
+        dds::topic::Topic<Benchmark::Sample> topic(participant, "ddscxx_coroutines_benchmark");
+        dds::sub::Subscriber subscriber(participant);
+        dds::pub::Publisher publisher(participant);
+
+        /* Reliable and keeping everything, so that every subscriber receives
+         * every sample and both approaches do the same amount of work. */
+        dds::sub::qos::DataReaderQos rqos = subscriber.default_datareader_qos();
+        rqos << dds::core::policy::Reliability::Reliable()
+             << dds::core::policy::History::KeepAll();
+        dds::pub::qos::DataWriterQos wqos = publisher.default_datawriter_qos();
+        wqos << dds::core::policy::Reliability::Reliable()
+             << dds::core::policy::History::KeepAll();
+
+        std::cout << "=== " << subscribers << " subscribers, " << samples << " samples" << std::endl;
+
+        {
+            std::cout << "WaitSet per thread (" << subscribers << " threads):" << std::endl;
+            Progress progress(subscribers);
+            std::vector<Reader> readers;
+            std::vector<std::thread> workers;
+            for (size_t i = 0; i < subscribers; i++) {
+                readers.push_back(Reader(subscriber, topic, rqos));
+                workers.push_back(std::thread(waitset_subscriber, readers.back(), samples, std::ref(progress)));
+            }
+            dds::pub::DataWriter<Benchmark::Sample> writer(publisher, topic, wqos);
+            publish(writer, subscribers, samples, progress);
+            for (auto it = workers.begin(); it != workers.end(); ++it) {
+                it->join();
+            }
+        }
+
+        {
+            std::cout << "Coroutines (" << threads << " threads):" << std::endl;
+            Progress progress(subscribers);
+            std::vector<Reader> readers;
+            core::CoroutineScheduler scheduler(threads);
+            for (size_t i = 0; i < subscribers; i++) {
+                readers.push_back(Reader(subscriber, topic, rqos));
+                coroutine_subscriber(scheduler, readers.back(), samples, progress);
+            }
+            dds::pub::DataWriter<Benchmark::Sample> writer(publisher, topic, wqos);
+            publish(writer, subscribers, samples, progress);
+        }
+    } catch (const dds::core::Exception& e) {
+        std::cerr << "=== [Benchmark] Exception: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+#else
+
+int main() {
+    std::cerr << "=== [Benchmark] Compiled without coroutine support." << std::endl;
+    return EXIT_FAILURE;
+}
+
+#endif
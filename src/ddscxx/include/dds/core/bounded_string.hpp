@@ -0,0 +1,25 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+#ifndef CYCLONEDDS_DDS_CORE_BOUNDED_STRING_HPP_
+#define CYCLONEDDS_DDS_CORE_BOUNDED_STRING_HPP_
+
+#include <dds/core/detail/bounded_string.hpp>
+
+namespace dds
+{
+namespace core
+{
+using dds::core::detail::bounded_string;
+}
+}
+
+#endif /* CYCLONEDDS_DDS_CORE_BOUNDED_STRING_HPP_ */
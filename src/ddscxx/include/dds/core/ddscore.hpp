@@ -24,6 +24,8 @@
 #include <dds/core/Duration.hpp>
 #include <dds/core/InstanceHandle.hpp>
 #include <dds/core/array.hpp>
+#include <dds/core/bounded_sequence.hpp>
+#include <dds/core/bounded_string.hpp>
 
 #include <dds/core/Entity.hpp>
 #include <dds/core/cond/GuardCondition.hpp>
@@ -0,0 +1,323 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+#ifndef CYCLONEDDS_DDS_CORE_DETAIL_BOUNDED_SEQUENCE_HPP_
+#define CYCLONEDDS_DDS_CORE_DETAIL_BOUNDED_SEQUENCE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace dds
+{
+namespace core
+{
+namespace detail
+{
+
+/*
+ * Sequence of at most N elements of type T, stored inline.
+ *
+ * The interface is the subset of std::vector that makes sense for a container
+ * with a fixed capacity. Growing the sequence beyond N elements throws
+ * std::length_error. As the elements are part of the object itself, a
+ * bounded_sequence never allocates memory.
+ */
+template <typename T, uint32_t N>
+class bounded_sequence
+{
+    static_assert(N > 0, "the bound of a bounded_sequence must be at least 1");
+
+public:
+    typedef T value_type;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    bounded_sequence() noexcept : size_(0) { }
+
+    explicit bounded_sequence(size_type count) : size_(0)
+    {
+        this->resize(count);
+    }
+
+    bounded_sequence(size_type count, const T& value) : size_(0)
+    {
+        this->assign(count, value);
+    }
+
+    template <typename InputIt, typename = typename std::enable_if<
+        !std::is_integral<InputIt>::value>::type>
+    bounded_sequence(InputIt first, InputIt last) : size_(0)
+    {
+        this->assign(first, last);
+    }
+
+    bounded_sequence(std::initializer_list<T> init) : size_(0)
+    {
+        this->assign(init.begin(), init.end());
+    }
+
+    bounded_sequence(const bounded_sequence& other) : size_(0)
+    {
+        std::uninitialized_copy(other.begin(), other.end(), this->begin());
+        this->size_ = other.size_;
+    }
+
+    bounded_sequence(bounded_sequence&& other)
+        noexcept(std::is_nothrow_move_constructible<T>::value) : size_(0)
+    {
+        std::uninitialized_copy(std::make_move_iterator(other.begin()),
+                                std::make_move_iterator(other.end()), this->begin());
+        this->size_ = other.size_;
+    }
+
+    ~bounded_sequence()
+    {
+        this->clear();
+    }
+
+    bounded_sequence& operator=(const bounded_sequence& other)
+    {
+        if (this != &other) {
+            this->assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    bounded_sequence& operator=(bounded_sequence&& other)
+        noexcept(std::is_nothrow_move_assignable<T>::value &&
+                 std::is_nothrow_move_constructible<T>::value)
+    {
+        if (this != &other) {
+            this->move_assign(other);
+        }
+        return *this;
+    }
+
+    bounded_sequence& operator=(std::initializer_list<T> init)
+    {
+        this->assign(init.begin(), init.end());
+        return *this;
+    }
+
+    void assign(size_type count, const T& value)
+    {
+        check_length(count);
+        this->clear();
+        std::uninitialized_fill_n(this->begin(), count, value);
+        this->size_ = count;
+    }
+
+    template <typename InputIt, typename = typename std::enable_if<
+        !std::is_integral<InputIt>::value>::type>
+    void assign(InputIt first, InputIt last)
+    {
+        this->clear();
+        for (; first != last; ++first) {
+            this->push_back(*first);
+        }
+    }
+
+    void assign(std::initializer_list<T> init)
+    {
+        this->assign(init.begin(), init.end());
+    }
+
+    reference at(size_type pos)
+    {
+        if (pos >= this->size_) {
+            throw std::out_of_range("bounded_sequence::at");
+        }
+        return this->begin()[pos];
+    }
+
+    const_reference at(size_type pos) const
+    {
+        if (pos >= this->size_) {
+            throw std::out_of_range("bounded_sequence::at");
+        }
+        return this->begin()[pos];
+    }
+
+    reference operator[](size_type pos) { return this->begin()[pos]; }
+    const_reference operator[](size_type pos) const { return this->begin()[pos]; }
+
+    reference front() { return this->begin()[0]; }
+    const_reference front() const { return this->begin()[0]; }
+    reference back() { return this->begin()[this->size_ - 1]; }
+    const_reference back() const { return this->begin()[this->size_ - 1]; }
+
+    T* data() noexcept { return std::launder(reinterpret_cast<T*>(this->storage_)); }
+    const T* data() const noexcept { return std::launder(reinterpret_cast<const T*>(this->storage_)); }
+
+    iterator begin() noexcept { return this->data(); }
+    const_iterator begin() const noexcept { return this->data(); }
+    const_iterator cbegin() const noexcept { return this->data(); }
+    iterator end() noexcept { return this->data() + this->size_; }
+    const_iterator end() const noexcept { return this->data() + this->size_; }
+    const_iterator cend() const noexcept { return this->data() + this->size_; }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(this->end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(this->end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(this->begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(this->begin()); }
+
+    bool empty() const noexcept { return this->size_ == 0; }
+    size_type size() const noexcept { return this->size_; }
+    static constexpr size_type max_size() noexcept { return N; }
+    static constexpr size_type capacity() noexcept { return N; }
+
+    void reserve(size_type new_cap)
+    {
+        check_length(new_cap);
+    }
+
+    void clear() noexcept
+    {
+        destroy(this->begin(), this->end());
+        this->size_ = 0;
+    }
+
+    void push_back(const T& value)
+    {
+        this->emplace_back(value);
+    }
+
+    void push_back(T&& value)
+    {
+        this->emplace_back(std::move(value));
+    }
+
+    template <typename... Args>
+    reference emplace_back(Args&&... args)
+    {
+        check_length(this->size_ + 1);
+        T* elem = ::new (static_cast<void*>(this->end())) T(std::forward<Args>(args)...);
+        this->size_++;
+        return *elem;
+    }
+
+    void pop_back()
+    {
+        this->size_--;
+        this->end()->~T();
+    }
+
+    void resize(size_type count)
+    {
+        check_length(count);
+        if (count < this->size_) {
+            destroy(this->begin() + count, this->end());
+            this->size_ = count;
+        } else {
+            for (; this->size_ < count; this->size_++) {
+                ::new (static_cast<void*>(this->end())) T();
+            }
+        }
+    }
+
+    void resize(size_type count, const T& value)
+    {
+        check_length(count);
+        if (count < this->size_) {
+            destroy(this->begin() + count, this->end());
+            this->size_ = count;
+        } else {
+            for (; this->size_ < count; this->size_++) {
+                ::new (static_cast<void*>(this->end())) T(value);
+            }
+        }
+    }
+
+    void swap(bounded_sequence& other)
+        noexcept(std::is_nothrow_move_assignable<T>::value &&
+                 std::is_nothrow_move_constructible<T>::value)
+    {
+        bounded_sequence tmp(std::move(other));
+        other.move_assign(*this);
+        this->move_assign(tmp);
+    }
+
+    friend void swap(bounded_sequence& a, bounded_sequence& b) noexcept(noexcept(a.swap(b)))
+    {
+        a.swap(b);
+    }
+
+    friend bool operator==(const bounded_sequence& a, const bounded_sequence& b)
+    {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+    }
+
+    friend bool operator!=(const bounded_sequence& a, const bounded_sequence& b)
+    {
+        return !(a == b);
+    }
+
+    friend bool operator<(const bounded_sequence& a, const bounded_sequence& b)
+    {
+        return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+    }
+
+    friend bool operator>(const bounded_sequence& a, const bounded_sequence& b) { return b < a; }
+    friend bool operator<=(const bounded_sequence& a, const bounded_sequence& b) { return !(b < a); }
+    friend bool operator>=(const bounded_sequence& a, const bounded_sequence& b) { return !(a < b); }
+
+private:
+    static void check_length(size_type count)
+    {
+        if (count > N) {
+            throw std::length_error("bounded_sequence exceeds its bound");
+        }
+    }
+
+    static void destroy(T* first, T* last) noexcept
+    {
+        for (; first != last; ++first) {
+            first->~T();
+        }
+    }
+
+    void move_assign(bounded_sequence& other)
+    {
+        const size_type common = std::min(this->size_, other.size_);
+        std::move(other.begin(), other.begin() + common, this->begin());
+        if (other.size_ > this->size_) {
+            std::uninitialized_copy(std::make_move_iterator(other.begin() + common),
+                                    std::make_move_iterator(other.end()), this->end());
+        } else {
+            destroy(this->begin() + common, this->end());
+        }
+        this->size_ = other.size_;
+    }
+
+    alignas(T) unsigned char storage_[N * sizeof(T)];
+    size_type size_;
+};
+
+}
+}
+}
+
+#endif /* CYCLONEDDS_DDS_CORE_DETAIL_BOUNDED_SEQUENCE_HPP_ */
@@ -0,0 +1,262 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+#ifndef CYCLONEDDS_DDS_CORE_DETAIL_BOUNDED_STRING_HPP_
+#define CYCLONEDDS_DDS_CORE_DETAIL_BOUNDED_STRING_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace dds
+{
+namespace core
+{
+namespace detail
+{
+
+/*
+ * String of at most N characters, stored inline and always null terminated.
+ *
+ * The interface is the subset of std::string that generated types and their
+ * users need. Growing the string beyond N characters throws std::length_error.
+ * A bounded_string never allocates memory and is trivially copyable.
+ */
+template <uint32_t N>
+class bounded_string
+{
+    static_assert(N > 0, "the bound of a bounded_string must be at least 1");
+
+public:
+    typedef char value_type;
+    typedef size_t size_type;
+    typedef char* iterator;
+    typedef const char* const_iterator;
+
+    bounded_string() noexcept : size_(0)
+    {
+        this->data_[0] = '\0';
+    }
+
+    bounded_string(const char* str)
+    {
+        this->assign(str);
+    }
+
+    bounded_string(const char* str, size_type count)
+    {
+        this->assign(str, count);
+    }
+
+    bounded_string(std::string_view str)
+    {
+        this->assign(str);
+    }
+
+    bounded_string(const std::string& str)
+    {
+        this->assign(str);
+    }
+
+    bounded_string& operator=(const char* str)
+    {
+        return this->assign(str);
+    }
+
+    bounded_string& operator=(std::string_view str)
+    {
+        return this->assign(str);
+    }
+
+    bounded_string& operator=(const std::string& str)
+    {
+        return this->assign(str);
+    }
+
+    bounded_string& assign(const char* str, size_type count)
+    {
+        check_length(count);
+        /* the source may overlap with this string */
+        memmove(this->data_, str, count);
+        this->data_[count] = '\0';
+        this->size_ = static_cast<uint32_t>(count);
+        return *this;
+    }
+
+    bounded_string& assign(const char* str)
+    {
+        return this->assign(str, strlen(str));
+    }
+
+    bounded_string& assign(std::string_view str)
+    {
+        return this->assign(str.data(), str.size());
+    }
+
+    bounded_string& assign(const std::string& str)
+    {
+        return this->assign(str.data(), str.size());
+    }
+
+    char& at(size_type pos)
+    {
+        if (pos >= this->size_) {
+            throw std::out_of_range("bounded_string::at");
+        }
+        return this->data_[pos];
+    }
+
+    const char& at(size_type pos) const
+    {
+        if (pos >= this->size_) {
+            throw std::out_of_range("bounded_string::at");
+        }
+        return this->data_[pos];
+    }
+
+    char& operator[](size_type pos) { return this->data_[pos]; }
+    const char& operator[](size_type pos) const { return this->data_[pos]; }
+
+    const char* c_str() const noexcept { return this->data_; }
+    const char* data() const noexcept { return this->data_; }
+    char* data() noexcept { return this->data_; }
+
+    iterator begin() noexcept { return this->data_; }
+    const_iterator begin() const noexcept { return this->data_; }
+    iterator end() noexcept { return this->data_ + this->size_; }
+    const_iterator end() const noexcept { return this->data_ + this->size_; }
+
+    bool empty() const noexcept { return this->size_ == 0; }
+    size_type size() const noexcept { return this->size_; }
+    size_type length() const noexcept { return this->size_; }
+    static constexpr size_type max_size() noexcept { return N; }
+    static constexpr size_type capacity() noexcept { return N; }
+
+    void clear() noexcept
+    {
+        this->size_ = 0;
+        this->data_[0] = '\0';
+    }
+
+    void push_back(char c)
+    {
+        check_length(this->size_ + 1u);
+        this->data_[this->size_++] = c;
+        this->data_[this->size_] = '\0';
+    }
+
+    void pop_back()
+    {
+        this->data_[--this->size_] = '\0';
+    }
+
+    bounded_string& append(const char* str, size_type count)
+    {
+        check_length(this->size_ + count);
+        memmove(this->data_ + this->size_, str, count);
+        this->size_ += static_cast<uint32_t>(count);
+        this->data_[this->size_] = '\0';
+        return *this;
+    }
+
+    bounded_string& append(std::string_view str)
+    {
+        return this->append(str.data(), str.size());
+    }
+
+    bounded_string& operator+=(std::string_view str)
+    {
+        return this->append(str);
+    }
+
+    bounded_string& operator+=(char c)
+    {
+        this->push_back(c);
+        return *this;
+    }
+
+    void resize(size_type count, char c = '\0')
+    {
+        check_length(count);
+        if (count > this->size_) {
+            memset(this->data_ + this->size_, c, count - this->size_);
+        }
+        this->size_ = static_cast<uint32_t>(count);
+        this->data_[this->size_] = '\0';
+    }
+
+    operator std::string_view() const noexcept
+    {
+        return std::string_view(this->data_, this->size_);
+    }
+
+    std::string str() const
+    {
+        return std::string(this->data_, this->size_);
+    }
+
+    friend bool operator==(const bounded_string& a, const bounded_string& b) noexcept
+    {
+        return std::string_view(a) == std::string_view(b);
+    }
+
+    friend bool operator!=(const bounded_string& a, const bounded_string& b) noexcept
+    {
+        return !(a == b);
+    }
+
+#define BOUNDED_STRING_COMPARISON(other_type) \
+    friend bool operator==(const bounded_string& a, other_type b) noexcept \
+    { return std::string_view(a) == std::string_view(b); } \
+    friend bool operator==(other_type a, const bounded_string& b) noexcept \
+    { return std::string_view(a) == std::string_view(b); } \
+    friend bool operator!=(const bounded_string& a, other_type b) noexcept \
+    { return !(a == b); } \
+    friend bool operator!=(other_type a, const bounded_string& b) noexcept \
+    { return !(a == b); }
+
+    BOUNDED_STRING_COMPARISON(const char*)
+    BOUNDED_STRING_COMPARISON(const std::string&)
+    BOUNDED_STRING_COMPARISON(std::string_view)
+
+#undef BOUNDED_STRING_COMPARISON
+
+    friend bool operator<(const bounded_string& a, const bounded_string& b) noexcept
+    {
+        return std::string_view(a) < std::string_view(b);
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const bounded_string& str)
+    {
+        return os << std::string_view(str);
+    }
+
+private:
+    static void check_length(size_type count)
+    {
+        if (count > N) {
+            throw std::length_error("bounded_string exceeds its bound");
+        }
+    }
+
+    uint32_t size_;
+    char data_[N + 1];
+};
+
+}
+}
+}
+
+#endif /* CYCLONEDDS_DDS_CORE_DETAIL_BOUNDED_STRING_HPP_ */
@@ -51,14 +51,19 @@ class TSuspendedPublication;
  *
  * This object suspends the publication of all DataWriter objects contained by
  * the given Publisher. The data written, disposed or unregistered by a DataWriter is
- * stored in the history buffer of the DataWriter and therefore, depending on its QoS
- * settings, the following operations may block (see the operation descriptions for
- * more information):
+ * held back by the Publisher and sent on resume, in the order in which it was
+ * written. The Publisher holds back a limited number of updates; beyond that,
+ * the following operations throw dds::core::OutOfResourcesError:
  * - dds::pub::DataWriter.write (and its overloaded counterparts).
  * - dds::pub::DataWriter.operator<< (and its overloaded counterparts).
  * - dds::pub::DataWriter.unregister_instance (and its overloaded counterparts).
  * - dds::pub::DataWriter.dispose_instance (and its overloaded counterparts).
  *
+ * The updates are only packed into fewer network messages when batching is
+ * enabled for the writers, see
+ * org::eclipse::cyclonedds::pub::AnyDataWriterDelegate::set_batch(). Without
+ * batching, every update is still sent in a message of its own.
+ *
  * @see for more information: @ref DCPS_Modules_Publication "Publication"
  * @see dds::pub::Publisher
  */
@@ -27,6 +27,7 @@
 #include <org/eclipse/cyclonedds/core/ScopedLock.hpp>
 #include <org/eclipse/cyclonedds/pub/AnyDataWriterDelegate.hpp>
 #include <dds/dds.h>
+#include "dds/ddsi/ddsi_serdata.h"
 
 namespace dds {
     namespace pub {
@@ -79,6 +80,13 @@ public:
 
     void write_cdr(const org::eclipse::cyclonedds::topic::CDRBlob& sample, const dds::core::Time& timestamp);
 
+    void write_cdr(const org::eclipse::cyclonedds::topic::CDRBlob& sample,
+                   const ::dds::core::InstanceHandle& instance);
+
+    void write_cdr(const org::eclipse::cyclonedds::topic::CDRBlob& sample,
+                   const ::dds::core::InstanceHandle& instance,
+                   const dds::core::Time& timestamp);
+
     void dispose_cdr(const org::eclipse::cyclonedds::topic::CDRBlob& sample);
 
     void dispose_cdr(const org::eclipse::cyclonedds::topic::CDRBlob& sample, const dds::core::Time& timestamp);
@@ -102,6 +110,13 @@ public:
     void write(const dds::topic::TopicInstance<T>& i,
                const dds::core::Time& timestamp);
 
+    /* Like write(), but for use in loops that expect failures, a timeout while
+     * waiting for resources in particular: the ddsc result is returned instead
+     * of raised as an exception. */
+    dds_return_t try_write(const T& sample) noexcept;
+
+    dds_return_t try_write(const T& sample, const dds::core::Time& timestamp) noexcept;
+
     void writedispose(const T& sample);
 
     void writedispose(const T& sample, const dds::core::Time& timestamp);
@@ -140,6 +155,10 @@ public:
     const ::dds::core::InstanceHandle register_instance(const T& key,
                                                         const dds::core::Time& timestamp);
 
+    template <typename FWIterator>
+    ::dds::core::InstanceHandleSeq register_instances(const FWIterator& begin,
+                                                      const FWIterator& end);
+
     void unregister_instance(const ::dds::core::InstanceHandle& handle,
                              const dds::core::Time& timestamp);
 
@@ -184,9 +203,29 @@ public:
     void on_publication_matched(dds_entity_t,
           org::eclipse::cyclonedds::core::PublicationMatchedStatusDelegate &sd);
 
+    org::eclipse::cyclonedds::core::EntityDelegate* listener_parent() const;
+
 private:
+   void calculate_keyhash(const T& sample,
+                          const std::vector<unsigned char>& key,
+                          org::eclipse::cyclonedds::pub::KeyHashCache::entry& e);
+
+   ddsi_serdata* keyed_serdata(const T& sample, ddsi_serdata_kind kind);
+
+   void write_keyed(const T& sample, const dds::core::Time& timestamp);
+
+   dds_return_t try_write_keyed(const T& sample, const dds::core::Time& timestamp) noexcept;
+
+   bool write_cached(const T& sample,
+                     const ::dds::core::InstanceHandle& instance,
+                     const dds::core::Time& timestamp,
+                     bool dispose);
+
+   dds_instance_handle_t register_keyed(const T& key, const dds::core::Time& timestamp);
+
    dds::pub::Publisher                    pub_;
    dds::topic::Topic<T>                   topic_;
+   bool                                   serdata_writes_;
 };
 
 
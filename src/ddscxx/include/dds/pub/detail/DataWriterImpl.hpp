@@ -359,9 +359,12 @@ DataWriter<T, DELEGATE>::listener() const
  *
  ***************************************************************************/
 
+#include <new>
+
 #include <dds/pub/AnyDataWriter.hpp>
 #include <dds/pub/DataWriterListener.hpp>
 #include <org/eclipse/cyclonedds/pub/AnyDataWriterDelegate.hpp>
+#include <org/eclipse/cyclonedds/topic/datatopic.hpp>
 
 template <typename T>
 dds::pub::detail::DataWriter<T>::DataWriter(
@@ -370,7 +373,8 @@ dds::pub::detail::DataWriter<T>::DataWriter(
     const dds::pub::qos::DataWriterQos& qos,
     dds::pub::DataWriterListener<T>* listener,
     const dds::core::status::StatusMask& mask)
-    : ::org::eclipse::cyclonedds::pub::AnyDataWriterDelegate(qos, topic), pub_(pub), topic_(topic)
+    : ::org::eclipse::cyclonedds::pub::AnyDataWriterDelegate(qos, topic), pub_(pub), topic_(topic),
+      serdata_writes_(false)
 {
     DDSCXX_WARNING_MSVC_OFF(6326)
     if (dds::topic::is_topic_type<T>::value == 0) {
@@ -385,17 +389,20 @@ dds::pub::detail::DataWriter<T>::DataWriter(
 
     // get and validate the ddsc qos
     dwQos.check();
-    dds_qos_t *ddsc_qos = dwQos.ddsc_qos();
+    org::eclipse::cyclonedds::core::DdscQosCache::qos_ref ddsc_qos = dwQos.cached_ddsc_qos();
 
     std::string name = topic.name() + "_datawriter";
 
-    dds_entity_t ddsc_writer = dds_create_writer (ddsc_pub, ddsc_topic, ddsc_qos, NULL);
-    dds_free(ddsc_qos);
+    dds_entity_t ddsc_writer = dds_create_writer (ddsc_pub, ddsc_topic, ddsc_qos.get(), NULL);
     ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ddsc_writer, "Could not create DataWriter.");
     topic_.delegate()->incrNrDependents();
 
     this->set_ddsc_entity(ddsc_writer);
 
+    /* Samples written through shared memory are handled by ddsc itself. In all
+     * other cases the serdata is created here, so the keyhash cache is used. */
+    this->serdata_writes_ = !dds_is_shared_memory_available(ddsc_writer);
+
     this->listener(listener, mask);
 }
 
@@ -510,6 +517,50 @@ dds::pub::detail::DataWriter<T>::write_cdr(
                                   timestamp);
 }
 
+template <typename T>
+void
+dds::pub::detail::DataWriter<T>::write_cdr(
+            const org::eclipse::cyclonedds::topic::CDRBlob& sample,
+            const ::dds::core::InstanceHandle& instance)
+{
+    this->write_cdr(sample, instance, dds::core::Time::invalid());
+}
+
+template <typename T>
+void
+dds::pub::detail::DataWriter<T>::write_cdr(
+            const org::eclipse::cyclonedds::topic::CDRBlob& sample,
+            const ::dds::core::InstanceHandle& instance,
+            const dds::core::Time& timestamp)
+{
+    org::eclipse::cyclonedds::pub::KeyHashCache::entry e;
+
+    this->check();
+    if (this->cached_instance(instance, e) && this->serdata_writes_ && e.keyhash_valid) {
+        /* The keyhash of the instance is known, so the blob does not have
+         * to be deserialized to calculate it. */
+        ddsrt_iovec_t blob_holders[2];
+        blob_holders[0].iov_len = 4;
+        blob_holders[0].iov_base = const_cast<char *>(sample.encoding().data());
+        blob_holders[1].iov_len = static_cast<ddsrt_iov_len_t>(sample.payload().size());
+        blob_holders[1].iov_base = const_cast<uint8_t *>(sample.payload().data());
+
+        AnyDataWriterDelegate::write_serdata(static_cast<dds_entity_t>(this->ddsc_entity),
+                serdata_from_ser_iov_keyhash<T>(this->topic_.delegate()->get_ser_type(),
+                                                static_cast<ddsi_serdata_kind>(sample.kind()),
+                                                2,
+                                                blob_holders,
+                                                sample.payload().size() + 4,
+                                                e.keyhash, e.key_md5_hashed, e.hash),
+                timestamp);
+    } else {
+        AnyDataWriterDelegate::write_cdr(static_cast<dds_entity_t>(this->ddsc_entity),
+                                      &sample,
+                                      instance,
+                                      timestamp);
+    }
+}
+
 template <typename T>
 void
 dds::pub::detail::DataWriter<T>::dispose_cdr(const org::eclipse::cyclonedds::topic::CDRBlob& sample)
@@ -558,15 +609,136 @@ dds::pub::detail::DataWriter<T>::unregister_instance_cdr(
                                   timestamp);
 }
 
+template <typename T>
+void
+dds::pub::detail::DataWriter<T>::calculate_keyhash(
+            const T& sample,
+            const std::vector<unsigned char>& key,
+            org::eclipse::cyclonedds::pub::KeyHashCache::entry& e)
+{
+    org::eclipse::cyclonedds::core::cdr::big_endian_basic_cdr_stream str;
+
+    e.key_md5_hashed = keyhash_from_buffer(str, sample, key, e.keyhash);
+    e.hash = keyhash_to_hash(e.keyhash, e.key_md5_hashed);
+    e.keyhash_valid = true;
+}
+
+template <typename T>
+ddsi_serdata*
+dds::pub::detail::DataWriter<T>::keyed_serdata(const T& sample, ddsi_serdata_kind kind)
+{
+    org::eclipse::cyclonedds::core::cdr::big_endian_basic_cdr_stream str;
+    org::eclipse::cyclonedds::pub::KeyHashCache::entry e;
+    static thread_local std::vector<unsigned char> key;
+
+    /* Unless the application sized the cache for its instances, calculating
+     * the keyhash is cheaper than looking it up. */
+    if (this->keyhash_cache_.capacity() == 0) {
+        return serdata_from_sample<T>(this->topic_.delegate()->get_ser_type(), kind, &sample);
+    }
+
+    key_to_buffer(str, sample, key);
+    if (str.abort_status()) {
+        return nullptr;
+    }
+    if (!this->keyhash_cache_.lookup(key, e)) {
+        this->calculate_keyhash(sample, key, e);
+        e.handle = DDS_HANDLE_NIL;
+        this->keyhash_cache_.insert(key, e);
+    } else if (!e.keyhash_valid) {
+        /* A registered instance that is written for the first time. */
+        this->calculate_keyhash(sample, key, e);
+        this->keyhash_cache_.update_keyhash(key, e);
+    }
+    return serdata_from_sample_keyhash(this->topic_.delegate()->get_ser_type(),
+                                       kind, sample, e.keyhash, e.key_md5_hashed, e.hash);
+}
+
+template <typename T>
+void
+dds::pub::detail::DataWriter<T>::write_keyed(const T& sample, const dds::core::Time& timestamp)
+{
+    if (this->serdata_writes_) {
+        AnyDataWriterDelegate::write_serdata(static_cast<dds_entity_t>(this->ddsc_entity),
+                                             this->keyed_serdata(sample, SDK_DATA),
+                                             timestamp);
+    } else {
+        AnyDataWriterDelegate::write(static_cast<dds_entity_t>(this->ddsc_entity),
+                                      &sample,
+                                      dds::core::InstanceHandle(dds::core::null),
+                                      timestamp);
+    }
+}
+
+template <typename T>
+dds_return_t
+dds::pub::detail::DataWriter<T>::try_write_keyed(const T& sample, const dds::core::Time& timestamp) noexcept
+{
+    try {
+        if (this->serdata_writes_) {
+            return AnyDataWriterDelegate::try_write_serdata(static_cast<dds_entity_t>(this->ddsc_entity),
+                                                            this->keyed_serdata(sample, SDK_DATA),
+                                                            timestamp);
+        }
+        return AnyDataWriterDelegate::try_write(static_cast<dds_entity_t>(this->ddsc_entity),
+                                                &sample,
+                                                timestamp);
+    } catch (const std::bad_alloc&) {
+        return DDS_RETCODE_OUT_OF_RESOURCES;
+    } catch (...) {
+        return DDS_RETCODE_ERROR;
+    }
+}
+
+template <typename T>
+bool
+dds::pub::detail::DataWriter<T>::write_cached(
+            const T& sample,
+            const ::dds::core::InstanceHandle& instance,
+            const dds::core::Time& timestamp,
+            bool dispose)
+{
+    org::eclipse::cyclonedds::core::cdr::big_endian_basic_cdr_stream str;
+    org::eclipse::cyclonedds::pub::KeyHashCache::entry e;
+    static thread_local std::vector<unsigned char> key;
+
+    if (instance == dds::core::null) {
+        return false;
+    }
+
+    /* Only instances registered through this writer are known in the cache,
+     * which makes this a cheap check of the handle as well: unknown, stale
+     * and unregistered handles are rejected. Comparing the serialized keys
+     * catches samples of other instances, and is still much cheaper than
+     * calculating the keyhash. An invalid key is reported by the regular
+     * write. */
+    key_to_buffer(str, sample, key);
+    if (str.abort_status() || !this->cached_instance(instance, key, e) || !this->serdata_writes_) {
+        return false;
+    }
+    if (!e.keyhash_valid) {
+        this->calculate_keyhash(sample, key, e);
+        this->keyhash_cache_.update_keyhash(key, e);
+    }
+
+    ddsi_serdata *ser_data = serdata_from_sample_keyhash(this->topic_.delegate()->get_ser_type(),
+            SDK_DATA, sample, e.keyhash, e.key_md5_hashed, e.hash);
+    if (dispose) {
+        AnyDataWriterDelegate::writedispose_serdata(static_cast<dds_entity_t>(this->ddsc_entity),
+                                                    ser_data, timestamp);
+    } else {
+        AnyDataWriterDelegate::write_serdata(static_cast<dds_entity_t>(this->ddsc_entity),
+                                             ser_data, timestamp);
+    }
+    return true;
+}
+
 template <typename T>
 void
 dds::pub::detail::DataWriter<T>::write(const T& sample)
 {
     this->check();
-    AnyDataWriterDelegate::write(static_cast<dds_entity_t>(this->ddsc_entity),
-                                  &sample,
-                                  dds::core::InstanceHandle(dds::core::null),
-                                  dds::core::Time::invalid());
+    this->write_keyed(sample, dds::core::Time::invalid());
 }
 
 template <typename T>
@@ -574,10 +746,7 @@ void
 dds::pub::detail::DataWriter<T>::write(const T& sample, const dds::core::Time& timestamp)
 {
     this->check();
-    AnyDataWriterDelegate::write(static_cast<dds_entity_t>(this->ddsc_entity),
-                                  &sample,
-                                  dds::core::InstanceHandle(dds::core::null),
-                                  timestamp);
+    this->write_keyed(sample, timestamp);
 }
 
 template <typename T>
@@ -585,10 +754,9 @@ void
 dds::pub::detail::DataWriter<T>::write(const T& sample, const ::dds::core::InstanceHandle& instance)
 {
     this->check();
-    AnyDataWriterDelegate::write(static_cast<dds_entity_t>(this->ddsc_entity),
-                                  &sample,
-                                  instance,
-                                  dds::core::Time::invalid());
+    if (!this->write_cached(sample, instance, dds::core::Time::invalid(), false)) {
+        this->write_keyed(sample, dds::core::Time::invalid());
+    }
 }
 
 template <typename T>
@@ -598,10 +766,9 @@ dds::pub::detail::DataWriter<T>::write(const T& sample,
            const dds::core::Time& timestamp)
 {
     this->check();
-    AnyDataWriterDelegate::write(static_cast<dds_entity_t>(this->ddsc_entity),
-                                  &sample,
-                                  instance,
-                                  timestamp);
+    if (!this->write_cached(sample, instance, timestamp, false)) {
+        this->write_keyed(sample, timestamp);
+    }
 }
 
 template <typename T>
@@ -609,10 +776,9 @@ void
 dds::pub::detail::DataWriter<T>::write(const dds::topic::TopicInstance<T>& i)
 {
     this->check();
-    AnyDataWriterDelegate::write(static_cast<dds_entity_t>(this->ddsc_entity),
-                                  &i.sample(),
-                                  i.handle(),
-                                  dds::core::Time::invalid());
+    if (!this->write_cached(i.sample(), i.handle(), dds::core::Time::invalid(), false)) {
+        this->write_keyed(i.sample(), dds::core::Time::invalid());
+    }
 }
 
 template <typename T>
@@ -621,10 +787,29 @@ dds::pub::detail::DataWriter<T>::write(const dds::topic::TopicInstance<T>& i,
            const dds::core::Time& timestamp)
 {
     this->check();
-    AnyDataWriterDelegate::write(static_cast<dds_entity_t>(this->ddsc_entity),
-                                  &i.sample(),
-                                  i.handle(),
-                                  timestamp);
+    if (!this->write_cached(i.sample(), i.handle(), timestamp, false)) {
+        this->write_keyed(i.sample(), timestamp);
+    }
+}
+
+template <typename T>
+dds_return_t
+dds::pub::detail::DataWriter<T>::try_write(const T& sample) noexcept
+{
+    if (this->closed) {
+        return DDS_RETCODE_ALREADY_DELETED;
+    }
+    return this->try_write_keyed(sample, dds::core::Time::invalid());
+}
+
+template <typename T>
+dds_return_t
+dds::pub::detail::DataWriter<T>::try_write(const T& sample, const dds::core::Time& timestamp) noexcept
+{
+    if (this->closed) {
+        return DDS_RETCODE_ALREADY_DELETED;
+    }
+    return this->try_write_keyed(sample, timestamp);
 }
 
 template <typename T>
@@ -656,11 +841,13 @@ void
 dds::pub::detail::DataWriter<T>::writedispose(const T& sample, const ::dds::core::InstanceHandle& instance)
 {
     this->check();
-    AnyDataWriterDelegate::writedispose(
+    if (!this->write_cached(sample, instance, dds::core::Time::invalid(), true)) {
+        AnyDataWriterDelegate::writedispose(
                                   static_cast<dds_entity_t>(this->ddsc_entity),
                                   &sample,
                                   instance,
                                   dds::core::Time::invalid());
+    }
 }
 
 template <typename T>
@@ -671,11 +858,13 @@ dds::pub::detail::DataWriter<T>::writedispose(
            const dds::core::Time& timestamp)
 {
     this->check();
-    AnyDataWriterDelegate::writedispose(
+    if (!this->write_cached(sample, instance, timestamp, true)) {
+        AnyDataWriterDelegate::writedispose(
                                   static_cast<dds_entity_t>(this->ddsc_entity),
                                   &sample,
                                   instance,
                                   timestamp);
+    }
 }
 
 template <typename T>
@@ -683,11 +872,13 @@ void
 dds::pub::detail::DataWriter<T>::writedispose(const dds::topic::TopicInstance<T>& i)
 {
     this->check();
-    AnyDataWriterDelegate::writedispose(
+    if (!this->write_cached(i.sample(), i.handle(), dds::core::Time::invalid(), true)) {
+        AnyDataWriterDelegate::writedispose(
                                   static_cast<dds_entity_t>(this->ddsc_entity),
                                   &i.sample(),
                                   i.handle(),
                                   dds::core::Time::invalid());
+    }
 }
 
 template <typename T>
@@ -697,11 +888,13 @@ dds::pub::detail::DataWriter<T>::writedispose(
            const dds::core::Time& timestamp)
 {
     this->check();
-    AnyDataWriterDelegate::writedispose(
+    if (!this->write_cached(i.sample(), i.handle(), timestamp, true)) {
+        AnyDataWriterDelegate::writedispose(
                                   static_cast<dds_entity_t>(this->ddsc_entity),
                                   &i.sample(),
                                   i.handle(),
                                   timestamp);
+    }
 }
 
 template <typename T>
@@ -779,10 +972,60 @@ dds::pub::detail::DataWriter<T>::register_instance(const T& key,
 {
     org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
     this->check();
-    dds::core::InstanceHandle handle(AnyDataWriterDelegate::register_instance(static_cast<dds_entity_t>(this->ddsc_entity), &key, timestamp));
+    dds::core::InstanceHandle handle(this->register_keyed(key, timestamp));
     return handle;
 }
 
+template <typename T>
+template <typename FWIterator>
+::dds::core::InstanceHandleSeq
+dds::pub::detail::DataWriter<T>::register_instances(const FWIterator& begin,
+                                                    const FWIterator& end)
+{
+    ::dds::core::InstanceHandleSeq handles;
+
+    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
+    this->check();
+    for (FWIterator b = begin; b != end; ++b) {
+        handles.push_back(::dds::core::InstanceHandle(this->register_keyed(*b, dds::core::Time::invalid())));
+    }
+    return handles;
+}
+
+template <typename T>
+dds_instance_handle_t
+dds::pub::detail::DataWriter<T>::register_keyed(const T& key,
+                                                const dds::core::Time& timestamp)
+{
+    org::eclipse::cyclonedds::core::cdr::big_endian_basic_cdr_stream str;
+    org::eclipse::cyclonedds::pub::KeyHashCache::entry e;
+    std::vector<unsigned char> buffer;
+    bool known;
+
+    key_to_buffer(str, key, buffer);
+    if (str.abort_status() || timestamp != dds::core::Time::invalid()) {
+        /* Let the delegate report the invalid key or unsupported timestamp. */
+        return AnyDataWriterDelegate::register_instance(static_cast<dds_entity_t>(this->ddsc_entity), &key, timestamp);
+    }
+
+    /* An instance that is still registered by this writer does not have
+     * to be registered again. */
+    known = this->keyhash_cache_.lookup(buffer, e);
+    if (known && e.handle != DDS_HANDLE_NIL) {
+        return e.handle;
+    }
+
+    /* The keyhash is calculated when the instance is first written, so that
+     * a registration costs no more than that of ddsc. */
+    dds_instance_handle_t ih = AnyDataWriterDelegate::register_instance(static_cast<dds_entity_t>(this->ddsc_entity), &key, timestamp);
+    if (!known) {
+        e.keyhash_valid = false;
+    }
+    e.handle = ih;
+    this->keyhash_cache_.insert(buffer, e);
+    return ih;
+}
+
 template <typename T>
 void
 dds::pub::detail::DataWriter<T>::unregister_instance(const ::dds::core::InstanceHandle& handle,
@@ -800,6 +1043,15 @@ dds::pub::detail::DataWriter<T>::unregister_instance(const T& sample,
 {
     org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
     this->check();
+
+    /* The handle may not be valid anymore after the unregistration. */
+    org::eclipse::cyclonedds::core::cdr::big_endian_basic_cdr_stream str;
+    std::vector<unsigned char> key;
+    key_to_buffer(str, sample, key);
+    if (!str.abort_status()) {
+        this->keyhash_cache_.forget_handle(key);
+    }
+
     AnyDataWriterDelegate::unregister_instance(static_cast<dds_entity_t>(this->ddsc_entity), &sample, timestamp);
 }
 
@@ -979,4 +1231,11 @@ void dds::pub::detail::DataWriter<T>::on_publication_matched(dds_entity_t,
     l->on_publication_matched(dw, s);
 }
 
+template <typename T>
+org::eclipse::cyclonedds::core::EntityDelegate*
+dds::pub::detail::DataWriter<T>::listener_parent() const
+{
+    return this->pub_.delegate().get();
+}
+
 #endif /* OMG_DDS_PUB_DATA_WRITER_IMPL_HPP_ */
@@ -41,7 +41,11 @@ void TCoherentSet<DELEGATE>::end()
 template <typename DELEGATE>
 TCoherentSet<DELEGATE>::~TCoherentSet()
 {
-    this->delegate().end();
+    try {
+        this->delegate().end();
+    } catch (...) {
+        /* Destructors do not throw. */
+    }
 }
 
 }
@@ -41,7 +41,11 @@ void TSuspendedPublication<DELEGATE>::resume()
 template <typename DELEGATE>
 TSuspendedPublication<DELEGATE>::~TSuspendedPublication()
 {
-    this->delegate().resume();
+    try {
+        this->delegate().resume();
+    } catch (...) {
+        /* Destructors do not throw. */
+    }
 }
 
 }
@@ -24,6 +24,8 @@
 
 #include <org/eclipse/cyclonedds/core/EntityDelegate.hpp>
 #include <org/eclipse/cyclonedds/sub/AnyDataReaderDelegate.hpp>
+#include <org/eclipse/cyclonedds/sub/DecoderPool.hpp>
+#include <org/eclipse/cyclonedds/sub/SamplePool.hpp>
 
 #include <org/eclipse/cyclonedds/core/ScopedLock.hpp>
 #include <org/eclipse/cyclonedds/ForwardDeclarations.hpp>
@@ -80,6 +82,17 @@ public:
     dds::sub::LoanedSamples<T> read();
     dds::sub::LoanedSamples<T> take();
 
+    /* Like take(), but returns the number of samples taken or the ddsc error
+     * instead of raising an exception. The samples are only replaced when the
+     * take succeeded. */
+    dds_return_t try_take(dds::sub::LoanedSamples<T>& samples) noexcept;
+
+    /* Like take(), but the samples are deserialized by the threads of the
+     * pool before returning, instead of one by one on first access. A sample
+     * that cannot be deserialized is returned as is, accessing its data
+     * raises an Error like it does for a sample taken with take(). */
+    dds::sub::LoanedSamples<T> take(org::eclipse::cyclonedds::sub::DecoderPool& decoders);
+
     template<typename SamplesFWIterator>
     uint32_t read(SamplesFWIterator samples, uint32_t max_samples);
     template<typename SamplesFWIterator>
@@ -90,6 +103,18 @@ public:
     template<typename SamplesBIIterator>
     uint32_t take(SamplesBIIterator samples);
 
+    uint32_t read(org::eclipse::cyclonedds::sub::SamplePool<T>& pool);
+    uint32_t take(org::eclipse::cyclonedds::sub::SamplePool<T>& pool);
+
+    /* Conflating take for readers that only need the newest sample of every
+     * instance, for instance to refresh a display. It requires KEEP_LAST 1
+     * history, so that the reader cache holds just the newest (serialized)
+     * sample per instance. Received samples are only deserialized when they
+     * are read, so samples that are replaced before they are taken are never
+     * deserialized. */
+    dds::sub::LoanedSamples<T> take_latest();
+    uint32_t take_latest(org::eclipse::cyclonedds::sub::SamplePool<T>& pool);
+
     dds::topic::TopicInstance<T> key_value(const dds::core::InstanceHandle& h);
     T& key_value(T& key, const dds::core::InstanceHandle& h);
 
@@ -125,6 +150,8 @@ public:
     void on_sample_lost(dds_entity_t,
           org::eclipse::cyclonedds::core::SampleLostStatusDelegate &);
 
+    org::eclipse::cyclonedds::core::EntityDelegate* listener_parent() const;
+
 private:
     dds::sub::Subscriber sub_;
     dds::sub::status::DataState status_filter_;
@@ -226,6 +253,8 @@ private:
     uint32_t take(SamplesBIIterator samples, const Selector& selector);
 
  private:
+    void check_keep_last_one();
+
     T typed_sample_;
 
 };
@@ -82,7 +82,12 @@ public:
       {
         throw dds::core::Error("Data is Null");
       }
-      return *data_->getT();
+      const T* t = data_->getT();
+      if (t == nullptr)
+      {
+        throw dds::core::Error("Data could not be deserialized");
+      }
+      return *t;
     }
 
     const dds::sub::SampleInfo& info() const
@@ -18,6 +18,7 @@
 
 #include <dds/sub/LoanedSamples.hpp>
 #include "org/eclipse/cyclonedds/sub/AnyDataReaderDelegate.hpp"
+#include "org/eclipse/cyclonedds/sub/SamplePool.hpp"
 #include "org/eclipse/cyclonedds/topic/datatopic.hpp"
 
 namespace dds
@@ -291,6 +292,70 @@ private:
 
 };
 
+template <typename T>
+class SamplePoolHolder : public SamplesHolder
+{
+public:
+    SamplePoolHolder(org::eclipse::cyclonedds::sub::SamplePool<T>& p) : pool(p), index(0)
+    {
+    }
+
+    void set_length(uint32_t len) {
+        this->pool.length(len);
+    }
+
+    uint32_t get_length() const {
+        return this->pool.length();
+    }
+
+    SamplesHolder& operator++(int)
+    {
+        this->index++;
+        return *this;
+    }
+
+    void *data()
+    {
+        return this->pool[this->index].delegate().data_ptr();
+    }
+
+    detail::SampleInfo& info()
+    {
+        return this->pool[this->index].delegate().info();
+    }
+
+    void **cpp_sample_pointers(size_t)
+    {
+        /* The pool never asks for more samples than it can hold. */
+        return this->pool.sample_pointers();
+    }
+
+    dds_sample_info_t *cpp_info_pointers(size_t)
+    {
+        return this->pool.sample_infos();
+    }
+
+    void set_sample_contents(void**, dds_sample_info_t *info)
+    {
+        /* Samples have already been deserialized in the pool during the read/take call. */
+        const uint32_t length = this->pool.length();
+        for (uint32_t i = 0; i < length; ++i) {
+            org::eclipse::cyclonedds::sub::AnyDataReaderDelegate::copy_sample_infos(info[i], this->pool[i].delegate().info());
+        }
+    }
+
+    void fini_samples_buffers(void**& c_sample_pointers, dds_sample_info_t*& c_sample_infos)
+    {
+        /* The buffers are owned by the pool and reused by the next read/take. */
+        c_sample_pointers = NULL;
+        c_sample_infos = NULL;
+    }
+
+private:
+    org::eclipse::cyclonedds::sub::SamplePool<T>& pool;
+    uint32_t index;
+};
+
 template <typename T, typename SamplesBIIterator>
 class SamplesBIIteratorHolder : public SamplesHolder
 {
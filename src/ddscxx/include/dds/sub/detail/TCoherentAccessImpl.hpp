@@ -40,7 +40,11 @@ void TCoherentAccess<DELEGATE>::end()
 template <typename DELEGATE>
 TCoherentAccess<DELEGATE>::~TCoherentAccess()
 {
-    this->delegate().end();
+    try {
+        this->delegate().end();
+    } catch (...) {
+        /* Destructors do not throw. */
+    }
 }
 
 }
@@ -438,6 +438,8 @@ DataReader<T, DELEGATE>::listener() const
  *
  ***************************************************************************/
 
+#include <new>
+
 #include <dds/sub/AnyDataReader.hpp>
 #include <dds/sub/DataReaderListener.hpp>
 #include <dds/topic/Topic.hpp>
@@ -492,15 +494,14 @@ dds::sub::detail::DataReader<T>::common_constructor(
 
     // get and validate the ddsc qos
     drQos.check();
-    dds_qos_t* ddsc_qos = drQos.ddsc_qos();
+    org::eclipse::cyclonedds::core::DdscQosCache::qos_ref ddsc_qos = drQos.cached_ddsc_qos();
 
 #if 0
     std::string expression = this->AnyDataReaderDelegate::td_.delegate()->reader_expression();
     c_value *params = this->AnyDataReaderDelegate::td_.delegate()->reader_parameters();
 #endif
 
-    dds_entity_t ddsc_reader = dds_create_reader(ddsc_sub, ddsc_top, ddsc_qos, NULL);
-    dds_free(ddsc_qos);
+    dds_entity_t ddsc_reader = dds_create_reader(ddsc_sub, ddsc_top, ddsc_qos.get(), NULL);
     ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ddsc_reader, "Could not create DataReader.");
 
     this->AnyDataReaderDelegate::td_.delegate()->incrNrDependents();
@@ -665,6 +666,44 @@ dds::sub::detail::DataReader<T>::take()
     return samples;
 }
 
+template <typename T>
+dds_return_t
+dds::sub::detail::DataReader<T>::try_take(dds::sub::LoanedSamples<T>& samples) noexcept
+{
+    try {
+        /* Copies of LoanedSamples share their contents, so take into new ones. */
+        dds::sub::LoanedSamples<T> taken;
+        dds::sub::detail::LoanedSamplesHolder<T> holder(taken);
+
+        dds_return_t ret = this->AnyDataReaderDelegate::try_loaned_take(static_cast<dds_entity_t>(this->ddsc_entity), this->status_filter_, holder, static_cast<uint32_t>(dds::core::LENGTH_UNLIMITED));
+        if (ret >= 0) {
+            samples = taken;
+        }
+        return ret;
+    } catch (const std::bad_alloc&) {
+        return DDS_RETCODE_OUT_OF_RESOURCES;
+    }
+}
+
+template <typename T>
+dds::sub::LoanedSamples<T>
+dds::sub::detail::DataReader<T>::take(org::eclipse::cyclonedds::sub::DecoderPool& decoders)
+{
+    dds::sub::LoanedSamples<T> samples = this->take();
+
+    /* Deserializing caches the sample in the serdata (atomically, should the
+     * application access it concurrently), which is all that is needed here. */
+    dds::sub::detail::LoanedSamples<T>& loaned = *samples.delegate();
+    decoders.for_each(loaned.length(), [&loaned](size_t i) {
+        ddscxx_serdata<T>* d = loaned[static_cast<uint32_t>(i)].delegate().data_ptr();
+        if (d != nullptr) {
+            (void) d->getT();
+        }
+    });
+
+    return samples;
+}
+
 template <typename T>
 template<typename SamplesFWIterator>
 uint32_t
@@ -713,6 +752,54 @@ dds::sub::detail::DataReader<T>::take(SamplesBIIterator samples)
     return holder.get_length();
 }
 
+template <typename T>
+uint32_t
+dds::sub::detail::DataReader<T>::read(org::eclipse::cyclonedds::sub::SamplePool<T>& pool)
+{
+    dds::sub::detail::SamplePoolHolder<T> holder(pool);
+
+    this->AnyDataReaderDelegate::read(static_cast<dds_entity_t>(this->ddsc_entity), this->status_filter_, holder, pool.capacity());
+
+    return holder.get_length();
+}
+
+template <typename T>
+uint32_t
+dds::sub::detail::DataReader<T>::take(org::eclipse::cyclonedds::sub::SamplePool<T>& pool)
+{
+    dds::sub::detail::SamplePoolHolder<T> holder(pool);
+
+    this->AnyDataReaderDelegate::take(static_cast<dds_entity_t>(this->ddsc_entity), this->status_filter_, holder, pool.capacity());
+
+    return holder.get_length();
+}
+
+template <typename T>
+dds::sub::LoanedSamples<T>
+dds::sub::detail::DataReader<T>::take_latest()
+{
+    this->check_keep_last_one();
+    return this->take();
+}
+
+template <typename T>
+uint32_t
+dds::sub::detail::DataReader<T>::take_latest(org::eclipse::cyclonedds::sub::SamplePool<T>& pool)
+{
+    this->check_keep_last_one();
+    return this->take(pool);
+}
+
+template <typename T>
+void
+dds::sub::detail::DataReader<T>::check_keep_last_one()
+{
+    dds::core::policy::History history = this->AnyDataReaderDelegate::qos().template policy<dds::core::policy::History>();
+    ISOCPP_BOOL_CHECK_AND_THROW(
+        history.kind() == dds::core::policy::HistoryKind::KEEP_LAST && history.depth() == 1,
+        ISOCPP_PRECONDITION_NOT_MET_ERROR, "Conflating take requires KEEP_LAST 1 history");
+}
+
 template <typename T>
 dds::topic::TopicInstance<T>
 dds::sub::detail::DataReader<T>::key_value(const dds::core::InstanceHandle& h)
@@ -1439,6 +1526,13 @@ void dds::sub::detail::DataReader<T>::on_sample_lost(dds_entity_t,
     l->on_sample_lost(dr, s);
 }
 
+template <typename T>
+org::eclipse::cyclonedds::core::EntityDelegate*
+dds::sub::detail::DataReader<T>::listener_parent() const
+{
+    return this->sub_.delegate().get();
+}
+
 // End of implementation
 
 #endif /* CYCLONEDDS_DDS_SUB_TDATAREADER_IMPL_HPP_ */
@@ -436,11 +436,10 @@ private:
     void filter_function_internal(Functor && func, dds_topic_filter * flt)
     {
         /* Make a private copy of the topic so my filter doesn't bother the original topic. */
-        dds_qos_t* ddsc_qos = myTopic.qos()->ddsc_qos();
+        org::eclipse::cyclonedds::core::DdscQosCache::qos_ref ddsc_qos = myTopic.qos()->cached_ddsc_qos();
         ddsi_sertype *st = org::eclipse::cyclonedds::topic::TopicTraits<T>::getSerType();
         dds_entity_t cfTopic = dds_create_topic_sertype(
-            myTopic.domain_participant().delegate()->get_ddsc_entity(), myTopic.name().c_str(), &st, ddsc_qos, NULL, NULL);
-        dds_delete_qos(ddsc_qos);
+            myTopic.domain_participant().delegate()->get_ddsc_entity(), myTopic.name().c_str(), &st, ddsc_qos.get(), NULL, NULL);
         this->set_ddsc_entity(cfTopic);
 
         org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
@@ -169,15 +169,13 @@ dds::topic::detail::Topic<T>::Topic(const dds::domain::DomainParticipant& dp,
     // get and validate the ddsc qos
     org::eclipse::cyclonedds::topic::qos::TopicQosDelegate tQos = qos.delegate();
     tQos.check();
-    dds_qos_t* ddsc_qos = tQos.ddsc_qos();
+    org::eclipse::cyclonedds::core::DdscQosCache::qos_ref ddsc_qos = tQos.cached_ddsc_qos();
     dds_entity_t ddsc_par = dp.delegate()->get_ddsc_entity();
 
     ser_type_ = org::eclipse::cyclonedds::topic::TopicTraits<T>::getSerType();
 
     dds_entity_t ddsc_topic = dds_create_topic_sertype(
-      ddsc_par, name.c_str(), &ser_type_, ddsc_qos, NULL, NULL);
-
-    dds_delete_qos(ddsc_qos);
+      ddsc_par, name.c_str(), &ser_type_, ddsc_qos.get(), NULL, NULL);
 
     if (ddsc_topic < 0) {
       ddsi_sertype_unref(ser_type_);
@@ -97,6 +97,7 @@ namespace cyclonedds
 
     namespace domain {
         class DomainParticipantDelegate;
+        class DiscoveryCache;
     }
 
     namespace sub {
@@ -105,6 +106,7 @@ namespace cyclonedds
 
     namespace pub {
         class PublisherDelegate;
+        class AcknowledgmentWaiter;
     }
 
     namespace topic {
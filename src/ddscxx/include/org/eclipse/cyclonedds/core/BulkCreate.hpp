@@ -0,0 +1,176 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+
+
+/**
+ * @file
+ */
+
+#ifndef CYCLONEDDS_CORE_BULK_CREATE_HPP_
+#define CYCLONEDDS_CORE_BULK_CREATE_HPP_
+
+#include <vector>
+
+#include <dds/pub/DataWriter.hpp>
+#include <dds/pub/Publisher.hpp>
+#include <dds/sub/DataReader.hpp>
+#include <dds/sub/Subscriber.hpp>
+#include <dds/topic/Topic.hpp>
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace core
+{
+
+/**
+ * Creates an endpoint (DataReader or DataWriter) for each of the given
+ * Topics, all in the same parent and with the same QoS, listener and status
+ * mask.
+ *
+ * The QoS is validated and translated to its ddsc representation only once,
+ * after which the translation is shared by all the created endpoints.
+ *
+ * @param parent the Subscriber or Publisher that will contain the endpoints
+ * @param topics the Topics to create an endpoint for
+ * @param qos the QoS of all endpoints
+ * @param listener the listener of all endpoints
+ * @param mask the listener event mask
+ * @return the endpoints, in the order of the given Topics
+ * @throws dds::core::Exception
+ *                  An exception thrown by the endpoint constructor. The
+ *                  endpoints that were already created are deleted again.
+ */
+template <typename ENDPOINT, typename PARENT, typename T, typename QOS, typename LISTENER>
+std::vector<ENDPOINT>
+create_endpoints(
+    const PARENT& parent,
+    const std::vector< dds::topic::Topic<T> >& topics,
+    const QOS& qos,
+    LISTENER* listener,
+    const dds::core::status::StatusMask& mask)
+{
+    qos.delegate().check();
+    (void)qos.delegate().cached_ddsc_qos();
+
+    std::vector<ENDPOINT> endpoints;
+    endpoints.reserve(topics.size());
+    try {
+        for (typename std::vector< dds::topic::Topic<T> >::const_iterator it = topics.begin();
+             it != topics.end(); ++it) {
+            endpoints.push_back(ENDPOINT(parent, *it, qos, listener, mask));
+        }
+    } catch (...) {
+        for (typename std::vector<ENDPOINT>::iterator it = endpoints.begin();
+             it != endpoints.end(); ++it) {
+            it->close();
+        }
+        throw;
+    }
+    return endpoints;
+}
+
+}
+
+namespace pub
+{
+
+/**
+ * Creates a DataWriter for each of the given Topics, all with the same
+ * DataWriterQos, listener and status mask.
+ *
+ * @see org::eclipse::cyclonedds::core::create_endpoints()
+ */
+template <typename T>
+std::vector< dds::pub::DataWriter<T> >
+create_datawriters(
+    const dds::pub::Publisher& pub,
+    const std::vector< dds::topic::Topic<T> >& topics,
+    const dds::pub::qos::DataWriterQos& qos,
+    dds::pub::DataWriterListener<T>* listener = NULL,
+    const dds::core::status::StatusMask& mask = dds::core::status::StatusMask::none())
+{
+    return org::eclipse::cyclonedds::core::create_endpoints< dds::pub::DataWriter<T> >(
+        pub, topics, qos, listener, mask);
+}
+
+/**
+ * Creates count DataWriters for the same Topic, all with the same
+ * DataWriterQos, listener and status mask.
+ *
+ * @see org::eclipse::cyclonedds::core::create_endpoints()
+ */
+template <typename T>
+std::vector< dds::pub::DataWriter<T> >
+create_datawriters(
+    const dds::pub::Publisher& pub,
+    const dds::topic::Topic<T>& topic,
+    size_t count,
+    const dds::pub::qos::DataWriterQos& qos,
+    dds::pub::DataWriterListener<T>* listener = NULL,
+    const dds::core::status::StatusMask& mask = dds::core::status::StatusMask::none())
+{
+    return create_datawriters(pub, std::vector< dds::topic::Topic<T> >(count, topic), qos, listener, mask);
+}
+
+}
+
+namespace sub
+{
+
+/**
+ * Creates a DataReader for each of the given Topics, all with the same
+ * DataReaderQos, listener and status mask.
+ *
+ * @see org::eclipse::cyclonedds::core::create_endpoints()
+ */
+template <typename T>
+std::vector< dds::sub::DataReader<T> >
+create_datareaders(
+    const dds::sub::Subscriber& sub,
+    const std::vector< dds::topic::Topic<T> >& topics,
+    const dds::sub::qos::DataReaderQos& qos,
+    dds::sub::DataReaderListener<T>* listener = NULL,
+    const dds::core::status::StatusMask& mask = dds::core::status::StatusMask::none())
+{
+    return org::eclipse::cyclonedds::core::create_endpoints< dds::sub::DataReader<T> >(
+        sub, topics, qos, listener, mask);
+}
+
+/**
+ * Creates count DataReaders for the same Topic, all with the same
+ * DataReaderQos, listener and status mask.
+ *
+ * @see org::eclipse::cyclonedds::core::create_endpoints()
+ */
+template <typename T>
+std::vector< dds::sub::DataReader<T> >
+create_datareaders(
+    const dds::sub::Subscriber& sub,
+    const dds::topic::Topic<T>& topic,
+    size_t count,
+    const dds::sub::qos::DataReaderQos& qos,
+    dds::sub::DataReaderListener<T>* listener = NULL,
+    const dds::core::status::StatusMask& mask = dds::core::status::StatusMask::none())
+{
+    return create_datareaders(sub, std::vector< dds::topic::Topic<T> >(count, topic), qos, listener, mask);
+}
+
+}
+}
+}
+}
+
+#endif /* CYCLONEDDS_CORE_BULK_CREATE_HPP_ */
@@ -0,0 +1,497 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+
+
+/**
+ * @file
+ */
+
+#ifndef CYCLONEDDS_CORE_COROUTINES_HPP_
+#define CYCLONEDDS_CORE_COROUTINES_HPP_
+
+/*
+ * The library itself is built as C++17, so everything in here lives in this
+ * header and is only available to applications that are compiled with
+ * coroutine support. The header is not included by dds/dds.hpp.
+ */
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define CYCLONEDDS_HAS_COROUTINES 1
+#endif
+#endif
+
+#if defined(CYCLONEDDS_HAS_COROUTINES)
+
+#include <algorithm>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <dds/dds.h>
+#include <dds/dds.hpp>
+#include <org/eclipse/cyclonedds/core/ReportUtils.hpp>
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace core
+{
+
+/*
+ * Return type of fire-and-forget coroutines: the coroutine starts running
+ * right away and its frame is released when it finishes. Like a std::thread,
+ * a coroutine that lets an exception escape terminates the process.
+ */
+class Task
+{
+public:
+    struct promise_type
+    {
+        Task get_return_object() noexcept { return Task(); }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept { }
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+/*
+ * Resumes coroutines that wait for DDS events, so that a large number of
+ * logical subscribers can share a few threads instead of each blocking a
+ * thread of its own in a WaitSet.
+ *
+ *     Task consume(CoroutineScheduler& s, dds::sub::DataReader<T>& reader)
+ *     {
+ *         while (true) {
+ *             dds::sub::LoanedSamples<T> samples = co_await s.take(reader);
+ *             ...
+ *         }
+ *     }
+ *
+ * A single watcher thread waits on a private ddsc waitset to which the
+ * condition of every suspended coroutine is attached, with the condition
+ * itself as attach argument. Once a condition triggers it is detached and all
+ * coroutines that wait for it are queued for the worker threads, which resume
+ * them. Waiting through a waitset rather than through listeners keeps the
+ * listeners of the entities available to the application. Coroutines that
+ * take from a reader wait for a read condition that the scheduler creates for
+ * the reader on first use and keeps until it is destroyed.
+ *
+ * Coroutines that are still suspended when the scheduler is destroyed are
+ * destroyed along with it, so the scheduler must not outlive the entities its
+ * coroutines use.
+ */
+class CoroutineScheduler
+{
+public:
+    explicit CoroutineScheduler(uint32_t threads = 1)
+        : state_(std::make_shared<state>())
+    {
+        ISOCPP_BOOL_CHECK_AND_THROW(threads > 0, ISOCPP_INVALID_ARGUMENT_ERROR,
+                                    "A coroutine scheduler needs at least 1 thread.");
+
+        dds_entity_t ws = dds_create_waitset(DDS_CYCLONEDDS_HANDLE);
+        ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ws, "Could not create waitset of coroutine scheduler.");
+        dds_entity_t gc = dds_create_guardcondition(DDS_CYCLONEDDS_HANDLE);
+        if (gc < 0) {
+            (void) dds_delete(ws);
+            ISOCPP_DDSC_RESULT_CHECK_AND_THROW(gc, "Could not create guard condition of coroutine scheduler.");
+        }
+        dds_return_t ret = dds_waitset_attach(ws, gc, static_cast<dds_attach_t>(gc));
+        if (ret != DDS_RETCODE_OK) {
+            (void) dds_delete(gc);
+            (void) dds_delete(ws);
+            ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Could not attach guard condition of coroutine scheduler.");
+        }
+        this->state_->waitset = ws;
+        this->state_->guard = gc;
+
+        this->threads_.push_back(std::thread(&state::watch, this->state_));
+        for (uint32_t i = 0; i < threads; i++) {
+            this->threads_.push_back(std::thread(&state::work, this->state_));
+        }
+    }
+
+    ~CoroutineScheduler()
+    {
+        state& st = *this->state_;
+        std::unique_lock<std::mutex> lock(st.mutex);
+        st.terminate = true;
+        lock.unlock();
+        (void) dds_set_guardcondition(st.guard, true);
+        st.cond.notify_all();
+
+        for (std::vector<std::thread>::iterator it = this->threads_.begin(); it != this->threads_.end(); ++it) {
+            if (it->get_id() == std::this_thread::get_id()) {
+                it->detach();
+            } else {
+                it->join();
+            }
+        }
+
+        /* Destroying a coroutine destroys its awaiters, which may release
+         * entities, so it is done without holding the lock. */
+        std::vector<std::coroutine_handle<> > abandoned;
+        lock.lock();
+        for (auto it = st.waiting.begin(); it != st.waiting.end(); ++it) {
+            (void) dds_waitset_detach(st.waitset, it->first);
+            abandoned.insert(abandoned.end(), it->second.begin(), it->second.end());
+        }
+        st.waiting.clear();
+        abandoned.insert(abandoned.end(), st.ready.begin(), st.ready.end());
+        st.ready.clear();
+        for (auto it = st.acks.begin(); it != st.acks.end(); ++it) {
+            abandoned.push_back(std::coroutine_handle<>::from_address(*it));
+        }
+        st.acks.clear();
+        /* Read conditions of readers that were deleted are gone already. */
+        for (auto it = st.read_conditions.begin(); it != st.read_conditions.end(); ++it) {
+            (void) dds_delete(it->second);
+        }
+        st.read_conditions.clear();
+        lock.unlock();
+
+        for (auto it = abandoned.begin(); it != abandoned.end(); ++it) {
+            it->destroy();
+        }
+        (void) dds_delete(st.waitset);
+        (void) dds_delete(st.guard);
+    }
+
+    CoroutineScheduler(const CoroutineScheduler&) = delete;
+    CoroutineScheduler& operator=(const CoroutineScheduler&) = delete;
+
+    /* Resumes the coroutine on one of the worker threads. */
+    void post(std::coroutine_handle<> h)
+    {
+        this->state_->post(h);
+    }
+
+    class ConditionAwaiter;
+    template <typename T> class TakeAwaiter;
+    class AcknowledgmentAwaiter;
+
+    /* Suspends until the condition triggers: a ReadCondition, a QueryCondition,
+     * a StatusCondition or a GuardCondition. */
+    ConditionAwaiter wait(const dds::core::cond::Condition& cond);
+
+    /* Suspends until the reader has data and takes it. The samples may still
+     * be empty when another thread took them first. */
+    template <typename T>
+    TakeAwaiter<T> take(dds::sub::DataReader<T>& reader);
+
+    /* Suspends until the samples written so far have been acknowledged or the
+     * timeout expired, and results in whether they were acknowledged. */
+    AcknowledgmentAwaiter wait_for_acknowledgments(const dds::pub::AnyDataWriter& writer,
+                                                   const dds::core::Duration& timeout);
+
+private:
+    /* Shared with the threads and with pending acknowledgment callbacks. */
+    struct state
+    {
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::map<dds_entity_t, std::vector<std::coroutine_handle<> > > waiting;
+        std::deque<std::coroutine_handle<> > ready;
+        /* Addresses of the coroutines that wait for acknowledgments. */
+        std::set<void*> acks;
+        /* The read condition of every reader that coroutines took from. */
+        std::map<dds_entity_t, dds_entity_t> read_conditions;
+        dds_entity_t waitset = 0;
+        dds_entity_t guard = 0;
+        bool terminate = false;
+
+        void post(std::coroutine_handle<> h)
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->ready.push_back(h);
+            this->cond.notify_one();
+        }
+
+        void suspend(dds_entity_t condition, std::coroutine_handle<> h)
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            dds_return_t ret = this->attach(condition, h);
+            ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Could not attach condition to coroutine scheduler.");
+        }
+
+        /* Suspends until the reader has data, on the read condition of the
+         * reader, which all coroutines that take from it share. */
+        void suspend_for_data(dds_entity_t reader, std::coroutine_handle<> h)
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            auto it = this->read_conditions.find(reader);
+            if (it != this->read_conditions.end()) {
+                if (this->attach(it->second, h) == DDS_RETCODE_OK) {
+                    return;
+                }
+                /* A reader that was deleted took its read condition along, and
+                 * its handle may have been reused since. */
+                this->read_conditions.erase(it);
+            }
+
+            dds_entity_t condition = dds_create_readcondition(reader, DDS_ANY_STATE);
+            ISOCPP_DDSC_RESULT_CHECK_AND_THROW(condition, "Could not create read condition to wait for data.");
+            dds_return_t ret = this->attach(condition, h);
+            if (ret != DDS_RETCODE_OK) {
+                (void) dds_delete(condition);
+                ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Could not attach condition to coroutine scheduler.");
+            }
+            this->read_conditions[reader] = condition;
+        }
+
+        /* The condition is attached for the first coroutine that waits for it.
+         * Attaching a condition that is triggered already wakes the watcher
+         * straight away, so no trigger is missed. Called with the lock held. */
+        dds_return_t attach(dds_entity_t condition, std::coroutine_handle<> h)
+        {
+            std::vector<std::coroutine_handle<> >& w = this->waiting[condition];
+            if (w.empty()) {
+                dds_return_t ret = dds_waitset_attach(this->waitset, condition, static_cast<dds_attach_t>(condition));
+                if (ret != DDS_RETCODE_OK) {
+                    this->waiting.erase(condition);
+                    return ret;
+                }
+            }
+            w.push_back(h);
+            return DDS_RETCODE_OK;
+        }
+
+        /* Undoes suspend() for a coroutine that does not wait after all. */
+        void forget(dds_entity_t condition, std::coroutine_handle<> h)
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            auto it = this->waiting.find(condition);
+            if (it != this->waiting.end()) {
+                it->second.erase(std::remove(it->second.begin(), it->second.end(), h), it->second.end());
+                if (it->second.empty()) {
+                    (void) dds_waitset_detach(this->waitset, condition);
+                    this->waiting.erase(it);
+                }
+            }
+        }
+
+        static void watch(std::shared_ptr<state> st)
+        {
+            std::vector<dds_attach_t> triggered;
+            std::unique_lock<std::mutex> lock(st->mutex);
+
+            while (!st->terminate) {
+                triggered.resize(st->waiting.size() + 1);
+                lock.unlock();
+                dds_return_t n = dds_waitset_wait(st->waitset, triggered.data(), triggered.size(), DDS_INFINITY);
+                lock.lock();
+                if (n < 0) {
+                    break;
+                }
+
+                /* Conditions that did not fit are still triggered next time. */
+                size_t nt = std::min(static_cast<size_t>(n), triggered.size());
+                for (size_t i = 0; i < nt; i++) {
+                    dds_entity_t condition = static_cast<dds_entity_t>(triggered[i]);
+                    if (condition == st->guard) {
+                        (void) dds_set_guardcondition(st->guard, false);
+                        continue;
+                    }
+                    auto it = st->waiting.find(condition);
+                    if (it != st->waiting.end()) {
+                        (void) dds_waitset_detach(st->waitset, condition);
+                        st->ready.insert(st->ready.end(), it->second.begin(), it->second.end());
+                        st->waiting.erase(it);
+                        st->cond.notify_all();
+                    }
+                }
+            }
+        }
+
+        static void work(std::shared_ptr<state> st)
+        {
+            std::unique_lock<std::mutex> lock(st->mutex);
+            while (true) {
+                st->cond.wait(lock, [&st] { return st->terminate || !st->ready.empty(); });
+                if (st->terminate) {
+                    break;
+                }
+                std::coroutine_handle<> h = st->ready.front();
+                st->ready.pop_front();
+                lock.unlock();
+                h.resume();
+                lock.lock();
+            }
+        }
+    };
+
+    std::shared_ptr<state> state_;
+    std::vector<std::thread> threads_;
+};
+
+class CoroutineScheduler::ConditionAwaiter
+{
+public:
+    ConditionAwaiter(CoroutineScheduler& s, const dds::core::cond::Condition& cond)
+        : scheduler_(s), cond_(cond)
+    {
+    }
+
+    bool await_ready()
+    {
+        return this->cond_.trigger_value();
+    }
+
+    void await_suspend(std::coroutine_handle<> h)
+    {
+        this->scheduler_.state_->suspend(this->cond_.delegate()->get_ddsc_entity(), h);
+    }
+
+    void await_resume() { }
+
+private:
+    CoroutineScheduler& scheduler_;
+    /* Keeps the condition alive while suspended. */
+    dds::core::cond::Condition cond_;
+};
+
+template <typename T>
+class CoroutineScheduler::TakeAwaiter
+{
+public:
+    TakeAwaiter(CoroutineScheduler& s, dds::sub::DataReader<T>& reader)
+        : scheduler_(s), reader_(reader)
+    {
+    }
+
+    TakeAwaiter(const TakeAwaiter&) = delete;
+    TakeAwaiter& operator=(const TakeAwaiter&) = delete;
+
+    /* Data that is available already is taken without suspending. */
+    bool await_ready()
+    {
+        this->samples_ = this->reader_.take();
+        return this->samples_.length() > 0;
+    }
+
+    void await_suspend(std::coroutine_handle<> h)
+    {
+        this->scheduler_.state_->suspend_for_data(this->reader_.delegate()->get_ddsc_entity(), h);
+    }
+
+    dds::sub::LoanedSamples<T> await_resume()
+    {
+        if (this->samples_.length() == 0) {
+            this->samples_ = this->reader_.take();
+        }
+        return std::move(this->samples_);
+    }
+
+private:
+    CoroutineScheduler& scheduler_;
+    dds::sub::DataReader<T> reader_;
+    dds::sub::LoanedSamples<T> samples_;
+};
+
+class CoroutineScheduler::AcknowledgmentAwaiter
+{
+public:
+    AcknowledgmentAwaiter(CoroutineScheduler& s,
+                          const dds::pub::AnyDataWriter& writer,
+                          const dds::core::Duration& timeout)
+        : scheduler_(s), writer_(writer), timeout_(timeout), acknowledged_(false)
+    {
+    }
+
+    bool await_ready() { return false; }
+
+    /* The callback only touches the awaiter while the coroutine is known to
+     * be suspended, because the scheduler destroys the coroutines that are
+     * still waiting for acknowledgments when it goes away first. */
+    void await_suspend(std::coroutine_handle<> h)
+    {
+        std::shared_ptr<state> st = this->scheduler_.state_;
+        {
+            std::unique_lock<std::mutex> lock(st->mutex);
+            st->acks.insert(h.address());
+        }
+
+        /* The coroutine, and with it this awaiter, may be gone by the time the
+         * call returns. */
+        std::weak_ptr<state> weak = st;
+        bool *result = &this->acknowledged_;
+        dds::pub::AnyDataWriter::DELEGATE_REF_T writer = this->writer_.delegate();
+        dds::core::Duration timeout = this->timeout_;
+        try {
+            writer->wait_for_acknowledgments_async(timeout,
+                [weak, h, result](bool acknowledged) {
+                    std::shared_ptr<state> s = weak.lock();
+                    if (s) {
+                        std::unique_lock<std::mutex> lock(s->mutex);
+                        if (s->acks.erase(h.address()) > 0) {
+                            *result = acknowledged;
+                            s->ready.push_back(h);
+                            s->cond.notify_one();
+                        }
+                    }
+                });
+        } catch (...) {
+            std::unique_lock<std::mutex> lock(st->mutex);
+            st->acks.erase(h.address());
+            throw;
+        }
+    }
+
+    bool await_resume() { return this->acknowledged_; }
+
+private:
+    CoroutineScheduler& scheduler_;
+    dds::pub::AnyDataWriter writer_;
+    dds::core::Duration timeout_;
+    bool acknowledged_;
+};
+
+inline CoroutineScheduler::ConditionAwaiter
+CoroutineScheduler::wait(const dds::core::cond::Condition& cond)
+{
+    return ConditionAwaiter(*this, cond);
+}
+
+template <typename T>
+inline CoroutineScheduler::TakeAwaiter<T>
+CoroutineScheduler::take(dds::sub::DataReader<T>& reader)
+{
+    return TakeAwaiter<T>(*this, reader);
+}
+
+inline CoroutineScheduler::AcknowledgmentAwaiter
+CoroutineScheduler::wait_for_acknowledgments(const dds::pub::AnyDataWriter& writer,
+                                             const dds::core::Duration& timeout)
+{
+    return AcknowledgmentAwaiter(*this, writer, timeout);
+}
+
+}
+}
+}
+}
+
+#endif /* CYCLONEDDS_HAS_COROUTINES */
+
+#endif /* CYCLONEDDS_CORE_COROUTINES_HPP_ */
@@ -0,0 +1,122 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+
+
+/**
+ * @file
+ */
+
+#ifndef CYCLONEDDS_CORE_DDSC_QOS_CACHE_HPP_
+#define CYCLONEDDS_CORE_DDSC_QOS_CACHE_HPP_
+
+#include <memory>
+
+#include <dds/dds.h>
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace core
+{
+
+/*
+ * Memoizes the ddsc translation of an ISOCPP QoS delegate.
+ *
+ * Copies of a QoS delegate share one cache slot, so a translation made for
+ * any of them (for instance the private copy held by an entity) is reused by
+ * the others, including the QoS object the application passed in. Setting a
+ * policy detaches the QoS delegate from the shared slot (invalidate()),
+ * leaving the other copies and the translation they share untouched. A stored
+ * ddsc QoS is never modified, and the slot itself is accessed atomically
+ * because const QoS objects are regularly shared between threads that create
+ * entities.
+ *
+ * A policy that is handed out by non-const reference can be modified at any
+ * later time, without the delegate noticing. Such a delegate is marked as
+ * escaped (escape()), after which it is translated on every use and never
+ * shares a translation again. Copies of it are not escaped themselves, as
+ * nothing refers into them.
+ */
+class DdscQosCache
+{
+public:
+    typedef std::shared_ptr<const dds_qos_t> qos_ref;
+
+    DdscQosCache() : slot_(std::make_shared<slot>()), escaped_(false) { }
+
+    DdscQosCache(const DdscQosCache& other)
+        : slot_(other.escaped_ ? std::make_shared<slot>() : other.slot_), escaped_(false) { }
+
+    /* An escaped cache stays escaped: the references into the delegate are
+     * still around after it has been assigned to. */
+    DdscQosCache& operator=(const DdscQosCache& other)
+    {
+        if (this != &other) {
+            slot_ = (other.escaped_ || escaped_) ? std::make_shared<slot>() : other.slot_;
+        }
+        return *this;
+    }
+
+    void invalidate()
+    {
+        slot_ = std::make_shared<slot>();
+    }
+
+    void escape()
+    {
+        if (!escaped_) {
+            escaped_ = true;
+            invalidate();
+        }
+    }
+
+    /* Returns the cached ddsc QoS, or an empty reference when there is none. */
+    qos_ref get() const
+    {
+        if (escaped_) {
+            return qos_ref();
+        }
+        return std::atomic_load(&slot_->qos);
+    }
+
+    /* Takes ownership of the given ddsc QoS. When another thread managed to
+     * store its translation first, that one is kept and returned instead. */
+    qos_ref set(dds_qos_t* qos) const
+    {
+        qos_ref fresh(qos, dds_delete_qos);
+        if (escaped_) {
+            return fresh;
+        }
+        qos_ref expected;
+        if (std::atomic_compare_exchange_strong(&slot_->qos, &expected, fresh)) {
+            return fresh;
+        }
+        return expected;
+    }
+
+private:
+    struct slot {
+        qos_ref qos;
+    };
+    std::shared_ptr<slot> slot_;
+    bool escaped_;
+};
+
+}
+}
+}
+}
+
+#endif /* CYCLONEDDS_CORE_DDSC_QOS_CACHE_HPP_ */
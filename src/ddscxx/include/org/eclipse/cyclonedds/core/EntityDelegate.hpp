@@ -22,6 +22,7 @@
 #include <dds/core/InstanceHandle.hpp>
 #include <dds/core/policy/CorePolicy.hpp>
 #include <org/eclipse/cyclonedds/core/DDScObjectDelegate.hpp>
+#include <org/eclipse/cyclonedds/core/ListenerExecutor.hpp>
 #include <org/eclipse/cyclonedds/ForwardDeclarations.hpp>
 #include <org/eclipse/cyclonedds/core/status/StatusDelegate.hpp>
 
@@ -73,6 +74,45 @@ public:
     bool obtain_callback_lock() ;
     void release_callback_lock() ;
 
+    /**
+     *  @internal Lets the listener callbacks of this entity run on the given
+     *  executor instead of on the ddsc thread that raised the status. An empty
+     *  reference makes them synchronous again. Entities that are created later
+     *  on inherit the executor of their parent.
+     */
+    void listener_executor(const ListenerExecutor::ref_type& executor);
+    ListenerExecutor::ref_type listener_executor() const;
+
+    /**
+     *  @internal Hands a callback for which the callback lock was obtained to
+     *  the listener executor, which releases the lock once the callback is
+     *  done with. Returns false when there is no executor, in which case the
+     *  caller invokes the callback itself.
+     */
+    bool defer_callback(std::function<void()>&& callback, bool coalescable);
+    bool has_listener_executor() const;
+
+    /**
+     *  @internal The entity whose listener ddsc invokes for the status of this
+     *  entity, should it not have a listener for the status itself: the parent
+     *  of which the listener is inherited. Returns NULL for entities that do
+     *  not inherit a listener.
+     */
+    virtual EntityDelegate* listener_parent() const;
+
+    /**
+     *  @internal The first entity in the chain of this entity and its
+     *  listener parents that has a listener for the status, or NULL.
+     */
+    EntityDelegate* listener_target(const dds::core::status::StatusMask& status) const;
+
+    /**
+     *  @internal Invoked from the ddsc thread with the matched status of a
+     *  reader or writer that tracks its matched endpoints.
+     */
+    virtual void on_matched(dds_entity_t entity, dds_instance_handle_t last_handle,
+                            uint32_t current_count);
+
     // Topic callback
     virtual void on_inconsistent_topic(dds_entity_t topic,
           org::eclipse::cyclonedds::core::InconsistentTopicStatusDelegate &) ;
@@ -124,12 +164,19 @@ protected:
     void prevent_callbacks();
     long callback_count;
     dds_listener_t *listener_callbacks;
+    /* The matched statuses for which the listener callback is always set, to
+     * keep track of the matched endpoints (see on_matched). */
+    dds::core::status::StatusMask tracked_mask;
 
 private:
+    bool listens_to(const dds::core::status::StatusMask& status) const;
+
     void *listener;
     ObjectDelegate::weak_ref_type myStatusCondition;
     void *callback_mutex;
     void *callback_cond;
+    ListenerExecutor::ref_type executor;
+    ListenerExecutor::strand_ref executor_strand;
 };
 
 }
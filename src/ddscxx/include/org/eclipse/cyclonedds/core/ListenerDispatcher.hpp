@@ -31,6 +31,10 @@ extern "C"
   extern OMG_DDS_API void callback_on_publication_matched
     (dds_entity_t writer, dds_publication_matched_status_t status, void* arg);
 
+  /* Also tracks the matched endpoints of the writer, see MatchedEndpoints. */
+  extern OMG_DDS_API void callback_on_publication_matched_tracked
+    (dds_entity_t writer, dds_publication_matched_status_t status, void* arg);
+
   extern OMG_DDS_API void callback_on_requested_deadline_missed
     (dds_entity_t reader, dds_requested_deadline_missed_status_t status, void* arg);
 
@@ -48,6 +52,10 @@ extern "C"
   extern OMG_DDS_API void callback_on_subscription_matched
     (dds_entity_t reader, dds_subscription_matched_status_t status, void* arg);
 
+  /* Also tracks the matched endpoints of the reader, see MatchedEndpoints. */
+  extern OMG_DDS_API void callback_on_subscription_matched_tracked
+    (dds_entity_t reader, dds_subscription_matched_status_t status, void* arg);
+
   extern OMG_DDS_API void callback_on_sample_lost
     (dds_entity_t reader, dds_sample_lost_status_t status, void* arg);
 
@@ -0,0 +1,139 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+
+
+/**
+ * @file
+ */
+
+#ifndef CYCLONEDDS_CORE_LISTENER_EXECUTOR_HPP_
+#define CYCLONEDDS_CORE_LISTENER_EXECUTOR_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <dds/core/macros.hpp>
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace core
+{
+
+/*
+ * Pool of threads that invokes listener callbacks on behalf of ddsc.
+ *
+ * Without an executor, the listeners of an entity are invoked synchronously on
+ * the ddsc thread that raised the status, so that a slow listener delays the
+ * delivery of data to all other entities served by that thread. An entity that
+ * has an executor only queues its callbacks on one of the strands of the pool.
+ *
+ * The callbacks of one strand (one entity) are invoked one at a time and in
+ * the order they were submitted; different strands are served concurrently.
+ * Every worker thread has its own queue of strands with pending callbacks and
+ * takes work from the queues of the others when its own queue is empty.
+ *
+ * The number of pending callbacks is bounded, but a submitter that finds the
+ * pool full never waits for room: the submitter is normally a ddsc thread, and
+ * waiting could deadlock, for instance against a set_listener() that waits for
+ * a callback of the strand while that callback waits for the ddsc thread.
+ * Instead, when the strand is idle, the submitter runs the task itself, as
+ * if there were no executor, and otherwise the task is queued on the strand
+ * regardless of the bound, so that the order of the callbacks of the strand
+ * and their mutual exclusion are kept. Workers of the pool itself always
+ * queue their tasks.
+ *
+ * With coalescing enabled, a callback that is submitted as coalescable is
+ * dropped when its strand still has a coalescable callback that did not start
+ * yet: a burst of data available notifications then results in a single
+ * invocation of the listener, which reads all the data anyway.
+ */
+class OMG_DDS_API ListenerExecutor
+{
+public:
+    typedef std::shared_ptr<ListenerExecutor> ref_type;
+
+    /* Invoked with true to run the callback and with false when the callback
+     * was cancelled. Either way it is invoked exactly once. */
+    typedef std::function<void(bool)> task_type;
+
+    class strand;
+    typedef std::shared_ptr<strand> strand_ref;
+
+    /* A thread count of 0 selects the number of hardware threads. */
+    explicit ListenerExecutor(uint32_t threads = 0,
+                              size_t capacity = 1024,
+                              bool coalesce = true);
+    ~ListenerExecutor();
+
+    ListenerExecutor(const ListenerExecutor&) = delete;
+    ListenerExecutor& operator=(const ListenerExecutor&) = delete;
+
+    strand_ref create_strand();
+
+    enum submit_result {
+        /* The task will be invoked by the pool. */
+        queued,
+        /* The task was coalesced with a callback that is still pending and
+         * will never be invoked. */
+        coalesced,
+        /* The pool is full and the strand was idle: the task was invoked by
+         * the submitting thread, before submit returned. */
+        full
+    };
+
+    /* Queues the task on the given strand, or runs it when the pool is full
+     * (see submit_result). Never waits for room. */
+    submit_result submit(const strand_ref& s, task_type&& task, bool coalescable = false);
+
+    /* Cancels the pending tasks of the strand and waits for the one that might
+     * still be running, unless that one is the caller. */
+    void cancel(const strand_ref& s);
+
+    /* Waits for the task of the strand that might be running, unless that one
+     * is the caller. Tasks that are still pending are left alone. */
+    void quiesce(const strand_ref& s);
+
+    /* Waits until all tasks of the strand have run, unless the caller is one
+     * of them. */
+    void drain(const strand_ref& s);
+
+    uint32_t threads() const;
+    size_t capacity() const;
+    bool coalesce() const;
+
+    /* The number of tasks that were submitted while the pool was full. */
+    uint64_t overflows() const;
+
+private:
+    struct state;
+
+    std::shared_ptr<state> state_;
+    std::vector<std::thread> threads_;
+};
+
+}
+}
+}
+}
+
+#endif /* CYCLONEDDS_CORE_LISTENER_EXECUTOR_HPP_ */
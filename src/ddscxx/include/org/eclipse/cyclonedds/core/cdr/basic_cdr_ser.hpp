@@ -32,9 +32,23 @@ namespace cdr {
  * Implementation of the basic cdr stream.
  *
  * This type of cdr stream has a maximum alignment of 8 bytes.
+ *
+ * Whether the primitives in the stream need to be byte swapped is part of
+ * the type of the stream. The streaming functions generated by idlcxx are
+ * templated on the stream type, which makes the swap a compile time decision
+ * and lets one set of generated functions handle both endiannesses.
+ *
+ * @tparam swap Whether the data in the stream has the non-native endianness.
  */
-class basic_cdr_stream : public cdr_stream {
+template<bool swap>
+class basic_cdr_stream_t : public cdr_stream {
 public:
+  /**
+   * @brief
+   * Whether primitives are byte swapped when streamed.
+   */
+  static constexpr bool swapped = swap;
+
   /**
    * @brief
    * Constructor.
@@ -43,9 +57,103 @@ public:
    *
    * @param[in] ignore_faults Bitmask for ignoring faults, can be composed of bit fields from the serialization_status enumerator.
    */
-  basic_cdr_stream(uint64_t ignore_faults = 0x0) : cdr_stream(8, ignore_faults) { ; }
+  basic_cdr_stream_t(uint64_t ignore_faults = 0x0) : cdr_stream(8, ignore_faults) { ; }
+};
+
+/**
+ * @brief
+ * Basic cdr stream for data in the native endianness.
+ */
+typedef basic_cdr_stream_t<false> basic_cdr_stream;
+
+/**
+ * @brief
+ * Basic cdr stream for data in the non-native endianness.
+ */
+typedef basic_cdr_stream_t<true> swapped_basic_cdr_stream;
+
+/**
+ * @brief
+ * Basic cdr stream for big-endian data.
+ *
+ * Keys are serialized in big-endian byte order for their keyhash, regardless
+ * of the endianness of the node.
+ */
+typedef basic_cdr_stream_t<native_endianness() != endianness::big_endian> big_endian_basic_cdr_stream;
+
+/**
+ * @brief
+ * Basic cdr stream used to extract the key fields from serialized data.
+ *
+ * The key_extract functions generated by idlcxx read the members of a
+ * sample that are part of its key, and read the other members with the
+ * stream set to skipping. While skipping, strings and sequences of primitives
+ * are not copied into the sample, only their lengths are read to move the
+ * cursor past them.
+ *
+ * @tparam swap Whether the data in the stream has the non-native endianness.
+ */
+template<bool swap>
+class key_extract_stream_t : public basic_cdr_stream_t<swap> {
+public:
+  /**
+   * @brief
+   * Constructor.
+   *
+   * @param[in] ignore_faults Bitmask for ignoring faults, can be composed of bit fields from the serialization_status enumerator.
+   */
+  key_extract_stream_t(uint64_t ignore_faults = 0x0) : basic_cdr_stream_t<swap>(ignore_faults) { ; }
+
+  /**
+   * @brief
+   * Returns whether the stream is skipping over the data.
+   */
+  bool skipping() const { return m_skipping; }
+
+  /**
+   * @brief
+   * Sets whether the stream skips over the data.
+   *
+   * @param[in] skip Whether to skip over the data.
+   */
+  void skipping(bool skip) { m_skipping = skip; }
+
+private:
+  bool m_skipping = false;
 };
 
+/**
+ * @brief
+ * Key extraction stream for data in the native endianness.
+ */
+typedef key_extract_stream_t<false> key_extract_stream;
+
+/**
+ * @brief
+ * Key extraction stream for data in the non-native endianness.
+ */
+typedef key_extract_stream_t<true> swapped_key_extract_stream;
+
+/**
+ * @brief
+ * Returns whether the stream is skipping over the data, which only key
+ * extraction streams do.
+ *
+ * @param[in] str The stream.
+ */
+template<bool S>
+constexpr bool skipping(const basic_cdr_stream_t<S>& str)
+{
+  (void)str;
+  return false;
+}
+
+template<bool S>
+inline bool skipping(const key_extract_stream_t<S>& str)
+{
+  return str.skipping();
+}
+
 /**
  * @brief
  * Primitive type stream manipulation functions.
@@ -62,14 +170,15 @@ public:
  * Aligns the stream to the alignment of type T.
  * Reads the value from the current position of the stream str into
  * toread.
+ * Swaps the bytes of the value read if the stream is a swapped stream.
  * Moves the cursor of the stream by the size of T.
  * This function is only enabled for arithmetic types and enums.
  *
  * @param[in, out] str The stream which is read from.
  * @param[out] toread The variable to read into.
  */
-template<typename T, std::enable_if_t<std::is_arithmetic<T>::value && !std::is_enum<T>::value, bool> = true >
-inline void read(basic_cdr_stream &str, T& toread)
+template<bool S, typename T, std::enable_if_t<std::is_arithmetic<T>::value && !std::is_enum<T>::value, bool> = true >
+inline void read(basic_cdr_stream_t<S> &str, T& toread)
 {
   if (str.abort_status())
     return;
@@ -78,28 +187,14 @@ inline void read(basic_cdr_stream &str, T& toread)
 
   toread = *static_cast<T*>(str.get_cursor());
 
-  str.incr_position(sizeof(T));
-}
+  if constexpr (S)
+    byte_swap(toread);
 
-/**
- * @brief
- * Primitive type read function, byteswap version.
- *
- * Same as read(), with an additional byteswap at the end.
- *
- * @param[in, out] str The stream which is read from.
- * @param[out] toread The variable to read into.
- */
-template<typename T, std::enable_if_t<std::is_arithmetic<T>::value && !std::is_enum<T>::value, bool> = true >
-inline void read_swapped(basic_cdr_stream &str, T& toread)
-{
-  read(str, toread);
-
-  byte_swap(toread);
+  str.incr_position(sizeof(T));
 }
 
-template<typename T, std::enable_if_t<std::is_arithmetic<T>::value && !std::is_enum<T>::value, bool> = true >
-inline void read_many(basic_cdr_stream &str, T *out, size_t N)
+template<bool S, typename T, std::enable_if_t<std::is_arithmetic<T>::value && !std::is_enum<T>::value, bool> = true >
+inline void read_many(basic_cdr_stream_t<S> &str, T *out, size_t N)
 {
   if (str.abort_status() || N == 0)
     return;
@@ -108,23 +203,13 @@ inline void read_many(basic_cdr_stream &str, T *out, size_t N)
 
   T *in = static_cast<T*>(str.get_cursor());
 
-  memcpy(out, in, sizeof(T)*N);
-
-  str.incr_position(sizeof(T)*N);
-}
-
-template<typename T, std::enable_if_t<std::is_arithmetic<T>::value && !std::is_enum<T>::value, bool> = true >
-inline void read_many_swapped(basic_cdr_stream &str, T *out, size_t N)
-{
-  if (str.abort_status() || N == 0)
-    return;
-
-  str.align(sizeof(T), false);
-
-  T *in = static_cast<T*>(str.get_cursor());
-  for (size_t i = 0; i < N; i++, out++, in++) {
-    *out = *in;
-    byte_swap(*out);
+  if constexpr (S) {
+    for (size_t i = 0; i < N; i++, out++, in++) {
+      *out = *in;
+      byte_swap(*out);
+    }
+  } else {
+    memcpy(out, in, sizeof(T)*N);
   }
 
   str.incr_position(sizeof(T)*N);
@@ -136,39 +221,15 @@ inline void read_many_swapped(basic_cdr_stream &str, T *out, size_t N)
  *
  * Aligns str to the type to be written.
  * Writes towrite to str.
- * Swaps bytes written to str if the endiannesses do not match up.
+ * Swaps the bytes written to str if the stream is a swapped stream.
  * Moves the cursor of str by the size of towrite.
  * This function is only enabled for arithmetic types.
  *
  * @param[in, out] str The stream which is written to.
  * @param[in] towrite The variable to write.
  */
-template<typename T, std::enable_if_t<std::is_arithmetic<T>::value && !std::is_enum<T>::value, bool> = true >
-inline void write(basic_cdr_stream& str, const T& towrite)
-{
-  if (str.abort_status())
-    return;
-
-  str.align(sizeof(T), true);
-
-  auto out = static_cast<T*>(str.get_cursor());
-
-  *out = towrite;
-
-  str.incr_position(sizeof(T));
-}
-
-/**
- * @brief
- * Primitive type write function, byteswap version.
- *
- * Same as write(), with an additional byteswap at the end.
- *
- * @param[in, out] str The stream which is read from.
- * @param[in] towrite The variable to write.
- */
-template<typename T, std::enable_if_t<std::is_arithmetic<T>::value && !std::is_enum<T>::value, bool> = true >
-inline void write_swapped(basic_cdr_stream& str, const T& towrite)
+template<bool S, typename T, std::enable_if_t<std::is_arithmetic<T>::value && !std::is_enum<T>::value, bool> = true >
+inline void write(basic_cdr_stream_t<S>& str, const T& towrite)
 {
   if (str.abort_status())
     return;
@@ -179,13 +240,14 @@ inline void write_swapped(basic_cdr_stream& str, const T& towrite)
 
   *out = towrite;
 
-  byte_swap(*out);
+  if constexpr (S)
+    byte_swap(*out);
 
   str.incr_position(sizeof(T));
 }
 
-template<typename T, std::enable_if_t<std::is_arithmetic<T>::value && !std::is_enum<T>::value, bool> = true >
-inline void write_many(basic_cdr_stream& str, const T* in, size_t N)
+template<bool S, typename T, std::enable_if_t<std::is_arithmetic<T>::value && !std::is_enum<T>::value, bool> = true >
+inline void write_many(basic_cdr_stream_t<S>& str, const T* in, size_t N)
 {
   if (str.abort_status() || N == 0)
     return;
@@ -194,23 +256,13 @@ inline void write_many(basic_cdr_stream& str, const T* in, size_t N)
 
   T *out = static_cast<T*>(str.get_cursor());
 
-  memcpy(out, in, sizeof(T)*N);
-
-  str.incr_position(sizeof(T)*N);
-}
-
-template<typename T, std::enable_if_t<std::is_arithmetic<T>::value && !std::is_enum<T>::value, bool> = true >
-inline void write_many_swapped(basic_cdr_stream& str, const T* in, size_t N)
-{
-  if (str.abort_status() || N == 0)
-    return;
-
-  str.align(sizeof(T), true);
-
-  T *out = static_cast<T*>(str.get_cursor());
-  for (size_t i = 0; i < N; i++, out++, in++) {
-    *out = *in;
-    byte_swap(*out);
+  if constexpr (S) {
+    for (size_t i = 0; i < N; i++, out++, in++) {
+      *out = *in;
+      byte_swap(*out);
+    }
+  } else {
+    memcpy(out, in, sizeof(T)*N);
   }
 
   str.incr_position(sizeof(T)*N);
@@ -228,8 +280,8 @@ inline void write_many_swapped(basic_cdr_stream& str, const T* in, size_t N)
  * @param[in, out] str The stream whose cursor is moved.
  * @param[in] toincr The variable to move the cursor by, no contents of this variable are used, it is just used to determine the template.
  */
-template<typename T, std::enable_if_t<std::is_arithmetic<T>::value && !std::is_enum<T>::value, bool> = true >
-inline void move(basic_cdr_stream& str, const T& toincr)
+template<bool S, typename T, std::enable_if_t<std::is_arithmetic<T>::value && !std::is_enum<T>::value, bool> = true >
+inline void move(basic_cdr_stream_t<S>& str, const T& toincr)
 {
   if (str.abort_status())
     return;
@@ -241,23 +293,8 @@ inline void move(basic_cdr_stream& str, const T& toincr)
   str.incr_position(sizeof(T));
 }
 
-/**
- * @brief
- * Primitive type cursor move function, byteswap version.
- *
- * Same as move(), with an additional byteswap at the end.
- *
- * @param[in, out] str The stream whose cursor is moved.
- * @param[in] toincr The variable to move the cursor by, no contents of this variable are used, it is just used to determine the template.
- */
-template<typename T, std::enable_if_t<std::is_arithmetic<T>::value && !std::is_enum<T>::value, bool> = true >
-inline void move_swapped(basic_cdr_stream& str, const T& toincr)
-{
-  move(str, toincr);
-}
-
-template<typename T, std::enable_if_t<std::is_arithmetic<T>::value && !std::is_enum<T>::value, bool> = true >
-inline void move_many(basic_cdr_stream& str, const T* toincr, size_t N)
+template<bool S, typename T, std::enable_if_t<std::is_arithmetic<T>::value && !std::is_enum<T>::value, bool> = true >
+inline void move_many(basic_cdr_stream_t<S>& str, const T* toincr, size_t N)
 {
   if (str.abort_status())
     return;
@@ -269,12 +306,6 @@ inline void move_many(basic_cdr_stream& str, const T* toincr, size_t N)
   str.incr_position(sizeof(T)*N);
 }
 
-template<typename T, std::enable_if_t<std::is_arithmetic<T>::value && !std::is_enum<T>::value, bool> = true >
-inline void move_many_swapped(basic_cdr_stream& str, const T* toincr, size_t N)
-{
-  move_many(str, toincr, N);
-}
-
 /**
  * @brief
  * Primitive type max stream move function.
@@ -291,8 +322,8 @@ inline void move_many_swapped(basic_cdr_stream& str, const T* toincr, size_t N)
  * @param[in, out] str The stream whose cursor is moved.
  * @param[in] max_sz The variable to move the cursor by, no contents of this variable are used, it is just used to determine the template.
  */
-template<typename T, std::enable_if_t<std::is_arithmetic<T>::value && !std::is_enum<T>::value, bool> = true >
-inline void max(basic_cdr_stream& str, const T& max_sz)
+template<bool S, typename T, std::enable_if_t<std::is_arithmetic<T>::value && !std::is_enum<T>::value, bool> = true >
+inline void max(basic_cdr_stream_t<S>& str, const T& max_sz)
 {
   if (str.abort_status())
     return;
@@ -303,23 +334,8 @@ inline void max(basic_cdr_stream& str, const T& max_sz)
   move(str, max_sz);
 }
 
-/**
- * @brief
- * Primitive type max stream move function.
- *
- * Same as max(), with an additional byteswap at the end.
- *
- * @param[in, out] str The stream whose cursor is moved.
- * @param[in] max_sz The variable to move the cursor by, no contents of this variable are used, it is just used to determine the template.
- */
-template<typename T, std::enable_if_t<std::is_arithmetic<T>::value && !std::is_enum<T>::value, bool> = true >
-inline void max_swapped(basic_cdr_stream& str, const T& max_sz)
-{
-  max(str, max_sz);
-}
-
-template<typename T, std::enable_if_t<std::is_arithmetic<T>::value && !std::is_enum<T>::value, bool> = true >
-inline void max_many(basic_cdr_stream& str, const T* max_sz, size_t N)
+template<bool S, typename T, std::enable_if_t<std::is_arithmetic<T>::value && !std::is_enum<T>::value, bool> = true >
+inline void max_many(basic_cdr_stream_t<S>& str, const T* max_sz, size_t N)
 {
   if (str.abort_status())
     return;
@@ -330,13 +346,6 @@ inline void max_many(basic_cdr_stream& str, const T* max_sz, size_t N)
   move_many(str, max_sz, N);
 }
 
-template<typename T, std::enable_if_t<std::is_arithmetic<T>::value && !std::is_enum<T>::value, bool> = true >
-inline void max_many_swapped(basic_cdr_stream& str, const T* max_sz, size_t N)
-{
-  max_many(str, max_sz, N);
-}
-
-
 /**
  * @brief
  * Enumerated type stream manipulation functions.
@@ -355,33 +364,16 @@ inline void max_many_swapped(basic_cdr_stream& str, const T* max_sz, size_t N)
  * @param[in, out] str The stream which is read from.
  * @param[out] toread The variable to read into.
  */
-template<typename T, std::enable_if_t<std::is_enum<T>::value && !std::is_arithmetic<T>::value, bool> = true >
-inline void read(basic_cdr_stream& str, T& toread) {
+template<bool S, typename T, std::enable_if_t<std::is_enum<T>::value && !std::is_arithmetic<T>::value, bool> = true >
+inline void read(basic_cdr_stream_t<S>& str, T& toread) {
   read(str, *reinterpret_cast<uint32_t*>(&toread));
 }
 
-/**
- * @brief
- * Reads the byteswapped value of the enum from the stream.
- *
- * @param[in, out] str The stream which is read from.
- * @param[out] toread The variable to read into.
- */
-template<typename T, std::enable_if_t<std::is_enum<T>::value && !std::is_arithmetic<T>::value, bool> = true >
-inline void read_swapped(basic_cdr_stream& str, T& toread) {
-  read_swapped(str, *reinterpret_cast<uint32_t*>(&toread));
-}
-
-template<typename T, std::enable_if_t<std::is_enum<T>::value && !std::is_arithmetic<T>::value, bool> = true >
-inline void read_many(basic_cdr_stream& str, T* toread, size_t N) {
+template<bool S, typename T, std::enable_if_t<std::is_enum<T>::value && !std::is_arithmetic<T>::value, bool> = true >
+inline void read_many(basic_cdr_stream_t<S>& str, T* toread, size_t N) {
   read_many(str, reinterpret_cast<uint32_t*>(toread), N);
 }
 
-template<typename T, std::enable_if_t<std::is_enum<T>::value && !std::is_arithmetic<T>::value, bool> = true >
-inline void read_many_swapped(basic_cdr_stream& str, T* toread, size_t N) {
-  read_many_swapped(str, reinterpret_cast<uint32_t*>(toread), N);
-}
-
 /**
  * @brief
  * Writes the value of the enum to the stream.
@@ -389,31 +381,14 @@ inline void read_many_swapped(basic_cdr_stream& str, T* toread, size_t N) {
  * @param [in, out] str The stream which is written to.
  * @param [in] towrite The variable to write.
  */
-template<typename T, std::enable_if_t<std::is_enum<T>::value && !std::is_arithmetic<T>::value, bool> = true >
-inline void write(basic_cdr_stream& str, const T& towrite) {
+template<bool S, typename T, std::enable_if_t<std::is_enum<T>::value && !std::is_arithmetic<T>::value, bool> = true >
+inline void write(basic_cdr_stream_t<S>& str, const T& towrite) {
   write(str, uint32_t(towrite));
 }
 
-/**
- * @brief
- * Writes the byteswapped value of the enum to the stream.
- *
- * @param [in, out] str The stream which is written to.
- * @param [in] towrite The variable to write.
- */
-template<typename T, std::enable_if_t<std::is_enum<T>::value && !std::is_arithmetic<T>::value, bool> = true >
-inline void write_swapped(basic_cdr_stream& str, const T& towrite) {
-  write_swapped(str, uint32_t(towrite));
-}
-
-template<typename T, std::enable_if_t<std::is_enum<T>::value && !std::is_arithmetic<T>::value, bool> = true >
-inline void write_many(basic_cdr_stream& str, const T* towrite, size_t N) {
-  write_many(str, static_cast<uint32_t*>(towrite), N);
-}
-
-template<typename T, std::enable_if_t<std::is_enum<T>::value && !std::is_arithmetic<T>::value, bool> = true >
-inline void write_many_swapped(basic_cdr_stream& str, const T* towrite, size_t N) {
-  write_many_swapped(str, static_cast<uint32_t*>(towrite), N);
+template<bool S, typename T, std::enable_if_t<std::is_enum<T>::value && !std::is_arithmetic<T>::value, bool> = true >
+inline void write_many(basic_cdr_stream_t<S>& str, const T* towrite, size_t N) {
+  write_many(str, reinterpret_cast<const uint32_t*>(towrite), N);
 }
 
 /**
@@ -423,31 +398,14 @@ inline void write_many_swapped(basic_cdr_stream& str, const T* towrite, size_t N
  * @param[in, out] str The stream whose cursor is moved.
  * @param[in] toincr The variable to move the cursor by, no contents of this variable are used, it is just used to determine the template.
  */
-template<typename T, std::enable_if_t<std::is_enum<T>::value && !std::is_arithmetic<T>::value, bool> = true >
-inline void move(basic_cdr_stream& str, const T& toincr) {
+template<bool S, typename T, std::enable_if_t<std::is_enum<T>::value && !std::is_arithmetic<T>::value, bool> = true >
+inline void move(basic_cdr_stream_t<S>& str, const T& toincr) {
   move(str, uint32_t(toincr));
 }
 
-/**
- * @brief
- * Moves the cursor of the stream by the size the enum would take up (byteswapped version).
- *
- * @param[in, out] str The stream whose cursor is moved.
- * @param[in] toincr The variable to move the cursor by, no contents of this variable are used, it is just used to determine the template.
- */
-template<typename T, std::enable_if_t<std::is_enum<T>::value && !std::is_arithmetic<T>::value, bool> = true >
-inline void move_swapped(basic_cdr_stream& str, const T& toincr) {
-  move_swapped(str, uint32_t(toincr));
-}
-
-template<typename T, std::enable_if_t<std::is_enum<T>::value && !std::is_arithmetic<T>::value, bool> = true >
-inline void move_many(basic_cdr_stream& str, const T* toincr, size_t N) {
-  move_many(str, static_cast<uint32_t*>(toincr), N);
-}
-
-template<typename T, std::enable_if_t<std::is_enum<T>::value && !std::is_arithmetic<T>::value, bool> = true >
-inline void move_many_swapped(basic_cdr_stream& str, const T* toincr, size_t N) {
-  move_many_swapped(str, static_cast<uint32_t*>(toincr), N);
+template<bool S, typename T, std::enable_if_t<std::is_enum<T>::value && !std::is_arithmetic<T>::value, bool> = true >
+inline void move_many(basic_cdr_stream_t<S>& str, const T* toincr, size_t N) {
+  move_many(str, reinterpret_cast<const uint32_t*>(toincr), N);
 }
 
 /**
@@ -457,31 +415,14 @@ inline void move_many_swapped(basic_cdr_stream& str, const T* toincr, size_t N)
  * @param[in, out] str The stream whose cursor is moved.
  * @param[in] max_sz The variable to move the cursor by, no contents of this variable are used, it is just used to determine the template.
  */
-template<typename T, std::enable_if_t<std::is_enum<T>::value && !std::is_arithmetic<T>::value, bool> = true >
-inline void max(basic_cdr_stream& str, const T& max_sz) {
+template<bool S, typename T, std::enable_if_t<std::is_enum<T>::value && !std::is_arithmetic<T>::value, bool> = true >
+inline void max(basic_cdr_stream_t<S>& str, const T& max_sz) {
   max(str, uint32_t(max_sz));
 }
 
-/**
- * @brief
- * Moves the cursor of the stream by the size the enum would take up (maximum size and byteswapped version).
- *
- * @param[in, out] str The stream whose cursor is moved.
- * @param[in] max_sz The variable to move the cursor by, no contents of this variable are used, it is just used to determine the template.
- */
-template<typename T, std::enable_if_t<std::is_enum<T>::value && !std::is_arithmetic<T>::value, bool> = true >
-inline void max_swapped(basic_cdr_stream& str, const T& max_sz) {
-  max_swapped(str, uint32_t(max_sz));
-}
-
-template<typename T, std::enable_if_t<std::is_enum<T>::value && !std::is_arithmetic<T>::value, bool> = true >
-inline void max_many(basic_cdr_stream& str, const T* max_sz, size_t N) {
-  max_many(str, static_cast<uint32_t*>(max_sz), N);
-}
-
-template<typename T, std::enable_if_t<std::is_enum<T>::value && !std::is_arithmetic<T>::value, bool> = true >
-inline void max_many_swapped(basic_cdr_stream& str, const T* max_sz, size_t N) {
-  max_many_swapped(str, static_cast<uint32_t*>(max_sz), N);
+template<bool S, typename T, std::enable_if_t<std::is_enum<T>::value && !std::is_arithmetic<T>::value, bool> = true >
+inline void max_many(basic_cdr_stream_t<S>& str, const T* max_sz, size_t N) {
+  max_many(str, reinterpret_cast<const uint32_t*>(max_sz), N);
 }
 
  /**
@@ -505,8 +446,8 @@ inline void max_many_swapped(basic_cdr_stream& str, const T* max_sz, size_t N) {
  * @param[out] toread The string to read to.
  * @param[in] N The maximum number of characters to read from the stream.
  */
-template<typename T>
-void read_string(basic_cdr_stream& str, T& toread, size_t N)
+template<bool S, typename T>
+void read_string(basic_cdr_stream_t<S>& str, T& toread, size_t N)
 {
   if (str.abort_status())
     return;
@@ -536,47 +477,6 @@ void read_string(basic_cdr_stream& str, T& toread, size_t N)
   str.alignment(1);
 }
 
-/**
- * @brief
- * Bounded string read function, byteswapped version.
- *
- * Same as read_string(), only that the string length is byte swapped.
- *
- * @param[in, out] str The stream to read from.
- * @param[out] toread The string to read to.
- * @param[in] N The maximum number of characters to read from the stream.
- */
-template<typename T>
-void read_string_swapped(basic_cdr_stream& str, T& toread, size_t N)
-{
-  if (str.abort_status())
-    return;
-
-  uint32_t string_length = 0;
-
-  read_swapped(str, string_length);
-
-  if (string_length == 0 &&
-      str.status(serialization_status::illegal_field_value))
-      return;
-
-  //the string length in the CDR stream includes the terminating NULL
-  //therefore the checks on the string length decrease it by 1
-
-  if (N &&
-      string_length - 1 > N &&
-      str.status(serialization_status::read_bound_exceeded))
-      return;
-
-  auto cursor = str.get_cursor();
-  toread.assign(static_cast<char*>(cursor), std::min<size_t>(string_length - 1, N ? N : SIZE_MAX));  //remove 1 for terminating NULL
-
-  str.incr_position(string_length);
-
-  //aligned to chars
-  str.alignment(1);
-}
-
 /**
  * @brief
  * Bounded string write function.
@@ -589,8 +489,8 @@ void read_string_swapped(basic_cdr_stream& str, T& toread, size_t N)
  * @param[in] towrite The string to write.
  * @param[in] N The maximum number of characters to write to the stream.
  */
-template<typename T>
-void write_string(basic_cdr_stream& str, const T& towrite, size_t N)
+template<bool S, typename T>
+void write_string(basic_cdr_stream_t<S>& str, const T& towrite, size_t N)
 {
   if (str.abort_status())
     return;
@@ -615,42 +515,6 @@ void write_string(basic_cdr_stream& str, const T& towrite, size_t N)
   str.alignment(1);
 }
 
-/**
- * @brief
- * Bounded string write function, byteswapped version.
- *
- * Same as write_string(), only that the string length is byte swapped.
- *
- * @param[in, out] str The stream to write to.
- * @param[in] towrite The string to write.
- * @param[in] N The maximum number of characters to write to the stream.
- */
-template<typename T>
-void write_string_swapped(basic_cdr_stream& str, const T& towrite, size_t N)
-{
-  if (str.abort_status())
-    return;
-
-  size_t string_length = towrite.length();
-  if (N &&
-      string_length > N) {
-    if (str.status(serialization_status::write_bound_exceeded))
-      return;
-  }
-
-  //add 1 extra for terminating NULL
-  string_length++;
-
-  write_swapped(str, uint32_t(string_length));
-
-  memcpy(str.get_cursor(), towrite.c_str(), string_length);
-
-  str.incr_position(string_length);
-
-  //aligned to chars
-  str.alignment(1);
-}
-
 /**
  * @brief
  * Bounded string cursor move function.
@@ -663,8 +527,8 @@ void write_string_swapped(basic_cdr_stream& str, const T& towrite, size_t N)
  * @param[in] toincr The string used to move the cursor.
  * @param[in] N The maximum number of characters in the string which the stream is moved by.
  */
-template<typename T>
-void move_string(basic_cdr_stream& str, const T& toincr, size_t N)
+template<bool S, typename T>
+void move_string(basic_cdr_stream_t<S>& str, const T& toincr, size_t N)
 {
   if (str.abort_status())
     return;
@@ -687,22 +551,6 @@ void move_string(basic_cdr_stream& str, const T& toincr, size_t N)
   str.alignment(1);
 }
 
-/**
- * @brief
- * Bounded string cursor move function, byteswapped version.
- *
- * Same as move_string().
- *
- * @param[in, out] str The stream whose cursor is moved.
- * @param[in] toincr The string used to move the cursor.
- * @param[in] N The maximum number of characters in the string which the stream is moved by.
- */
-template<typename T>
-inline void move_string_swapped(basic_cdr_stream& str, const T& toincr, size_t N)
-{
-  move_string(str, toincr, N);
-}
-
 /**
  * @brief
  * Bounded string cursor max move function.
@@ -715,8 +563,8 @@ inline void move_string_swapped(basic_cdr_stream& str, const T& toincr, size_t N
  * @param[in] max_sz The string used to move the cursor.
  * @param[in] N The maximum number of characters in the string which the stream is moved by.
  */
-template<typename T>
-void max_string(basic_cdr_stream& str, const T& max_sz, size_t N)
+template<bool S, typename T>
+void max_string(basic_cdr_stream_t<S>& str, const T& max_sz, size_t N)
 {
   if (str.abort_status())
     return;
@@ -746,18 +594,59 @@ void max_string(basic_cdr_stream& str, const T& max_sz, size_t N)
 
 /**
  * @brief
- * Bounded string cursor max move function, byteswapped version.
- *
- * Same as max_string().
+ * Key extraction stream functions.
  *
- * @param[in, out] str The stream whose cursor is moved.
- * @param[in] max_sz The string used to move the cursor.
- * @param[in] N The maximum number of characters in the string which the stream is moved by.
+ * These read like the basic cdr stream functions, unless the stream is
+ * skipping, in which case they only move the cursor past the data.
  */
-template<typename T>
-inline void max_string_swapped(basic_cdr_stream& str, const T& max_sz, size_t N)
+
+template<bool S, typename T, std::enable_if_t<std::is_arithmetic<T>::value || std::is_enum<T>::value, bool> = true >
+inline void read_many(key_extract_stream_t<S> &str, T *out, size_t N)
 {
-  max_string(str, max_sz, N);
+  if (!str.skipping()) {
+    read_many(static_cast<basic_cdr_stream_t<S>&>(str), out, N);
+    return;
+  }
+
+  if (str.abort_status() || N == 0)
+    return;
+
+  (void)out;
+
+  //enums are represented by a uint32_t
+  constexpr size_t size = std::is_enum<T>::value ? sizeof(uint32_t) : sizeof(T);
+  str.align(size, false);
+  str.incr_position(size*N);
+}
+
+template<bool S, typename T>
+void read_string(key_extract_stream_t<S>& str, T& toread, size_t N)
+{
+  if (!str.skipping()) {
+    read_string(static_cast<basic_cdr_stream_t<S>&>(str), toread, N);
+    return;
+  }
+
+  if (str.abort_status())
+    return;
+
+  uint32_t string_length = 0;
+
+  read(str, string_length);
+
+  if (string_length == 0 &&
+      str.status(serialization_status::illegal_field_value))
+      return;
+
+  if (N &&
+      string_length - 1 > N &&
+      str.status(serialization_status::read_bound_exceeded))
+      return;
+
+  str.incr_position(string_length);
+
+  //aligned to chars
+  str.alignment(1);
 }
 
 }
@@ -0,0 +1,86 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+
+
+/**
+ * @file
+ */
+
+#ifndef CYCLONEDDS_CORE_COND_READINESS_NOTIFIER_HPP_
+#define CYCLONEDDS_CORE_COND_READINESS_NOTIFIER_HPP_
+
+#include <vector>
+
+#include <dds/dds.h>
+#include <dds/core/macros.hpp>
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace core
+{
+namespace cond
+{
+
+/*
+ * File descriptor that becomes readable when one of a set of conditions
+ * triggers, so that a WaitSet can be served from a poll/epoll event loop.
+ *
+ * All notifiers of the process are served by a single watcher thread that
+ * waits on a private ddsc waitset. Once a notifier has fired, its conditions
+ * are no longer watched until rearm() is called, which is what the WaitSet
+ * does after it has been polled. Conditions that are still triggered at that
+ * point make the descriptor readable again straight away, so the descriptor
+ * is level triggered like the conditions themselves.
+ *
+ * On Linux the descriptor is an eventfd, elsewhere it is the read end of a
+ * non-blocking pipe. It is not available on Windows.
+ */
+class OMG_DDS_API ReadinessNotifier
+{
+public:
+    ReadinessNotifier();
+    ~ReadinessNotifier();
+
+    ReadinessNotifier(const ReadinessNotifier&) = delete;
+    ReadinessNotifier& operator=(const ReadinessNotifier&) = delete;
+
+    int fd() const;
+
+    void add(dds_entity_t condition);
+    void remove(dds_entity_t condition);
+
+    /* Clears the descriptor and starts watching the conditions again. */
+    void rearm();
+
+private:
+    class watcher;
+    friend class watcher;
+
+    /* Invoked by the watcher, with its lock held. */
+    void fire();
+
+    int fds_[2];
+    std::vector<dds_entity_t> conditions_;
+    bool armed_;
+};
+
+}
+}
+}
+}
+}
+
+#endif /* CYCLONEDDS_CORE_COND_READINESS_NOTIFIER_HPP_ */
@@ -19,11 +19,13 @@
 
 #include <vector>
 #include <map>
+#include <memory>
 
 #include <dds/core/Duration.hpp>
 #include <dds/core/cond/Condition.hpp>
 #include <org/eclipse/cyclonedds/core/config.hpp>
 #include <org/eclipse/cyclonedds/core/DDScObjectDelegate.hpp>
+#include <org/eclipse/cyclonedds/core/cond/ReadinessNotifier.hpp>
 
 namespace dds
 {
@@ -79,12 +81,41 @@ DDSCXX_WARNING_MSVC_OFF(4251)
 
         void dispatch (const dds::core::Duration & timeout);
 
+        /**
+         *  @internal Like wait() and dispatch(), but a timeout or a failure
+         *  of ddsc is returned as DDS_RETCODE_TIMEOUT or as the ddsc error,
+         *  rather than raised as an exception. These are meant for loops that
+         *  poll with short timeouts. Exceptions thrown by the handlers of the
+         *  conditions are still propagated.
+         */
+        dds_return_t try_wait (ConditionSeq& triggered, const dds::core::Duration& timeout);
+        dds_return_t try_dispatch (const dds::core::Duration& timeout);
+
         void attach_condition (const dds::core::cond::Condition & cond);
         bool detach_condition (org::eclipse::cyclonedds::core::cond::ConditionDelegate * cond);
         ConditionSeq & conditions (ConditionSeq & conds) const;
 
+        /**
+         *  @internal Returns a file descriptor that becomes readable when one
+         *  of the attached conditions triggers, for use with poll/epoll. It is
+         *  owned by the WaitSet and stays valid until the WaitSet is closed.
+         *  After it became readable, poll_triggered() has to be invoked to
+         *  make it signal again.
+         */
+        int notifier_fd ();
+
+        /**
+         *  @internal Returns the triggered conditions without blocking, like
+         *  wait() does when a condition has triggered, and clears the file
+         *  descriptor. Apart from growing the given sequence, which can be
+         *  reused between calls, this does not allocate memory.
+         */
+        ConditionSeq & poll_triggered (ConditionSeq & triggered);
+
     private:
         ConditionMap conditions_;
+        std::vector<dds_attach_t> poll_buffer_;
+        std::unique_ptr<ReadinessNotifier> notifier_;
     };
 
 DDSCXX_WARNING_MSVC_ON(4251)
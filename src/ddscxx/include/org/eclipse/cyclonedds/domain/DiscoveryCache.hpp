@@ -0,0 +1,108 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+
+
+/**
+ * @file
+ */
+
+#ifndef CYCLONEDDS_DOMAIN_DISCOVERY_CACHE_HPP_
+#define CYCLONEDDS_DOMAIN_DISCOVERY_CACHE_HPP_
+
+#include <unordered_map>
+
+#include <dds/dds.h>
+#include <dds/core/ref_traits.hpp>
+#include <dds/topic/BuiltinTopic.hpp>
+#include <org/eclipse/cyclonedds/core/Mutex.hpp>
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace domain
+{
+
+/*
+ * Participant-level cache of the discovery data that is published on the
+ * DCPSParticipant, DCPSPublication and DCPSSubscription builtin topics.
+ *
+ * The cache owns a ddsc reader for each of these builtin topics. The readers
+ * have a data available listener that takes the new samples and updates the
+ * cache incrementally, so that lookups (for instance by the matched
+ * publication/subscription functions) are simple map lookups that do not have
+ * to go through the builtin topic readers. The updates of each map are
+ * serialized, so that they are applied in the order ddsc delivers them.
+ *
+ * The cache is keyed by instance handle. In ddsc, the instance handle of a
+ * builtin topic instance is the instance handle of the entity it describes,
+ * which means that the handles returned by dds_get_matched_subscriptions() and
+ * dds_get_matched_publications() can be used directly.
+ */
+class OMG_DDS_API DiscoveryCache
+{
+public:
+    typedef ::dds::core::smart_ptr_traits< DiscoveryCache >::ref_type ref_type;
+
+public:
+    DiscoveryCache(dds_entity_t participant);
+    virtual ~DiscoveryCache();
+
+    void close();
+
+    bool participant_data(dds_instance_handle_t handle,
+                          dds::topic::ParticipantBuiltinTopicData& data) const;
+
+    /* The cache holds every endpoint that was discovered in the domain, so
+     * the matched publication/subscription functions first check the handle
+     * against the MatchedEndpoints of their reader or writer. */
+    bool publication_data(dds_instance_handle_t handle,
+                          dds::topic::PublicationBuiltinTopicData& data) const;
+
+    bool subscription_data(dds_instance_handle_t handle,
+                           dds::topic::SubscriptionBuiltinTopicData& data) const;
+
+    /* Invoked from the ddsc listener of the builtin readers. */
+    void on_data_available(dds_entity_t reader);
+
+private:
+    typedef std::unordered_map<dds_instance_handle_t, dds::topic::ParticipantBuiltinTopicData> participant_map;
+    typedef std::unordered_map<dds_instance_handle_t, dds::topic::PublicationBuiltinTopicData> publication_map;
+    typedef std::unordered_map<dds_instance_handle_t, dds::topic::SubscriptionBuiltinTopicData> subscription_map;
+
+    dds_entity_t create_reader(dds_entity_t participant, dds_entity_t topic);
+
+    void update_participants();
+    void update_publications();
+    void update_subscriptions();
+
+    org::eclipse::cyclonedds::core::Mutex participant_update_mutex_;
+    org::eclipse::cyclonedds::core::Mutex publication_update_mutex_;
+    org::eclipse::cyclonedds::core::Mutex subscription_update_mutex_;
+    org::eclipse::cyclonedds::core::Mutex mutex_;
+    dds_listener_t *listener_;
+    dds_entity_t participant_reader_;
+    dds_entity_t publication_reader_;
+    dds_entity_t subscription_reader_;
+    participant_map participants_;
+    publication_map publications_;
+    subscription_map subscriptions_;
+};
+
+}
+}
+}
+}
+
+#endif /* CYCLONEDDS_DOMAIN_DISCOVERY_CACHE_HPP_ */
@@ -147,6 +147,12 @@ public:
     void
     builtin_subscriber(const org::eclipse::cyclonedds::core::EntityDelegate::ref_type subscriber);
 
+    ::dds::core::smart_ptr_traits< org::eclipse::cyclonedds::domain::DiscoveryCache >::ref_type
+    discovery_cache();
+
+    ::dds::core::smart_ptr_traits< org::eclipse::cyclonedds::pub::AcknowledgmentWaiter >::ref_type
+    acknowledgment_waiter();
+
     // Subscriber events
     virtual void on_data_readers(dds_entity_t subscriber);
 
@@ -182,6 +188,8 @@ private:
     org::eclipse::cyclonedds::core::ObjectSet cfTopics;
     org::eclipse::cyclonedds::core::EntityDelegate::weak_ref_type builtin_subscriber_;
     org::eclipse::cyclonedds::domain::DomainWrap::ref_type domain_ref_;
+    ::dds::core::smart_ptr_traits< org::eclipse::cyclonedds::domain::DiscoveryCache >::ref_type discovery_cache_;
+    ::dds::core::smart_ptr_traits< org::eclipse::cyclonedds::pub::AcknowledgmentWaiter >::ref_type acknowledgment_waiter_;
 };
 
 #endif /* CYCLONEDDS_DOMAIN_PARTICIPANT_DELEGATE_HPP_ */
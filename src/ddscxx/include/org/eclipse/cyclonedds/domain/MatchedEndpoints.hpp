@@ -0,0 +1,78 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+
+
+/**
+ * @file
+ */
+
+#ifndef CYCLONEDDS_DOMAIN_MATCHED_ENDPOINTS_HPP_
+#define CYCLONEDDS_DOMAIN_MATCHED_ENDPOINTS_HPP_
+
+#include <unordered_set>
+
+#include <dds/dds.h>
+#include <dds/core/macros.hpp>
+#include <org/eclipse/cyclonedds/core/Mutex.hpp>
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace domain
+{
+
+/*
+ * The handles of the endpoints that are matched with one reader or writer,
+ * against which the lookups of the DiscoveryCache are checked.
+ *
+ * The set is read from ddsc on the first lookup, and from then on kept up to
+ * date with the publication/subscription matched status, which ddsc raises
+ * once for every endpoint that is matched or unmatched: the last handle of
+ * the status is added when the current count went up and removed when it went
+ * down. Should the set and the count disagree, it is read from ddsc again.
+ *
+ * As long as the status does not reach the entity (it is not enabled yet),
+ * every lookup reads the set from ddsc.
+ */
+class OMG_DDS_API MatchedEndpoints
+{
+public:
+    typedef dds_return_t (*get_matched_fn)(dds_entity_t, dds_instance_handle_t *, size_t);
+
+    explicit MatchedEndpoints(get_matched_fn get_matched);
+
+    /* Whether the endpoint is matched with the entity. */
+    bool contains(dds_entity_t entity, dds_instance_handle_t handle, bool tracked);
+
+    /* Invoked with the matched status of the entity. */
+    void update(dds_entity_t entity, dds_instance_handle_t last_handle, uint32_t current_count);
+
+    void clear();
+
+private:
+    void resync(dds_entity_t entity);
+
+    get_matched_fn get_matched_;
+    org::eclipse::cyclonedds::core::Mutex mutex_;
+    bool valid_;
+    std::unordered_set<dds_instance_handle_t> handles_;
+};
+
+}
+}
+}
+}
+
+#endif /* CYCLONEDDS_DOMAIN_MATCHED_ENDPOINTS_HPP_ */
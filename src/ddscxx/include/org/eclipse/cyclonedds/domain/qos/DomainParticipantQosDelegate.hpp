@@ -19,6 +19,7 @@
 #define CYCLONEDDS_DOMAIN_QOS_DOMAIN_PARTICIPANT_QOS_DELEGATE_HPP_
 
 #include <dds/core/policy/CorePolicy.hpp>
+#include <org/eclipse/cyclonedds/core/DdscQosCache.hpp>
 
 struct _DDS_NamedDomainParticipantQos;
 
@@ -51,6 +52,10 @@ public:
     dds_qos_t* ddsc_qos() const;
     void ddsc_qos(const dds_qos_t* qos);
 
+    /* The returned ddsc QoS is shared and must not be freed. It is
+     * translated once and reused until this QoS is modified. */
+    org::eclipse::cyclonedds::core::DdscQosCache::qos_ref cached_ddsc_qos() const;
+
     void named_qos(const struct _DDS_NamedDomainParticipantQos &qos);
 
     void check() const;
@@ -61,6 +66,7 @@ public:
 private:
     dds::core::policy::UserData user_data_;
     dds::core::policy::EntityFactory entity_factory_;
+    org::eclipse::cyclonedds::core::DdscQosCache ddsc_qos_cache_;
 };
 
 
@@ -78,6 +84,7 @@ template<>
 inline dds::core::policy::UserData&
 DomainParticipantQosDelegate::policy<dds::core::policy::UserData> ()
 {
+    ddsc_qos_cache_.escape();
     return user_data_;
 }
 
@@ -92,6 +99,7 @@ template<>
 inline dds::core::policy::EntityFactory&
 DomainParticipantQosDelegate::policy<dds::core::policy::EntityFactory> ()
 {
+    ddsc_qos_cache_.escape();
     return entity_factory_;
 }
 
@@ -0,0 +1,138 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+
+
+/**
+ * @file
+ */
+
+#ifndef CYCLONEDDS_PUB_ACKNOWLEDGMENT_WAITER_HPP_
+#define CYCLONEDDS_PUB_ACKNOWLEDGMENT_WAITER_HPP_
+
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <dds/dds.h>
+#include <dds/core/macros.hpp>
+#include <dds/core/ref_traits.hpp>
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace pub
+{
+
+/*
+ * Waits for the acknowledgment of the samples written by a set of writers.
+ *
+ * The synchronous wait() blocks the calling thread in ddsc. The asynchronous
+ * wait_async() hands the request over to the waiter thread of a participant,
+ * so that applications do not need a thread of their own for every pending
+ * wait. As ddsc has no acknowledgment notification, that thread does not
+ * block in ddsc but polls the pending requests in the order of their
+ * deadlines. So every request completes on its own: within a poll interval of
+ * being acknowledged, or at its deadline otherwise.
+ *
+ * To keep the cost of polling down when many requests are pending, every
+ * request backs off on its own, from min_poll_interval to max_poll_interval,
+ * writers that have acknowledged everything are not checked again, and a
+ * round stops starting checks after max_checks_per_round writers, leaving
+ * the rest to the next one.
+ *
+ * The waiter is owned by the participant, which closes it when it is closed
+ * itself. Requests that are still pending then fail.
+ *
+ * The writers are referred to by their ddsc entity, so a writer that is deleted
+ * while a request is pending simply makes that request fail.
+ */
+class OMG_DDS_API AcknowledgmentWaiter :
+    public std::enable_shared_from_this<AcknowledgmentWaiter>
+{
+public:
+    typedef ::dds::core::smart_ptr_traits< AcknowledgmentWaiter >::ref_type ref_type;
+
+    /* Invoked with true when all samples have been acknowledged and with false
+     * when the timeout expired, a writer was deleted in the meantime or the
+     * waiter was closed. */
+    typedef std::function<void(bool)> callback_type;
+
+    /* How long pending requests wait for their first and (at most) for any
+     * next check. */
+    static const dds_duration_t min_poll_interval = DDS_MSECS(1);
+    static const dds_duration_t max_poll_interval = DDS_MSECS(32);
+
+    /* How many writers are checked in one round, about. */
+    static const size_t max_checks_per_round = 64;
+
+    AcknowledgmentWaiter();
+    ~AcknowledgmentWaiter();
+
+    AcknowledgmentWaiter(const AcknowledgmentWaiter&) = delete;
+    AcknowledgmentWaiter& operator=(const AcknowledgmentWaiter&) = delete;
+
+    static dds_return_t wait(const std::vector<dds_entity_t>& writers,
+                             dds_duration_t timeout);
+
+    void wait_async(const std::vector<dds_entity_t>& writers,
+                    dds_duration_t timeout,
+                    const callback_type& callback);
+
+    /* Fails the pending requests and stops the waiter thread. It may be
+     * called from a callback. */
+    void close();
+
+    /* The writers of a publisher, for the publisher level waits. */
+    static std::vector<dds_entity_t> writers_of(dds_entity_t publisher);
+
+private:
+    struct request {
+        std::vector<dds_entity_t> writers;
+        callback_type callback;
+        /* The writers before this one have acknowledged everything. */
+        size_t acked;
+        dds_time_t next_check;
+        dds_duration_t interval;
+    };
+
+    /* Pending requests, ordered by their deadlines. */
+    typedef std::multimap<dds_time_t, request> request_map;
+
+    static dds_return_t wait_until(const std::vector<dds_entity_t>& writers,
+                                   dds_time_t deadline);
+
+    /* Checks the writers that have not acknowledged everything yet, without
+     * waiting, and counts the checks against the budget of the round. */
+    static dds_return_t check(request& req, size_t& budget);
+
+    void run();
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    request_map incoming_;
+    bool closed_;
+    std::thread thread_;
+};
+
+}
+}
+}
+}
+
+#endif /* CYCLONEDDS_PUB_ACKNOWLEDGMENT_WAITER_HPP_ */
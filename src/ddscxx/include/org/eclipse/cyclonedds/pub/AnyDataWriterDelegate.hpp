@@ -29,6 +29,12 @@
 #include <dds/topic/BuiltinTopic.hpp>
 
 #include <org/eclipse/cyclonedds/topic/CDRBlob.hpp>
+#include <org/eclipse/cyclonedds/pub/KeyHashCache.hpp>
+#include <org/eclipse/cyclonedds/domain/MatchedEndpoints.hpp>
+
+#include <functional>
+
+struct ddsi_serdata;
 
 namespace dds { namespace pub {
 template <typename DELEGATE>
@@ -67,6 +73,13 @@ public:
 
     void wait_for_acknowledgments(const dds::core::Duration& timeout);
 
+    /* Does not block: the callback is invoked from the AcknowledgmentWaiter
+     * thread of the participant, with true when the samples have been
+     * acknowledged in time, and with false at the latest when the timeout
+     * expires or the participant is closed. */
+    void wait_for_acknowledgments_async(const dds::core::Duration& timeout,
+                                        const std::function<void(bool)>& callback);
+
     const ::dds::core::status::LivelinessLostStatus liveliness_lost_status();
 
     const ::dds::core::status::OfferedDeadlineMissedStatus offered_deadline_missed_status();
@@ -96,11 +109,20 @@ public:
 
     void assert_liveliness();
 
+    void on_matched(dds_entity_t writer, dds_instance_handle_t last_handle,
+                    uint32_t current_count);
+
 public:
     dds::pub::TAnyDataWriter<AnyDataWriterDelegate> wrapper_to_any();
     void write_flush();
     void set_batch(bool);
 
+    /* Maximum number of unregistered instances of which the keyhash is
+     * cached, see KeyHashCache. It is 0 by default, which makes writes
+     * calculate the keyhash instead of looking it up by the key. */
+    size_t keyhash_cache_capacity() const;
+    void keyhash_cache_capacity(size_t capacity);
+
 private:
     void
     write_cdr(dds_entity_t writer,
@@ -109,6 +131,36 @@ private:
           const dds::core::Time& timestamp,
           uint32_t statusinfo);
 
+    void
+    write_serdata(dds_entity_t writer,
+          ddsi_serdata *ser_data,
+          const dds::core::Time& timestamp,
+          uint32_t statusinfo);
+
+    /* While the publisher is suspended, writes are serialized and handed to
+     * the publisher, which sends them on resume. Writers that use shared
+     * memory are not suspended. */
+    bool deferring(dds_entity_t writer) const noexcept;
+
+    dds_return_t
+    defer(dds_entity_t writer,
+          ddsi_serdata *ser_data,
+          const dds::core::Time& timestamp,
+          uint32_t statusinfo) noexcept;
+
+    dds_return_t
+    defer(dds_entity_t writer,
+          const void *data,
+          ddsi_serdata_kind kind,
+          const dds::core::Time& timestamp,
+          uint32_t statusinfo) noexcept;
+
+    bool
+    defer(dds_entity_t writer,
+          const dds::core::InstanceHandle& handle,
+          const dds::core::Time& timestamp,
+          uint32_t statusinfo);
+
 protected:
     AnyDataWriterDelegate(const dds::pub::qos::DataWriterQos& qos,
                           const dds::topic::TopicDescription& td);
@@ -188,9 +240,51 @@ protected:
     lookup_instance(dds_entity_t writer,
                     const void *data);
 
+    /* Write and consume a serdata that was created by the typed writer. */
+    void
+    write_serdata(dds_entity_t writer,
+                  ddsi_serdata *ser_data,
+                  const dds::core::Time& timestamp);
+
+    /* Non-throwing counterparts of write() and write_serdata(), which return
+     * the ddsc result instead. */
+    dds_return_t
+    try_write(dds_entity_t writer,
+              const void *data,
+              const dds::core::Time& timestamp) noexcept;
+
+    dds_return_t
+    try_write_serdata(dds_entity_t writer,
+                      ddsi_serdata *ser_data,
+                      const dds::core::Time& timestamp,
+                      uint32_t statusinfo = 0) noexcept;
+
+    void
+    writedispose_serdata(dds_entity_t writer,
+                         ddsi_serdata *ser_data,
+                         const dds::core::Time& timestamp);
+
+    /* Looks up the cached keyhash of an instance that is registered by this
+     * writer. Returns false for a nil handle, and throws
+     * PreconditionNotMetError for a handle that is not (or no longer) that
+     * of an instance registered by this writer. */
+    bool
+    cached_instance(const dds::core::InstanceHandle& handle,
+                    org::eclipse::cyclonedds::pub::KeyHashCache::entry& e) const;
+
+    /* Like the above, but also throws PreconditionNotMetError when the
+     * serialized key is not that of the instance. */
+    bool
+    cached_instance(const dds::core::InstanceHandle& handle,
+                    const std::vector<unsigned char>& key,
+                    org::eclipse::cyclonedds::pub::KeyHashCache::entry& e) const;
+
+    org::eclipse::cyclonedds::pub::KeyHashCache keyhash_cache_;
+
 private:
     dds::pub::qos::DataWriterQos qos_;
     dds::topic::TopicDescription td_;
+    org::eclipse::cyclonedds::domain::MatchedEndpoints matched_;
 
     //@todo static bool copy_data(c_type t, void *data, void *to);
 };
@@ -0,0 +1,331 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+
+
+/**
+ * @file
+ */
+
+#ifndef CYCLONEDDS_PUB_CONFLATING_WRITER_HPP_
+#define CYCLONEDDS_PUB_CONFLATING_WRITER_HPP_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <dds/dds.h>
+#include <dds/core/Duration.hpp>
+#include <dds/core/Time.hpp>
+#include <dds/pub/DataWriter.hpp>
+#include <org/eclipse/cyclonedds/core/MiscUtils.hpp>
+#include <org/eclipse/cyclonedds/core/ReportUtils.hpp>
+#include <org/eclipse/cyclonedds/topic/datatopic.hpp>
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace pub
+{
+
+/*
+ * Limits the rate at which a DataWriter publishes each of its instances.
+ *
+ * An instance is published at most once per period. A write of an instance
+ * that was published less than a period ago is held back, and replaces the
+ * sample that was already held back for the instance, if any. Such a
+ * superseded sample is dropped before it is ever serialized. The sample that
+ * is held back last is published by the first poll() after the period has
+ * passed, so that readers always end up with the latest value.
+ *
+ * By default nothing is published in the background: the application calls
+ * poll() regularly, for instance at the time returned by next_deadline(), as
+ * otherwise the last sample of a burst is never sent. Alternatively, start()
+ * makes a thread of the writer publish the held back samples at their
+ * deadlines. The clock is only used for the periods, and can be replaced by a
+ * simulated one, which only makes sense without that thread. The samples are
+ * written with the normal source timestamp.
+ *
+ * The held back samples are kept in the order of their deadlines, so that
+ * poll(), next_deadline() and pending() only touch the samples that are due.
+ * An instance is forgotten once a period has passed without anything being
+ * held back for it.
+ *
+ * A ConflatingWriter is thread-safe.
+ */
+template <typename T>
+class ConflatingWriter
+{
+public:
+    typedef std::function<dds::core::Time()> clock_type;
+
+    ConflatingWriter(const dds::pub::DataWriter<T>& writer,
+                     const dds::core::Duration& period,
+                     const clock_type& clock = clock_type())
+        : writer_(writer), period_(period), clock_(clock), dropped_(0), stopping_(false)
+    {
+        ISOCPP_BOOL_CHECK_AND_THROW(period > dds::core::Duration::zero(), ISOCPP_INVALID_ARGUMENT_ERROR,
+                                    "A conflating writer needs a period of more than zero.");
+        if (!this->clock_) {
+            this->clock_ = []() { return org::eclipse::cyclonedds::core::convertTime(dds_time()); };
+        }
+    }
+
+    ~ConflatingWriter()
+    {
+        this->stop();
+    }
+
+    ConflatingWriter(const ConflatingWriter&) = delete;
+    ConflatingWriter& operator=(const ConflatingWriter&) = delete;
+
+    /* Starts publishing the held back samples in the background, so that
+     * poll() does not need to be called. */
+    void start()
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        if (!this->thread_.joinable()) {
+            this->stopping_ = false;
+            this->thread_ = std::thread([this]() { this->run(); });
+        }
+    }
+
+    /* Stops publishing in the background. The samples that are still held
+     * back stay so, until the next poll(), flush() or start(). */
+    void stop()
+    {
+        std::unique_lock<std::mutex> lock(this->mutex_);
+        std::thread thread;
+        thread.swap(this->thread_);
+        this->stopping_ = true;
+        lock.unlock();
+        this->cond_.notify_all();
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    /* Returns true when the sample was published right away, false when it
+     * is held back. */
+    bool write(const T& sample)
+    {
+        std::string key = this->key_of(sample);
+        dds::core::Time now = this->clock_();
+
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->expire(now);
+        typename instance_map::iterator it = this->instances_.find(key);
+        if (it == this->instances_.end()) {
+            this->writer_.write(sample);
+            it = this->instances_.emplace(key, instance()).first;
+            it->second.published = now;
+            it->second.position = this->idle_.emplace(now + this->period_, &it->first);
+            return true;
+        }
+
+        instance& i = it->second;
+        if (i.published + this->period_ <= now) {
+            this->writer_.write(sample);
+            if (i.pending) {
+                /* The period has passed without a poll(). */
+                this->pending_.erase(i.position);
+                i.pending = false;
+                this->dropped_++;
+            } else {
+                this->idle_.erase(i.position);
+            }
+            i.published = now;
+            i.position = this->idle_.emplace(now + this->period_, &it->first);
+            return true;
+        }
+
+        if (i.pending) {
+            this->dropped_++;
+        } else {
+            this->idle_.erase(i.position);
+            i.position = this->pending_.emplace(i.published + this->period_, &it->first);
+            i.pending = true;
+            if (this->thread_.joinable() && i.position == this->pending_.begin()) {
+                this->cond_.notify_one();
+            }
+        }
+        i.sample = sample;
+        return false;
+    }
+
+    /* Publishes the samples that are held back for instances of which the
+     * period has passed, and returns their number. */
+    size_t poll()
+    {
+        return this->publish(false);
+    }
+
+    /* Publishes all samples that are held back, regardless of the periods. */
+    size_t flush()
+    {
+        return this->publish(true);
+    }
+
+    /* The time at which poll() has a sample to publish, or Time::invalid()
+     * when no sample is held back. */
+    dds::core::Time next_deadline() const
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        if (this->pending_.empty()) {
+            return dds::core::Time::invalid();
+        }
+        return this->pending_.begin()->first;
+    }
+
+    /* The number of samples that are held back. */
+    size_t pending() const
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        return this->pending_.size();
+    }
+
+    /* The number of samples that were superseded and never published. */
+    uint64_t dropped() const
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        return this->dropped_;
+    }
+
+    const dds::pub::DataWriter<T>& writer() const
+    {
+        return this->writer_;
+    }
+
+private:
+    /* Instances by the end of their period, referring to their key in the
+     * instance map, which stays where it is until the instance is erased. */
+    typedef std::multimap<dds::core::Time, const std::string*> queue_type;
+
+    struct instance
+    {
+        instance() : pending(false) { }
+
+        dds::core::Time published;
+        bool pending;
+        T sample;
+        /* In pending_ when a sample is held back, in idle_ otherwise. */
+        typename queue_type::iterator position;
+    };
+
+    /* Instances are told apart by their serialized key. */
+    typedef std::unordered_map<std::string, instance> instance_map;
+
+    std::string key_of(const T& sample) const
+    {
+        org::eclipse::cyclonedds::core::cdr::big_endian_basic_cdr_stream str;
+        std::vector<unsigned char> key;
+        key_to_buffer(str, sample, key);
+        ISOCPP_BOOL_CHECK_AND_THROW(!str.abort_status(), ISOCPP_INVALID_ARGUMENT_ERROR,
+                                    "Could not serialize the key of the sample.");
+        return std::string(key.begin(), key.end());
+    }
+
+    size_t publish(bool all)
+    {
+        dds::core::Time now = this->clock_();
+
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        return this->publish(now, all);
+    }
+
+    /* Called with the mutex locked. */
+    size_t publish(const dds::core::Time& now, bool all)
+    {
+        size_t n = 0;
+
+        this->expire(now);
+        while (!this->pending_.empty() && (all || this->pending_.begin()->first <= now)) {
+            const std::string* key = this->pending_.begin()->second;
+            instance& i = this->instances_.find(*key)->second;
+            /* A sample that fails to be written is not held back anymore. */
+            this->pending_.erase(this->pending_.begin());
+            i.published = now;
+            i.pending = false;
+            i.position = this->idle_.emplace(now + this->period_, key);
+            this->writer_.write(i.sample);
+            n++;
+        }
+        return n;
+    }
+
+    /* The background thread, which sleeps until the earliest deadline. */
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(this->mutex_);
+        while (!this->stopping_) {
+            if (this->pending_.empty()) {
+                this->cond_.wait(lock);
+                continue;
+            }
+            dds::core::Time now = this->clock_();
+            dds_time_t deadline = org::eclipse::cyclonedds::core::convertTime(this->pending_.begin()->first);
+            dds_time_t current = org::eclipse::cyclonedds::core::convertTime(now);
+            if (deadline > current) {
+                this->cond_.wait_for(lock, std::chrono::nanoseconds(deadline - current));
+                continue;
+            }
+            try {
+                (void)this->publish(now, false);
+            } catch (...) {
+                /* Never let an exception end the thread. */
+            }
+        }
+    }
+
+    /* Forgets the instances of which the period has passed without anything
+     * being held back: their next sample is published right away anyway.
+     * This bounds the map by the active instances. */
+    void expire(const dds::core::Time& now)
+    {
+        while (!this->idle_.empty() && this->idle_.begin()->first <= now) {
+            typename instance_map::iterator it = this->instances_.find(*this->idle_.begin()->second);
+            this->idle_.erase(this->idle_.begin());
+            this->instances_.erase(it);
+        }
+    }
+
+    dds::pub::DataWriter<T> writer_;
+    dds::core::Duration period_;
+    clock_type clock_;
+
+    mutable std::mutex mutex_;
+    instance_map instances_;
+    queue_type pending_;
+    queue_type idle_;
+    uint64_t dropped_;
+
+    std::condition_variable cond_;
+    bool stopping_;
+    std::thread thread_;
+};
+
+}
+}
+}
+}
+
+#endif /* CYCLONEDDS_PUB_CONFLATING_WRITER_HPP_ */
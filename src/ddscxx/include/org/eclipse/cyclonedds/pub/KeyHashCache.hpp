@@ -0,0 +1,123 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+
+
+/**
+ * @file
+ */
+
+#ifndef CYCLONEDDS_PUB_KEY_HASH_CACHE_HPP_
+#define CYCLONEDDS_PUB_KEY_HASH_CACHE_HPP_
+
+#include <atomic>
+#include <list>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include <dds/dds.h>
+#include <dds/core/macros.hpp>
+#include "dds/ddsi/ddsi_keyhash.h"
+#include <org/eclipse/cyclonedds/core/Mutex.hpp>
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace pub
+{
+
+/*
+ * Cache of the instances of a writer.
+ *
+ * It maps the serialized key of an instance onto its keyhash, the serdata hash
+ * that is derived from that and, when known, its instance handle. This allows
+ * writes of known instances to skip the keyhash calculation (which involves
+ * MD5 hashing) and registrations of known instances to skip ddsc altogether.
+ * Writes that pass the instance handle of a registered instance do not even
+ * need the serialized key: the keyhash is found through the handle.
+ *
+ * The keyhash of a registered instance is only calculated when the instance
+ * is first written, so that registering many instances costs no more than
+ * the registration itself.
+ *
+ * Instances that are registered by the writer (i.e. that have a handle) stay
+ * in the cache until their handle is forgotten, which has to be done when the
+ * writer unregisters the instance. Other instances are only cached up to the
+ * capacity, least recently used first out. As looking up an instance by its
+ * serialized key only pays off if the key is MD5 hashed and the instance is
+ * likely to be in the cache, the capacity is 0 unless the application sizes
+ * it to the number of instances it writes.
+ */
+class OMG_DDS_API KeyHashCache
+{
+public:
+    static const size_t default_capacity = 0;
+
+    struct entry {
+        ddsi_keyhash_t keyhash;
+        bool key_md5_hashed;
+        uint32_t hash;
+        dds_instance_handle_t handle;
+        /* Whether the keyhash (and hash) have been calculated. */
+        bool keyhash_valid;
+    };
+
+    KeyHashCache(size_t capacity = default_capacity);
+    virtual ~KeyHashCache();
+
+    /* The capacity does not include the registered instances. It can be
+     * read without locking, so that writers can skip the cache when it is
+     * disabled. */
+    size_t capacity() const;
+    void capacity(size_t capacity);
+    size_t size() const;
+
+    bool lookup(const std::vector<unsigned char>& key, entry& e) const;
+    bool lookup(dds_instance_handle_t handle, entry& e) const;
+    /* Also tells whether the serialized key is that of the instance. */
+    bool lookup(dds_instance_handle_t handle, const std::vector<unsigned char>& key,
+                entry& e, bool& key_matches) const;
+    void insert(const std::vector<unsigned char>& key, const entry& e);
+    /* Stores the keyhash of a cached instance, leaving its handle as is. */
+    void update_keyhash(const std::vector<unsigned char>& key, const entry& e);
+
+    void forget_handle(dds_instance_handle_t handle);
+    void forget_handle(const std::vector<unsigned char>& key);
+
+    void clear();
+
+private:
+    typedef std::pair<std::string, entry> item;
+    typedef std::list<item> item_list;
+
+    void unregistered(item_list::iterator it);
+    void evict();
+
+    org::eclipse::cyclonedds::core::Mutex mutex_;
+    std::atomic<size_t> capacity_;
+    /* The items move between the lists by splicing, so that the iterators
+     * in the maps stay valid. */
+    item_list registered_;
+    mutable item_list lru_;
+    std::unordered_map<std::string, item_list::iterator> by_key_;
+    std::unordered_map<dds_instance_handle_t, item_list::iterator> by_handle_;
+};
+
+}
+}
+}
+}
+
+#endif /* CYCLONEDDS_PUB_KEY_HASH_CACHE_HPP_ */
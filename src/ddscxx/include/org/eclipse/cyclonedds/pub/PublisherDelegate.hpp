@@ -30,6 +30,10 @@
 #include <org/eclipse/cyclonedds/core/EntitySet.hpp>
 #include <org/eclipse/cyclonedds/pub/AnyDataWriterDelegate.hpp>
 
+#include <atomic>
+#include <mutex>
+#include <vector>
+
 
 namespace org
 {
@@ -63,14 +67,40 @@ public:
     void default_datawriter_qos(const dds::pub::qos::DataWriterQos& dwqos);
     dds::pub::qos::DataWriterQos default_datawriter_qos() const;
 
+    /* Suspensions nest: the writes of the writers of this publisher are held
+     * back until the outermost suspension is resumed. The backlog is only
+     * packed into fewer RTPS messages when batching is enabled, see
+     * AnyDataWriterDelegate::set_batch(); otherwise every write still goes out
+     * in a message of its own, just later. A write that finds the backlog
+     * full fails with OutOfResourcesError. */
     void suspend_publications();
     void resume_publications();
 
+    /* Maximum number of writes, disposes and unregisters that are held back
+     * while the publications are suspended. */
+    size_t suspended_capacity() const;
+    void suspended_capacity(size_t capacity);
+
+    /* Used by the writers of this publisher: while the publications are
+     * suspended, a write is handed to the publisher, which sends it on resume.
+     * Returns false when the publications are not suspended (anymore), in
+     * which case the writer sends it itself. A deferred serdata is consumed.
+     * Throws OutOfResourcesError when the backlog is full. */
+    bool suspended() const;
+    bool defer(dds_entity_t writer, ddsi_serdata *ser_data);
+    bool defer(dds_entity_t writer, dds_instance_handle_t handle,
+               dds_time_t timestamp, uint32_t statusinfo);
+
     void begin_coherent_changes();
     void end_coherent_changes();
 
     void wait_for_acknowledgments(const dds::core::Duration& max_wait);
 
+    /* Waits for the writers of this publisher without blocking, see
+     * AnyDataWriterDelegate::wait_for_acknowledgments_async(). */
+    void wait_for_acknowledgments_async(const dds::core::Duration& max_wait,
+                                        const std::function<void(bool)>& callback);
+
     void listener(dds::pub::PublisherListener* listener,
                   const ::dds::core::status::StatusMask& mask);
     dds::pub::PublisherListener* listener() const;
@@ -100,12 +130,33 @@ public:
     void on_publication_matched(dds_entity_t writer,
           org::eclipse::cyclonedds::core::PublicationMatchedStatusDelegate &sd);
 
+    org::eclipse::cyclonedds::core::EntityDelegate* listener_parent() const;
+
 private:
+    /* A write that is held back while the publications are suspended: either
+     * a serdata, or a dispose or unregister of an instance handle. */
+    struct deferred_write
+    {
+        dds_entity_t writer;
+        ddsi_serdata *ser_data;
+        dds_instance_handle_t handle;
+        dds_time_t timestamp;
+        uint32_t statusinfo;
+    };
+
+    dds_return_t send_deferred();
+    void discard_deferred(dds_entity_t writer);
+
     dds::domain::DomainParticipant dp_;
     dds::pub::qos::PublisherQos qos_;
     dds::pub::qos::DataWriterQos default_dwqos_;
 
     org::eclipse::cyclonedds::core::EntitySet writers;
+
+    mutable std::mutex deferred_mutex_;
+    std::atomic<uint32_t> suspend_depth_;
+    std::vector<deferred_write> deferred_;
+    size_t deferred_capacity_;
 };
 
 }
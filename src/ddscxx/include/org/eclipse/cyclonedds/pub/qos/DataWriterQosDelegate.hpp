@@ -20,6 +20,7 @@
 
 #include <dds/core/detail/conformance.hpp>
 #include <org/eclipse/cyclonedds/topic/qos/TopicQosDelegate.hpp>
+#include <org/eclipse/cyclonedds/core/DdscQosCache.hpp>
 
 struct _DDS_NamedDataWriterQos;
 
@@ -64,6 +65,10 @@ public:
     dds_qos_t* ddsc_qos() const;
     void ddsc_qos(const dds_qos_t* qos);
 
+    /* The returned ddsc QoS is shared and must not be freed. It is
+     * translated once and reused until this QoS is modified. */
+    org::eclipse::cyclonedds::core::DdscQosCache::qos_ref cached_ddsc_qos() const;
+
     void named_qos(const struct _DDS_NamedDataWriterQos &qos);
 
     void check() const;
@@ -88,6 +93,7 @@ private:
     dds::core::policy::OwnershipStrength       strength_;
 #endif  // OMG_DDS_OWNERSHIP_SUPPORT
     dds::core::policy::WriterDataLifecycle     lifecycle_;
+    org::eclipse::cyclonedds::core::DdscQosCache ddsc_qos_cache_;
 };
 
 
@@ -103,6 +109,7 @@ DataWriterQosDelegate::policy<dds::core::policy::UserData>() const
 template<> inline dds::core::policy::UserData&
 DataWriterQosDelegate::policy<dds::core::policy::UserData>()
 {
+    ddsc_qos_cache_.escape();
     return user_data_;
 }
 
@@ -115,6 +122,7 @@ DataWriterQosDelegate::policy<dds::core::policy::Durability>() const
 template<> inline dds::core::policy::Durability&
 DataWriterQosDelegate::policy<dds::core::policy::Durability>()
 {
+    ddsc_qos_cache_.escape();
     return durability_;
 }
 
@@ -127,6 +135,7 @@ DataWriterQosDelegate::policy<dds::core::policy::Deadline>() const
 template<> inline dds::core::policy::Deadline&
 DataWriterQosDelegate::policy<dds::core::policy::Deadline>()
 {
+    ddsc_qos_cache_.escape();
     return deadline_;
 }
 
@@ -139,6 +148,7 @@ DataWriterQosDelegate::policy<dds::core::policy::LatencyBudget>() const
 template<> inline dds::core::policy::LatencyBudget&
 DataWriterQosDelegate::policy<dds::core::policy::LatencyBudget>()
 {
+    ddsc_qos_cache_.escape();
     return budget_;
 }
 
@@ -151,6 +161,7 @@ DataWriterQosDelegate::policy<dds::core::policy::Liveliness>() const
 template<> inline dds::core::policy::Liveliness&
 DataWriterQosDelegate::policy<dds::core::policy::Liveliness>()
 {
+    ddsc_qos_cache_.escape();
     return liveliness_;
 }
 
@@ -163,6 +174,7 @@ DataWriterQosDelegate::policy<dds::core::policy::Reliability>() const
 template<> inline dds::core::policy::Reliability&
 DataWriterQosDelegate::policy<dds::core::policy::Reliability>()
 {
+    ddsc_qos_cache_.escape();
     return reliability_;
 }
 
@@ -175,6 +187,7 @@ DataWriterQosDelegate::policy<dds::core::policy::DestinationOrder>() const
 template<> inline dds::core::policy::DestinationOrder&
 DataWriterQosDelegate::policy<dds::core::policy::DestinationOrder>()
 {
+    ddsc_qos_cache_.escape();
     return order_;
 }
 
@@ -187,6 +200,7 @@ DataWriterQosDelegate::policy<dds::core::policy::History>() const
 template<> inline dds::core::policy::History&
 DataWriterQosDelegate::policy<dds::core::policy::History>()
 {
+    ddsc_qos_cache_.escape();
     return history_;
 }
 
@@ -199,6 +213,7 @@ DataWriterQosDelegate::policy<dds::core::policy::ResourceLimits>() const
 template<> inline dds::core::policy::ResourceLimits&
 DataWriterQosDelegate::policy<dds::core::policy::ResourceLimits>()
 {
+    ddsc_qos_cache_.escape();
     return resources_;
 }
 
@@ -211,6 +226,7 @@ DataWriterQosDelegate::policy<dds::core::policy::TransportPriority>() const
 template<> inline dds::core::policy::TransportPriority&
 DataWriterQosDelegate::policy<dds::core::policy::TransportPriority>()
 {
+    ddsc_qos_cache_.escape();
     return priority_;
 }
 
@@ -223,6 +239,7 @@ DataWriterQosDelegate::policy<dds::core::policy::Lifespan>() const
 template<> inline dds::core::policy::Lifespan&
 DataWriterQosDelegate::policy<dds::core::policy::Lifespan>()
 {
+    ddsc_qos_cache_.escape();
     return lifespan_;
 }
 
@@ -235,6 +252,7 @@ DataWriterQosDelegate::policy<dds::core::policy::Ownership>() const
 template<> inline dds::core::policy::Ownership&
 DataWriterQosDelegate::policy<dds::core::policy::Ownership>()
 {
+    ddsc_qos_cache_.escape();
     return ownership_;
 }
 
@@ -248,6 +266,7 @@ DataWriterQosDelegate::policy<dds::core::policy::OwnershipStrength>() const
 template<> inline dds::core::policy::OwnershipStrength&
 DataWriterQosDelegate::policy<dds::core::policy::OwnershipStrength>()
 {
+    ddsc_qos_cache_.escape();
     return strength_;
 }
 #endif  // OMG_DDS_OWNERSHIP_SUPPORT
@@ -261,6 +280,7 @@ DataWriterQosDelegate::policy<dds::core::policy::WriterDataLifecycle>() const
 template<> inline dds::core::policy::WriterDataLifecycle&
 DataWriterQosDelegate::policy<dds::core::policy::WriterDataLifecycle>()
 {
+    ddsc_qos_cache_.escape();
     return lifecycle_;
 }
 
@@ -32,6 +32,7 @@
 #include <org/eclipse/cyclonedds/ForwardDeclarations.hpp>
 #include <dds/topic/TopicDescription.hpp>
 #include <org/eclipse/cyclonedds/topic/CDRBlob.hpp>
+#include <org/eclipse/cyclonedds/domain/MatchedEndpoints.hpp>
 
 #include <dds/topic/BuiltinTopic.hpp>
 
@@ -153,6 +154,9 @@ public:
     const dds::topic::PublicationBuiltinTopicData
     matched_publication_data(const ::dds::core::InstanceHandle& h);
 
+    void on_matched(dds_entity_t reader, dds_instance_handle_t last_handle,
+                    uint32_t current_count);
+
 public:
     /* Internal API. */
     dds::sub::TAnyDataReader<AnyDataReaderDelegate> wrapper_to_any();
@@ -193,6 +197,14 @@ public:
             dds::sub::detail::SamplesHolder& samples,
             uint32_t max_samples);
 
+    /* Non-throwing counterpart of loaned_take(), which returns the number of
+     * samples taken or the ddsc error. */
+    dds_return_t try_loaned_take(
+            const dds_entity_t reader,
+            const dds::sub::status::DataState& mask,
+            dds::sub::detail::SamplesHolder& samples,
+            uint32_t max_samples) noexcept;
+
     void loaned_read_instance(
             const dds_entity_t reader,
             const dds::core::InstanceHandle& handle,
@@ -292,6 +304,8 @@ protected:
 
     void *sample_;
 
+private:
+    org::eclipse::cyclonedds::domain::MatchedEndpoints matched_;
 };
 
 
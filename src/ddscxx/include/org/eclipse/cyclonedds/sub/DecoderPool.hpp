@@ -0,0 +1,83 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+
+
+/**
+ * @file
+ */
+
+#ifndef CYCLONEDDS_SUB_DECODER_POOL_HPP_
+#define CYCLONEDDS_SUB_DECODER_POOL_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <dds/core/macros.hpp>
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace sub
+{
+
+/*
+ * Pool of threads that a DataReader uses to deserialize the samples of a
+ * large take in parallel, see DataReader::take(DecoderPool&).
+ *
+ * Samples are normally deserialized one at a time, when the application first
+ * accesses their data. As the samples of a batch are independent of each
+ * other, a batch of large samples (images, point clouds) can instead be
+ * deserialized by all threads of the pool before the take returns.
+ *
+ * The thread that calls for_each takes part in the work, so a pool of n
+ * threads starts n - 1 worker threads. A pool can be shared by readers: calls
+ * of for_each are served one at a time.
+ */
+class OMG_DDS_API DecoderPool
+{
+public:
+    /* A thread count of 0 selects the number of hardware threads. */
+    explicit DecoderPool(uint32_t threads = 0);
+    ~DecoderPool();
+
+    DecoderPool(const DecoderPool&) = delete;
+    DecoderPool& operator=(const DecoderPool&) = delete;
+
+    /* Invokes func for every index in [0, count) and returns when all have
+     * been done. The first exception raised by func stops the remaining work
+     * and is rethrown once the workers are done. */
+    void for_each(size_t count, const std::function<void(size_t)>& func);
+
+    uint32_t threads() const;
+
+private:
+    struct state;
+
+    std::mutex call_mutex_;
+    std::shared_ptr<state> state_;
+    std::vector<std::thread> threads_;
+};
+
+}
+}
+}
+}
+
+#endif /* CYCLONEDDS_SUB_DECODER_POOL_HPP_ */
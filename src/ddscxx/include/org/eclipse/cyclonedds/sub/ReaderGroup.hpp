@@ -0,0 +1,155 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+
+
+/**
+ * @file
+ */
+
+#ifndef CYCLONEDDS_SUB_READER_GROUP_HPP_
+#define CYCLONEDDS_SUB_READER_GROUP_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <dds/sub/DataReader.hpp>
+#include <dds/sub/detail/SamplesHolder.hpp>
+#include <org/eclipse/cyclonedds/sub/SamplePool.hpp>
+#include <org/eclipse/cyclonedds/core/ReportUtils.hpp>
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace sub
+{
+
+/*
+ * Takes from a set of DataReaders, possibly of different types, in one call.
+ *
+ * Every reader of the group gets a read condition, with the default filter
+ * state of the reader at the time it was added, and all these conditions are
+ * attached to a waitset of the group. A take first asks the waitset which of
+ * the conditions are triggered, and then only takes from the readers that
+ * have data, so the cost of a take grows with the number of readers with
+ * data rather than with the size of the group.
+ *
+ * The samples are taken into a SamplePool per reader, which is allocated once
+ * when the reader is added. The result of a take lists the readers that
+ * samples were taken from; the samples themselves stay in the pool of the
+ * reader until the next take. A reader that has more samples than fit in its
+ * pool is served again by the next take.
+ *
+ * A ReaderGroup keeps its readers alive. It is not thread-safe.
+ */
+class OMG_DDS_API ReaderGroup
+{
+public:
+    /* Identifies a reader of the group, by the order in which it was added. */
+    typedef size_t tag_type;
+
+    struct batch
+    {
+        tag_type reader;
+        uint32_t length;
+    };
+
+    /* Reused from one take to the next, so that it does not reallocate. */
+    typedef std::vector<batch> result_type;
+
+    ReaderGroup();
+    ~ReaderGroup();
+
+    ReaderGroup(const ReaderGroup&) = delete;
+    ReaderGroup& operator=(const ReaderGroup&) = delete;
+
+    template <typename T>
+    tag_type add(const dds::sub::DataReader<T>& reader, uint32_t capacity = 64)
+    {
+        std::unique_ptr<member> m(new typed_member<T>(reader, capacity));
+        return this->attach(std::move(m), reader.delegate()->get_ddsc_entity(),
+                            reader.delegate()->default_filter_state());
+    }
+
+    /* Takes from all readers with data and returns the number of them, which
+     * is also the number of batches in the result. */
+    size_t take(result_type& result);
+
+    /* The samples taken from a reader by the last take. */
+    template <typename T>
+    const SamplePool<T>& samples(tag_type reader) const
+    {
+        const typed_member<T> *m = (reader < this->members_.size()) ?
+            dynamic_cast<const typed_member<T> *>(this->members_[reader].get()) : NULL;
+        ISOCPP_BOOL_CHECK_AND_THROW(m != NULL, ISOCPP_INVALID_ARGUMENT_ERROR,
+                                    "The ReaderGroup has no DataReader of this type with this tag.");
+        return m->pool;
+    }
+
+    size_t size() const;
+
+private:
+    class member
+    {
+    public:
+        member() : condition(0) { }
+
+        virtual ~member()
+        {
+            /* Fails harmlessly when the reader, and with it the condition, is gone. */
+            if (this->condition > 0) {
+                (void) dds_delete(this->condition);
+            }
+        }
+
+        virtual uint32_t take() = 0;
+
+        dds_entity_t condition;
+        dds::sub::status::DataState state;
+    };
+
+    template <typename T>
+    class typed_member : public member
+    {
+    public:
+        typed_member(const dds::sub::DataReader<T>& r, uint32_t capacity)
+            : reader(r), pool(capacity) { }
+
+        uint32_t take()
+        {
+            dds::sub::detail::SamplePoolHolder<T> holder(this->pool);
+            /* A condition can stand in for its reader. */
+            this->reader.delegate()->AnyDataReaderDelegate::take(this->condition, this->state, holder, this->pool.capacity());
+            return holder.get_length();
+        }
+
+        dds::sub::DataReader<T> reader;
+        SamplePool<T> pool;
+    };
+
+    tag_type attach(std::unique_ptr<member>&& m, dds_entity_t reader, const dds::sub::status::DataState& state);
+
+    dds_entity_t waitset_;
+    std::vector< std::unique_ptr<member> > members_;
+    std::vector<dds_attach_t> triggered_;
+};
+
+}
+}
+}
+}
+
+#endif /* CYCLONEDDS_SUB_READER_GROUP_HPP_ */
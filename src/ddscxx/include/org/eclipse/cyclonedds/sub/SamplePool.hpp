@@ -0,0 +1,131 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+
+
+/**
+ * @file
+ */
+
+#ifndef CYCLONEDDS_SUB_SAMPLE_POOL_HPP_
+#define CYCLONEDDS_SUB_SAMPLE_POOL_HPP_
+
+#include <vector>
+
+#include <dds/dds.h>
+#include <dds/sub/Sample.hpp>
+#include <org/eclipse/cyclonedds/core/ReportUtils.hpp>
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace sub
+{
+
+/*
+ * A fixed set of long-lived samples that a DataReader deserializes into.
+ *
+ * Reading or taking into a pool (reader->read(pool), reader->take(pool))
+ * overwrites the samples of the pool in place. The sequences and strings of a
+ * sample keep their capacity from one read to the next, and the buffers that
+ * are handed to ddsc are allocated once, together with the pool. So, once the
+ * samples have grown to the size of the received data, reading does not
+ * allocate anymore.
+ *
+ * Only the first length() samples are valid after a read or take. The fields
+ * of a sample without valid data (see SampleInfo::valid()) that are not part
+ * of the key are left as they were.
+ */
+template <typename T>
+class SamplePool
+{
+public:
+    typedef dds::sub::Sample<T, dds::sub::detail::Sample> sample_type;
+    typedef typename std::vector<sample_type>::const_iterator const_iterator;
+
+    explicit SamplePool(uint32_t capacity)
+        : samples_(capacity), pointers_(capacity), infos_(capacity), length_(0)
+    {
+        ISOCPP_BOOL_CHECK_AND_THROW(capacity > 0, ISOCPP_INVALID_ARGUMENT_ERROR,
+                                    "A sample pool needs a capacity of at least one sample.");
+        for (uint32_t i = 0; i < capacity; i++) {
+            this->pointers_[i] = this->samples_[i].delegate().data_ptr();
+        }
+    }
+
+    /* The ddsc buffers point into the pool itself. */
+    SamplePool(const SamplePool&) = delete;
+    SamplePool& operator=(const SamplePool&) = delete;
+    SamplePool(SamplePool&&) = default;
+    SamplePool& operator=(SamplePool&&) = default;
+
+    uint32_t capacity() const
+    {
+        return static_cast<uint32_t>(this->samples_.size());
+    }
+
+    uint32_t length() const
+    {
+        return this->length_;
+    }
+
+    const sample_type& operator[](uint32_t i) const
+    {
+        return this->samples_[i];
+    }
+
+    sample_type& operator[](uint32_t i)
+    {
+        return this->samples_[i];
+    }
+
+    const_iterator begin() const
+    {
+        return this->samples_.begin();
+    }
+
+    const_iterator end() const
+    {
+        return this->samples_.begin() + this->length_;
+    }
+
+    /* For use by the DataReader. */
+    void length(uint32_t length)
+    {
+        this->length_ = length;
+    }
+
+    void **sample_pointers()
+    {
+        return this->pointers_.data();
+    }
+
+    dds_sample_info_t *sample_infos()
+    {
+        return this->infos_.data();
+    }
+
+private:
+    std::vector<sample_type> samples_;
+    std::vector<void *> pointers_;
+    std::vector<dds_sample_info_t> infos_;
+    uint32_t length_;
+};
+
+}
+}
+}
+}
+
+#endif /* CYCLONEDDS_SUB_SAMPLE_POOL_HPP_ */
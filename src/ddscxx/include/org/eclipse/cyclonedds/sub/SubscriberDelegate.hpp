@@ -133,10 +133,13 @@ public:
             dds_entity_t reader,
             org::eclipse::cyclonedds::core::SampleLostStatusDelegate &sd);
 
+    org::eclipse::cyclonedds::core::EntityDelegate* listener_parent() const;
+
 private:
     dds::domain::DomainParticipant dp_;
     dds::sub::qos::SubscriberQos qos_;
     dds::sub::qos::DataReaderQos default_dr_qos_;
+    uint32_t coherent_access_depth_;
 
     org::eclipse::cyclonedds::core::EntitySet readers;
 };
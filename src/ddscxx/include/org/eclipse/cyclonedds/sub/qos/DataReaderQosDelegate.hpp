@@ -20,6 +20,7 @@
 
 #include <dds/core/detail/conformance.hpp>
 #include <org/eclipse/cyclonedds/topic/qos/TopicQosDelegate.hpp>
+#include <org/eclipse/cyclonedds/core/DdscQosCache.hpp>
 
 struct _DDS_NamedDataReaderQos;
 
@@ -60,6 +61,10 @@ public:
     dds_qos_t* ddsc_qos() const;
     void ddsc_qos(const dds_qos_t* qos);
 
+    /* The returned ddsc QoS is shared and must not be freed. It is
+     * translated once and reused until this QoS is modified. */
+    org::eclipse::cyclonedds::core::DdscQosCache::qos_ref cached_ddsc_qos() const;
+
     void named_qos(const struct _DDS_NamedDataReaderQos &qos);
 
     void check() const;
@@ -80,6 +85,7 @@ private:
     dds::core::policy::Ownership               ownership_;
     dds::core::policy::TimeBasedFilter         tfilter_;
     dds::core::policy::ReaderDataLifecycle     lifecycle_;
+    org::eclipse::cyclonedds::core::DdscQosCache ddsc_qos_cache_;
 };
 
 
@@ -97,6 +103,7 @@ template<>
 inline dds::core::policy::Durability&
 DataReaderQosDelegate::policy<dds::core::policy::Durability>()
 {
+    ddsc_qos_cache_.escape();
     return durability_;
 }
 
@@ -111,6 +118,7 @@ template<>
 inline dds::core::policy::UserData&
 DataReaderQosDelegate::policy<dds::core::policy::UserData>()
 {
+    ddsc_qos_cache_.escape();
     return user_data_;
 }
 
@@ -124,6 +132,7 @@ template<>
 inline dds::core::policy::Deadline&
 DataReaderQosDelegate::policy<dds::core::policy::Deadline>()
 {
+    ddsc_qos_cache_.escape();
     return deadline_;
 }
 
@@ -137,6 +146,7 @@ template<>
 inline dds::core::policy::LatencyBudget&
 DataReaderQosDelegate::policy<dds::core::policy::LatencyBudget>()
 {
+    ddsc_qos_cache_.escape();
     return budget_;
 }
 
@@ -150,6 +160,7 @@ template<>
 inline dds::core::policy::Liveliness&
 DataReaderQosDelegate::policy<dds::core::policy::Liveliness>()
 {
+    ddsc_qos_cache_.escape();
     return liveliness_;
 }
 
@@ -163,6 +174,7 @@ template<>
 inline dds::core::policy::Reliability&
 DataReaderQosDelegate::policy<dds::core::policy::Reliability>()
 {
+    ddsc_qos_cache_.escape();
     return reliability_;
 }
 
@@ -176,6 +188,7 @@ template<>
 inline dds::core::policy::DestinationOrder&
 DataReaderQosDelegate::policy<dds::core::policy::DestinationOrder>()
 {
+    ddsc_qos_cache_.escape();
     return order_;
 }
 
@@ -189,6 +202,7 @@ template<>
 inline dds::core::policy::History&
 DataReaderQosDelegate::policy<dds::core::policy::History>()
 {
+    ddsc_qos_cache_.escape();
     return history_;
 }
 
@@ -202,6 +216,7 @@ template<>
 inline dds::core::policy::ResourceLimits&
 DataReaderQosDelegate::policy<dds::core::policy::ResourceLimits>()
 {
+    ddsc_qos_cache_.escape();
     return resources_;
 }
 
@@ -215,6 +230,7 @@ template<>
 inline dds::core::policy::Ownership&
 DataReaderQosDelegate::policy<dds::core::policy::Ownership>()
 {
+    ddsc_qos_cache_.escape();
     return ownership_;
 }
 
@@ -228,6 +244,7 @@ template<>
 inline dds::core::policy::TimeBasedFilter&
 DataReaderQosDelegate::policy<dds::core::policy::TimeBasedFilter>()
 {
+    ddsc_qos_cache_.escape();
     return tfilter_;
 }
 
@@ -241,6 +258,7 @@ template<>
 inline dds::core::policy::ReaderDataLifecycle&
 DataReaderQosDelegate::policy<dds::core::policy::ReaderDataLifecycle>()
 {
+    ddsc_qos_cache_.escape();
     return lifecycle_;
 }
 
@@ -19,6 +19,7 @@
 #define CYCLONEDDS_SUB_QOS_SUBSCRIBER_QOS_DELEGATE_HPP_
 
 #include <dds/core/policy/CorePolicy.hpp>
+#include <org/eclipse/cyclonedds/core/DdscQosCache.hpp>
 
 struct _DDS_NamedSubscriberQos;
 
@@ -53,6 +54,10 @@ public:
     dds_qos_t* ddsc_qos() const;
     void ddsc_qos(const dds_qos_t* qos);
 
+    /* The returned ddsc QoS is shared and must not be freed. It is
+     * translated once and reused until this QoS is modified. */
+    org::eclipse::cyclonedds::core::DdscQosCache::qos_ref cached_ddsc_qos() const;
+
     void named_qos(const struct _DDS_NamedSubscriberQos &qos);
 
     void check() const;
@@ -65,6 +70,7 @@ private:
     dds::core::policy::Partition partition_;
     dds::core::policy::GroupData group_data_;
     dds::core::policy::EntityFactory entity_factory_;
+    org::eclipse::cyclonedds::core::DdscQosCache ddsc_qos_cache_;
 };
 
 
@@ -82,6 +88,7 @@ template<>
 inline dds::core::policy::Presentation&
 SubscriberQosDelegate::policy<dds::core::policy::Presentation>()
 {
+    ddsc_qos_cache_.escape();
     return presentation_;
 }
 
@@ -96,6 +103,7 @@ template<>
 inline dds::core::policy::Partition&
 SubscriberQosDelegate::policy<dds::core::policy::Partition>()
 {
+    ddsc_qos_cache_.escape();
     return partition_;
 }
 
@@ -110,6 +118,7 @@ template<>
 inline dds::core::policy::GroupData&
 SubscriberQosDelegate::policy<dds::core::policy::GroupData>()
 {
+    ddsc_qos_cache_.escape();
     return group_data_;
 }
 
@@ -124,6 +133,7 @@ template<>
 inline dds::core::policy::EntityFactory&
 SubscriberQosDelegate::policy<dds::core::policy::EntityFactory>()
 {
+    ddsc_qos_cache_.escape();
     return entity_factory_;
 }
 
@@ -14,6 +14,39 @@
 #ifndef CYCLONEDDS_TOPIC_BUILTIN_TOPIC_COPY_HPP_
 #define CYCLONEDDS_TOPIC_BUILTIN_TOPIC_COPY_HPP_
 
-/* TODO: add builtin topic copyin copyout function declarations. */
+#include <dds/topic/BuiltinTopic.hpp>
+
+#include "dds/dds.h"
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace topic
+{
+
+/*
+ * Copy the ddsc builtin topic samples into their C++ representation.
+ *
+ * The ddsc GUID is 16 bytes wide, while the BuiltinTopicKey only has room for
+ * three 32-bit words. The key is therefore filled with the last 12 bytes of the
+ * GUID (the participant specific part of the prefix and the entity id). Use the
+ * instance handle of the sample when an exact identity is needed.
+ */
+OMG_DDS_API void
+copyOut(const dds_builtintopic_participant_t &from, dds::topic::ParticipantBuiltinTopicData &to);
+
+OMG_DDS_API void
+copyOut(const dds_builtintopic_endpoint_t &from, dds::topic::PublicationBuiltinTopicData &to);
+
+OMG_DDS_API void
+copyOut(const dds_builtintopic_endpoint_t &from, dds::topic::SubscriptionBuiltinTopicData &to);
+
+}
+}
+}
+}
 
 #endif /* CYCLONEDDS_TOPIC_BUILTIN_TOPIC_COPY_HPP_ */
@@ -18,6 +18,8 @@
 #ifndef CYCLONEDDS_TOPIC_TOPICTRAITS_HPP_
 #define CYCLONEDDS_TOPIC_TOPICTRAITS_HPP_
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 #include "org/eclipse/cyclonedds/topic/DataRepresentation.hpp"
@@ -80,6 +82,29 @@ public:
     {
       return true;
     }
+
+    /* The traits below are evaluated at compile time. The defaults make no
+     * assumptions about the serialized form of the type, so that the sizes
+     * are determined at runtime. */
+    static constexpr bool isFixedSize()
+    {
+      return false;
+    }
+
+    static constexpr size_t getMaxSerializedSize()
+    {
+      return SIZE_MAX;
+    }
+
+    static constexpr size_t getKeyMaxSize()
+    {
+      return SIZE_MAX;
+    }
+
+    static constexpr bool isKeySimple()
+    {
+      return false;
+    }
 };
 
 }
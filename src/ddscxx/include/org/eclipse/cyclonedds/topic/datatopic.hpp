@@ -21,58 +21,135 @@
 
 #include "dds/ddsrt/endian.h"
 #include "dds/ddsrt/md5.h"
+#include "dds/ddsrt/mh3.h"
 #include "dds/ddsi/q_radmin.h"
 #include "dds/ddsi/q_xmsg.h"
 #include "dds/ddsi/ddsi_serdata.h"
 #include "org/eclipse/cyclonedds/core/cdr/basic_cdr_ser.hpp"
 #include "dds/ddsi/ddsi_keyhash.h"
 #include "org/eclipse/cyclonedds/topic/hash.hpp"
+#include "org/eclipse/cyclonedds/topic/TopicTraits.hpp"
 #include "dds/features.hpp"
 
 #ifdef DDSCXX_HAS_SHM
 #include "dds/ddsi/ddsi_shm_transport.h"
 #endif
 
+#ifdef DDSCXX_HAS_PMR
+#include <algorithm>
+#include <memory_resource>
+#include <type_traits>
+#endif
+
 constexpr size_t CDR_HEADER_SIZE = 4U;
 
 using org::eclipse::cyclonedds::core::cdr::endianness;
 using org::eclipse::cyclonedds::core::cdr::native_endianness;
 using org::eclipse::cyclonedds::core::cdr::swap_necessary;
 using org::eclipse::cyclonedds::core::cdr::basic_cdr_stream;
-
+using org::eclipse::cyclonedds::core::cdr::big_endian_basic_cdr_stream;
+
+/// \brief Serialize the key fields of a sample into a buffer padded to a multiple of 16 bytes
+///
+/// The key is serialized in big-endian byte order, as ddsi expects of the
+/// keyhash that is derived from it.
+/// \param[in] str The stream used for the serialization, a big_endian_basic_cdr_stream
+/// \param[in] tokey The sample of which the key is serialized
+/// \param[out] buffer The serialized key
 template<class streamer, typename T>
-bool to_key(streamer& str, const T& tokey, ddsi_keyhash_t& hash)
+void key_to_buffer(streamer& str, const T& tokey, std::vector<unsigned char>& buffer)
 {
+  static_assert(std::is_same<streamer, big_endian_basic_cdr_stream>::value,
+                "keys are serialized in big-endian byte order");
   str.reset_position();
   key_move(str, tokey);
   size_t sz = str.position();
   size_t padding = 16 - sz % 16;
   if (sz != 0 && padding == 16) padding = 0;
-  std::vector<unsigned char> buffer(sz + padding);
+  buffer.resize(sz + padding);
   memset(buffer.data() + sz, 0x0, padding);
   str.set_buffer(buffer.data());
-  /* TODO: what is key endianness to be used here?
-   * since, this may be different between nodes, and if this value is used
-   * for global lookups or the like, this
-   * may cause discrepancies. */
   key_write(str, tokey);
-  static bool (*fptr)(const std::vector<unsigned char>&, ddsi_keyhash_t&) = NULL;
-  if (fptr == NULL)
+}
+
+/// \brief Calculate the keyhash from a key serialized by key_to_buffer
+/// \return True if the keyhash is the MD5 hash of the key
+///         False if the key fits in the keyhash and is copied
+template<class streamer, typename T>
+bool keyhash_from_buffer(streamer& str, const T& tokey, const std::vector<unsigned char>& buffer, ddsi_keyhash_t& hash)
+{
+  if constexpr (org::eclipse::cyclonedds::topic::TopicTraits<T>::getKeyMaxSize() != SIZE_MAX)
   {
-    str.set_buffer(nullptr);
-    key_max(str, tokey);
-    if (str.position() <= 16)
-    {
-      //bind to unmodified function which just copies buffer into the keyhash
-      fptr = &org::eclipse::cyclonedds::topic::simple_key;
-    }
+    //the maximum key size is known at compile time
+    (void)str;
+    (void)tokey;
+    if constexpr (org::eclipse::cyclonedds::topic::TopicTraits<T>::isKeySimple())
+      return org::eclipse::cyclonedds::topic::simple_key(buffer, hash);
     else
+      return org::eclipse::cyclonedds::topic::complex_key(buffer, hash);
+  }
+  else
+  {
+    static bool (*fptr)(const std::vector<unsigned char>&, ddsi_keyhash_t&) = NULL;
+    if (fptr == NULL)
     {
-      //bind to MD5 hash function
-      fptr = &org::eclipse::cyclonedds::topic::complex_key;
+      str.set_buffer(nullptr);
+      key_max(str, tokey);
+      if (str.position() <= 16)
+      {
+        //bind to unmodified function which just copies buffer into the keyhash
+        fptr = &org::eclipse::cyclonedds::topic::simple_key;
+      }
+      else
+      {
+        //bind to MD5 hash function
+        fptr = &org::eclipse::cyclonedds::topic::complex_key;
+      }
     }
+    return (*fptr)(buffer, hash);
+  }
+}
+
+template<class streamer, typename T>
+bool to_key(streamer& str, const T& tokey, ddsi_keyhash_t& hash)
+{
+  static_assert(std::is_same<streamer, big_endian_basic_cdr_stream>::value,
+                "keys are serialized in big-endian byte order");
+  if constexpr (org::eclipse::cyclonedds::topic::TopicTraits<T>::isKeySimple())
+  {
+    //the key always fits in the keyhash, so no buffer needs to be sized
+    alignas(8) unsigned char buffer[sizeof(hash.value)] = { 0 };
+    str.set_buffer(buffer);
+    key_write(str, tokey);
+    memcpy(hash.value, buffer, sizeof(hash.value));
+    return false;
+  }
+  else
+  {
+    std::vector<unsigned char> buffer;
+    key_to_buffer(str, tokey, buffer);
+    return keyhash_from_buffer(str, tokey, buffer, hash);
+  }
+}
+
+/// \brief Calculate the 32-bit serdata hash that belongs to a keyhash
+inline uint32_t keyhash_to_hash(const ddsi_keyhash_t& key, bool key_md5_hashed)
+{
+  uint32_t hash;
+  if (!key_md5_hashed)
+  {
+    ddsi_keyhash_t buf;
+    ddsrt_md5_state_t md5st;
+    ddsrt_md5_init(&md5st);
+    ddsrt_md5_append(&md5st, static_cast<const ddsrt_md5_byte_t*>(key.value), 16);
+    ddsrt_md5_finish(&md5st, static_cast<ddsrt_md5_byte_t*>(buf.value));
+    memcpy(&hash, buf.value, 4);
   }
-  return (*fptr)(buffer, hash);
+  else
+  {
+    memcpy(&hash, key.value, 4);
+  }
+  return hash;
 }
 
 static inline void* calc_offset(void* ptr, ptrdiff_t n)
@@ -86,36 +163,25 @@ static inline const void* calc_offset(const void* ptr, ptrdiff_t n)
 }
 
 /// \brief De-serialize the buffer into the sample
+/// \param[in] str The stream to de-serialize from, its type determines whether bytes are swapped
 /// \param[in] buffer The buffer to be de-serialized
 /// \param[out] sample Type to which the buffer will be de-serialized
 /// \param[in] data_kind The data kind (data, or key)
-/// \tparam T The sample type
 /// \return True if the deserialization is successful
 ///         False if the deserialization failed
-template <typename T>
-bool deserialize_sample_from_buffer(unsigned char * buffer,
+template <typename S, typename T>
+bool deserialize_sample_from_stream(S& str,
+                                    unsigned char * buffer,
                                     T & sample,
-                                    const ddsi_serdata_kind data_kind=SDK_DATA)
+                                    const ddsi_serdata_kind data_kind)
 {
-  endianness stream_endianness = endianness::big_endian;
-  if (*(buffer + 1) == 0x1) {
-    stream_endianness = endianness::little_endian;
-  }
-
-  org::eclipse::cyclonedds::core::cdr::basic_cdr_stream str;
   str.set_buffer(calc_offset(buffer, CDR_HEADER_SIZE));
   switch (data_kind) {
     case SDK_KEY:
-      if (swap_necessary(stream_endianness))
-        key_read_swapped(str, sample);
-      else
-        key_read(str, sample);
+      key_read(str, sample);
       break;
     case SDK_DATA:
-      if (swap_necessary(stream_endianness))
-        read_swapped(str, sample);
-      else
-        read(str, sample);
+      read(str, sample);
       break;
     case SDK_EMPTY:
       assert(0);
@@ -124,10 +190,105 @@ bool deserialize_sample_from_buffer(unsigned char * buffer,
   return !str.abort_status();
 }
 
+/// \brief De-serialize the buffer into the sample
+/// \param[in] buffer The buffer to be de-serialized
+/// \param[out] sample Type to which the buffer will be de-serialized
+/// \param[in] data_kind The data kind (data, or key)
+/// \tparam T The sample type
+/// \return True if the deserialization is successful
+///         False if the deserialization failed
+template <typename T>
+bool deserialize_sample_from_buffer(unsigned char * buffer,
+                                    T & sample,
+                                    const ddsi_serdata_kind data_kind=SDK_DATA)
+{
+  endianness stream_endianness = endianness::big_endian;
+  if (*(buffer + 1) == 0x1) {
+    stream_endianness = endianness::little_endian;
+  }
+
+  if (swap_necessary(stream_endianness)) {
+    org::eclipse::cyclonedds::core::cdr::swapped_basic_cdr_stream str;
+    return deserialize_sample_from_stream(str, buffer, sample, data_kind);
+  } else {
+    org::eclipse::cyclonedds::core::cdr::basic_cdr_stream str;
+    return deserialize_sample_from_stream(str, buffer, sample, data_kind);
+  }
+}
+
+/// \brief Read the key fields of a sample from the buffer
+///
+/// Unlike deserialize_sample_from_buffer, the strings and sequences of
+/// primitives of the other fields of serialized data are skipped over instead
+/// of copied into the sample, which leaves those fields unspecified.
+/// \param[in] buffer The buffer to read the key from
+/// \param[out] sample Type to which the key fields are read
+/// \param[in] data_kind The data kind (data, or key)
+/// \tparam T The sample type
+/// \return True if the key was read successfully
+///         False if the buffer could not be de-serialized
+template <typename T>
+bool key_from_buffer(unsigned char * buffer,
+                     T & sample,
+                     const ddsi_serdata_kind data_kind)
+{
+  if (data_kind != SDK_DATA)
+    return deserialize_sample_from_buffer(buffer, sample, data_kind);
+
+  endianness stream_endianness = endianness::big_endian;
+  if (*(buffer + 1) == 0x1) {
+    stream_endianness = endianness::little_endian;
+  }
+
+  if (swap_necessary(stream_endianness)) {
+    org::eclipse::cyclonedds::core::cdr::swapped_key_extract_stream str;
+    str.set_buffer(calc_offset(buffer, CDR_HEADER_SIZE));
+    key_extract(str, sample);
+    return !str.abort_status();
+  } else {
+    org::eclipse::cyclonedds::core::cdr::key_extract_stream str;
+    str.set_buffer(calc_offset(buffer, CDR_HEADER_SIZE));
+    key_extract(str, sample);
+    return !str.abort_status();
+  }
+}
+
+/// \brief Storage of the sample that a ddscxx_serdata caches
+///
+/// Plain types are simply wrapped. Types that are allocator aware (as generated
+/// by idlc with "-f pmr") get a private monotonic arena, sized after the
+/// serialized sample, from which all their strings and sequences are allocated.
+/// Freeing the sample then releases the arena at once instead of freeing each
+/// string and sequence separately.
+template <typename T, typename = void>
+struct sample_box {
+  T sample;
+
+  explicit sample_box(size_t) { }
+  sample_box(const T& toset, size_t) : sample(toset) { }
+};
+
+#ifdef DDSCXX_HAS_PMR
+template <typename T>
+struct sample_box<T, typename std::enable_if<
+    std::uses_allocator<T, std::pmr::polymorphic_allocator<char> >::value>::type> {
+  std::pmr::monotonic_buffer_resource arena;
+  T sample;
+
+  explicit sample_box(size_t size_hint) :
+    arena(std::max<size_t>(size_hint, 64)),
+    sample(std::pmr::polymorphic_allocator<char>(&arena)) { }
+  sample_box(const T& toset, size_t size_hint) :
+    arena(std::max<size_t>(size_hint, 64)),
+    sample(toset, std::pmr::polymorphic_allocator<char>(&arena)) { }
+};
+#endif
+
 template <typename T>
 class ddscxx_sertype : public ddsi_sertype {
 public:
   static const ddsi_sertype_ops ddscxx_sertype_ops;
+  const std::vector<uint8_t> type_hash;
   ddscxx_sertype();
 };
 
@@ -137,7 +298,7 @@ class ddscxx_serdata : public ddsi_serdata {
   std::unique_ptr<unsigned char[]> m_data{ nullptr };
   ddsi_keyhash_t m_key;
   bool m_key_md5_hashed = false;
-  std::atomic<T *> m_t{ nullptr };
+  std::atomic<sample_box<T> *> m_t{ nullptr };
 
 public:
   bool hash_populated = false;
@@ -153,27 +314,35 @@ public:
   bool& key_md5_hashed() { return m_key_md5_hashed; }
   const bool& key_md5_hashed() const { return m_key_md5_hashed; }
   void populate_hash();
+  void populate_hash(const ddsi_keyhash_t& keyhash, bool md5_hashed, uint32_t keyhash_hash);
 
   T* setT(const T* toset)
   {
     assert(toset);
-    T* t = m_t.load(std::memory_order_acquire);
-    if (t == nullptr) {
-      t = new T(*toset);
-      T* exp = nullptr;
-      if (!m_t.compare_exchange_strong(exp, t, std::memory_order_seq_cst)) {
-        delete t;
-        t = exp;
+    sample_box<T>* box = m_t.load(std::memory_order_acquire);
+    if (box == nullptr) {
+      box = new sample_box<T>(*toset, m_size);
+      sample_box<T>* exp = nullptr;
+      if (!m_t.compare_exchange_strong(exp, box, std::memory_order_seq_cst)) {
+        delete box;
+        box = exp;
       }
     } else {
-      *t = *toset;
+      box->sample = *toset;
     }
-    return t;
+    return &box->sample;
+  }
+
+  /// \brief The sample, if it was already set or deserialized
+  const T* cachedT() const {
+    sample_box<T> *box = m_t.load(std::memory_order_acquire);
+    return box ? &box->sample : nullptr;
   }
 
   T* getT() {
     // check if m_t is already set
-    T *t = m_t.load(std::memory_order_acquire);
+    sample_box<T> *box = m_t.load(std::memory_order_acquire);
+    T *t = box ? &box->sample : nullptr;
     // if m_t is not set
     if (t == nullptr) {
       // if the data is available on iox_chunk, update and get the sample
@@ -189,18 +358,19 @@ public:
 
 private:
   void deserialize_and_update_sample(uint8_t * buffer, T *& t) {
-    t = new T();
+    sample_box<T> *box = new sample_box<T>(m_size);
     // if deserialization failed
-    if(!deserialize_sample_from_buffer(buffer, *t, kind)) {
-      delete t;
-      t = nullptr;
+    if(!deserialize_sample_from_buffer(buffer, box->sample, kind)) {
+      delete box;
+      box = nullptr;
     }
 
-    T* exp = nullptr;
-    if (!m_t.compare_exchange_strong(exp, t, std::memory_order_seq_cst)) {
-      delete t;
-      t = exp;
+    sample_box<T>* exp = nullptr;
+    if (!m_t.compare_exchange_strong(exp, box, std::memory_order_seq_cst)) {
+      delete box;
+      box = exp;
     }
+    t = box ? &box->sample : nullptr;
   }
 
   void update_sample_from_iox_chunk(T *& t) {
@@ -234,22 +404,18 @@ void ddscxx_serdata<T>::populate_hash()
   if (hash_populated)
     return;
 
-  org::eclipse::cyclonedds::core::cdr::basic_cdr_stream str;
-  key_md5_hashed() = to_key(str, *getT(), key());
-  if (!key_md5_hashed())
-  {
-    ddsi_keyhash_t buf;
-    ddsrt_md5_state_t md5st;
-    ddsrt_md5_init(&md5st);
-    ddsrt_md5_append(&md5st, static_cast<const ddsrt_md5_byte_t*>(key().value), 16);
-    ddsrt_md5_finish(&md5st, static_cast<ddsrt_md5_byte_t*>(buf.value));
-    memcpy(&(hash), buf.value, 4);
-  }
-  else
-  {
-    memcpy(&(hash), key().value, 4);
-  }
+  /* The key has already been calculated by whoever constructed this serdata. */
+  hash = keyhash_to_hash(key(), key_md5_hashed());
+  hash_populated = true;
+}
 
+/// \brief Use a keyhash (and the hash belonging to it) that was calculated before
+template <typename T>
+void ddscxx_serdata<T>::populate_hash(const ddsi_keyhash_t& keyhash, bool md5_hashed, uint32_t keyhash_hash)
+{
+  m_key = keyhash;
+  m_key_md5_hashed = md5_hashed;
+  hash = keyhash_hash;
   hash_populated = true;
 }
 
@@ -268,6 +434,30 @@ uint32_t serdata_size(const ddsi_serdata* dcmn)
   return static_cast<uint32_t>(static_cast<const ddscxx_serdata<T>*>(dcmn)->size());
 }
 
+/// \brief Calculate the key of a serdata that holds received serialized data
+///
+/// Only the key fields are read from the data (see key_from_buffer), into a
+/// per-thread scratch sample of which the strings and sequences keep their
+/// capacity. The sample itself is deserialized when it is first read, so a
+/// sample that is replaced in the reader history before it is read (e.g. with
+/// KEEP_LAST 1 history, see DataReader::take_latest) is never deserialized.
+/// The extraction walks all members, also those of keyless types, so that
+/// data which could not be deserialized later on is rejected on arrival.
+/// \return False if the key could not be read from the serialized data
+template <typename T>
+bool key_from_ser(ddscxx_serdata<T>* d)
+{
+  static thread_local T scratch;
+  if (d->size() < CDR_HEADER_SIZE ||
+      !key_from_buffer(static_cast<unsigned char*>(d->data()), scratch, d->kind))
+    return false;
+
+  big_endian_basic_cdr_stream str;
+  d->key_md5_hashed() = to_key(str, scratch, d->key());
+  d->populate_hash();
+  return true;
+}
+
 template <typename T>
 ddsi_serdata *serdata_from_ser(
   const ddsi_sertype* type,
@@ -299,14 +489,7 @@ ddsi_serdata *serdata_from_ser(
     fragchain = fragchain->nextfrag;
   }
 
-  if (d->getT())
-  {
-    org::eclipse::cyclonedds::core::cdr::basic_cdr_stream str;
-    str.set_buffer(calc_offset(d->data(), 4));
-    d->key_md5_hashed() = to_key(str, *d->getT(), d->key());
-    d->populate_hash();
-  }
-  else
+  if (!key_from_ser(d))
   {
     delete d;
     d = nullptr;
@@ -316,14 +499,12 @@ ddsi_serdata *serdata_from_ser(
 }
 
 template <typename T>
-ddsi_serdata *serdata_from_ser_iov(
-  const ddsi_sertype* type,
-  enum ddsi_serdata_kind kind,
+void copy_iov_into_serdata(
+  ddscxx_serdata<T>* d,
   ddsrt_msg_iovlen_t niov,
   const ddsrt_iovec_t* iov,
   size_t size)
 {
-  auto d = new ddscxx_serdata<T>(type, kind);
   d->resize(size);
 
   size_t off = 0;
@@ -336,14 +517,20 @@ ddsi_serdata *serdata_from_ser_iov(
     cursor += n_bytes;
     off += n_bytes;
   }
+}
 
-  T* ptr = d->getT();
-  if (ptr) {
-    org::eclipse::cyclonedds::core::cdr::basic_cdr_stream str;
-    str.set_buffer(calc_offset(d->data(), 4));
-    d->key_md5_hashed() = to_key(str, *ptr, d->key());
-    d->populate_hash();
-  } else {
+template <typename T>
+ddsi_serdata *serdata_from_ser_iov(
+  const ddsi_sertype* type,
+  enum ddsi_serdata_kind kind,
+  ddsrt_msg_iovlen_t niov,
+  const ddsrt_iovec_t* iov,
+  size_t size)
+{
+  auto d = new ddscxx_serdata<T>(type, kind);
+  copy_iov_into_serdata(d, niov, iov, size);
+
+  if (!key_from_ser(d)) {
     delete d;
     d = nullptr;
   }
@@ -352,17 +539,28 @@ ddsi_serdata *serdata_from_ser_iov(
 
 }
 
+/// \brief Create a serdata from serialized data of which the keyhash is already known
+///
+/// Unlike serdata_from_ser_iov, the sample is not deserialized to calculate its
+/// key. It is only deserialized when it is needed later on.
 template <typename T>
-ddsi_serdata *serdata_from_keyhash(
+ddsi_serdata *serdata_from_ser_iov_keyhash(
   const ddsi_sertype* type,
-  const struct ddsi_keyhash* keyhash)
+  enum ddsi_serdata_kind kind,
+  ddsrt_msg_iovlen_t niov,
+  const ddsrt_iovec_t* iov,
+  size_t size,
+  const ddsi_keyhash_t& keyhash,
+  bool key_md5_hashed,
+  uint32_t hash)
 {
-  (void)keyhash;
-  (void)type;
-  //replace with (if key_size_max <= 16) then populate the data class with the key hash (key_read)
-  return nullptr;
+  auto d = new ddscxx_serdata<T>(type, kind);
+  copy_iov_into_serdata(d, niov, iov, size);
+  d->populate_hash(keyhash, key_md5_hashed, hash);
+  return d;
 }
 
+
 template <typename T>
 void ddscxx_serdata<T>::resize(size_t requested_size)
 {
@@ -382,25 +580,24 @@ void ddscxx_serdata<T>::resize(size_t requested_size)
   std::memset(calc_offset(m_data.get(), static_cast<ptrdiff_t>(requested_size)), '\0', n_pad_bytes);
 }
 
+/// \brief Serialize a sample into a serdata, without calculating its key
+/// \return True if the serialization is successful
 template <typename T>
-ddsi_serdata *serdata_from_sample(
-  const ddsi_sertype* typecmn,
-  enum ddsi_serdata_kind kind,
-  const void* sample)
+bool serialize_into_serdata(ddscxx_serdata<T>* d, enum ddsi_serdata_kind kind, const T& msg)
 {
-  auto d = new ddscxx_serdata<T>(typecmn, kind);
   org::eclipse::cyclonedds::core::cdr::basic_cdr_stream str;
-  const auto& msg = *static_cast<const T*>(sample);
   unsigned char *ptr = nullptr;
   size_t sz = 0;
 
   if (kind == SDK_KEY)
     key_move(str, msg);
+  else if constexpr (org::eclipse::cyclonedds::topic::TopicTraits<T>::isFixedSize())
+    str.position(org::eclipse::cyclonedds::topic::TopicTraits<T>::getMaxSerializedSize());
   else
     move(str, msg);
 
   if (str.abort_status())
-    goto failure;
+    return false;
 
   sz = 4 + str.position();  //4 bytes extra to also include the header
   d->resize(sz);
@@ -422,19 +619,103 @@ ddsi_serdata *serdata_from_sample(
     assert(0);
   }
 
-  if (str.abort_status())
-    goto failure;
+  return !str.abort_status();
+}
+
+template <typename T>
+ddsi_serdata *serdata_from_sample(
+  const ddsi_sertype* typecmn,
+  enum ddsi_serdata_kind kind,
+  const void* sample)
+{
+  auto d = new ddscxx_serdata<T>(typecmn, kind);
+  big_endian_basic_cdr_stream str;
+  const auto& msg = *static_cast<const T*>(sample);
+
+  if (!serialize_into_serdata(d, kind, msg))
+  {
+    delete d;
+    return nullptr;
+  }
 
-  str.reset_position();
   d->key_md5_hashed() = to_key(str, msg, d->key());
   d->setT(&msg);
   d->populate_hash();
   return d;
+}
 
-failure:
-  if (d)
+/// \brief Create a serdata for a sample of which the keyhash is already known
+///
+/// This skips the key serialization and hashing that serdata_from_sample does,
+/// for writers that keep track of the keyhashes of their instances.
+/// \param[in] typecmn The sertype of the sample
+/// \param[in] kind The data kind (data, or key)
+/// \param[in] msg The sample
+/// \param[in] keyhash The keyhash of the sample
+/// \param[in] key_md5_hashed Whether the keyhash is an MD5 hash of the key
+/// \param[in] hash The serdata hash belonging to the keyhash (see keyhash_to_hash)
+/// \return The serdata, or nullptr if the serialization failed
+template <typename T>
+ddsi_serdata *serdata_from_sample_keyhash(
+  const ddsi_sertype* typecmn,
+  enum ddsi_serdata_kind kind,
+  const T& msg,
+  const ddsi_keyhash_t& keyhash,
+  bool key_md5_hashed,
+  uint32_t hash)
+{
+  auto d = new ddscxx_serdata<T>(typecmn, kind);
+
+  if (!serialize_into_serdata(d, kind, msg))
+  {
     delete d;
-  return nullptr;
+    return nullptr;
+  }
+
+  d->populate_hash(keyhash, key_md5_hashed, hash);
+  d->setT(&msg);
+  return d;
+}
+
+/// \brief Create a key serdata from a keyhash
+///
+/// This is only possible if the key always fits in the keyhash, as then the
+/// keyhash is the (big-endian) serialized key itself (see to_key). For other
+/// keys, ddsi has to make do without and nullptr is returned.
+template <typename T>
+ddsi_serdata *serdata_from_keyhash(
+  const ddsi_sertype* type,
+  const struct ddsi_keyhash* keyhash)
+{
+  if constexpr (org::eclipse::cyclonedds::topic::TopicTraits<T>::isKeySimple())
+  {
+    big_endian_basic_cdr_stream str;
+    alignas(8) unsigned char buffer[sizeof(keyhash->value)];
+    T sample;
+
+    memcpy(buffer, keyhash->value, sizeof(buffer));
+    str.set_buffer(buffer);
+    key_read(str, sample);
+    if (str.abort_status())
+      return nullptr;
+
+    auto d = new ddscxx_serdata<T>(type, SDK_KEY);
+    if (!serialize_into_serdata(d, SDK_KEY, sample))
+    {
+      delete d;
+      return nullptr;
+    }
+
+    d->populate_hash(*keyhash, false, keyhash_to_hash(*keyhash, false));
+    d->setT(&sample);
+    return d;
+  }
+  else
+  {
+    (void)type;
+    (void)keyhash;
+    return nullptr;
+  }
 }
 
 template <typename T>
@@ -488,8 +769,16 @@ ddsi_serdata *serdata_to_untyped(const ddsi_serdata* dcmn)
   d1->type = nullptr;
 
   basic_cdr_stream str;
-  auto t = d->getT();
-  if (t == nullptr)
+  /* the key fields of serialized data are read without deserializing the
+   * whole sample, which is only done if there is no serialized data */
+  static thread_local T scratch;
+  const T* t = d->cachedT();
+  if (t == nullptr && d->data() != nullptr && d->size() >= CDR_HEADER_SIZE) {
+    if (!key_from_buffer(static_cast<unsigned char*>(d->data()), scratch, d->kind))
+      goto failure;
+    t = &scratch;
+  }
+  if (t == nullptr && (t = d->getT()) == nullptr)
     goto failure;
 
   key_move(str, *t);
@@ -507,7 +796,8 @@ ddsi_serdata *serdata_to_untyped(const ddsi_serdata* dcmn)
   if (str.abort_status())
     goto failure;
 
-  d1->key_md5_hashed() = to_key(str, *t, d1->key());
+  big_endian_basic_cdr_stream key_str;
+  d1->key_md5_hashed() = to_key(key_str, *t, d1->key());
   d1->hash = d->hash;
   d1->hash_populated = true;
 
@@ -610,7 +900,7 @@ ddsi_serdata * serdata_from_iox_buffer(
     }
 
     // key handling
-    org::eclipse::cyclonedds::core::cdr::basic_cdr_stream str;
+    big_endian_basic_cdr_stream str;
     const auto& msg = *static_cast<const T*>(d->iox_chunk);
     d->key_md5_hashed() = to_key(str, msg, d->key());
     d->populate_hash();
@@ -656,7 +946,8 @@ ddscxx_serdata<T>::ddscxx_serdata(const ddsi_sertype* type, ddsi_serdata_kind ki
 
 template <typename T>
 ddscxx_sertype<T>::ddscxx_sertype()
-  : ddsi_sertype{}
+  : ddsi_sertype{},
+    type_hash(org::eclipse::cyclonedds::topic::TopicTraits<T>::getTypeHash())
 {
   uint32_t flags = (org::eclipse::cyclonedds::topic::TopicTraits<T>::isKeyless() ?
                     DDSI_SERTYPE_FLAG_TOPICKIND_NO_KEY : 0);
@@ -742,35 +1033,44 @@ template <typename T>
 bool sertype_equal(
   const ddsi_sertype* acmn, const ddsi_sertype* bcmn)
 {
-  /* A bit of a guess: types with the same name & type name are really the same if they have
-   the same type support identifier as well */
-  (void)acmn;
-  (void)bcmn;
-  return true;
+  /* ddsi has already compared the type names and the ops, what remains is
+     whether the type definitions, as hashed by idlc, are the same */
+  auto a = static_cast<const ddscxx_sertype<T>*>(acmn);
+  auto b = static_cast<const ddscxx_sertype<T>*>(bcmn);
+  return a->type_hash == b->type_hash;
 }
 
 template <typename T>
 uint32_t sertype_hash(const ddsi_sertype* tpcmn)
 {
-  (void)tpcmn;
-  return 0x0;
+  auto tp = static_cast<const ddscxx_sertype<T>*>(tpcmn);
+  return ddsrt_mh3(tp->type_hash.data(), tp->type_hash.size(), 0);
 }
 
 template <typename T>
 size_t sertype_get_serialized_size(const ddsi_sertype*, const void * sample)
 {
-  const auto& msg = *static_cast<const T*>(sample);
+  if constexpr (org::eclipse::cyclonedds::topic::TopicTraits<T>::isFixedSize())
+  {
+    // all samples have the same serialized size
+    (void)sample;
+    return org::eclipse::cyclonedds::topic::TopicTraits<T>::getMaxSerializedSize() + CDR_HEADER_SIZE;
+  }
+  else
+  {
+    const auto& msg = *static_cast<const T*>(sample);
 
-  // get the serialized size of the sample (with out serializing)
-  org::eclipse::cyclonedds::core::cdr::basic_cdr_stream str;
-  move(str, msg);
+    // get the serialized size of the sample (with out serializing)
+    org::eclipse::cyclonedds::core::cdr::basic_cdr_stream str;
+    move(str, msg);
 
-  if (str.abort_status()) {
-    // the max value is treated as an error in the Cyclone core
-    return std::numeric_limits<size_t>::max();
-  }
+    if (str.abort_status()) {
+      // the max value is treated as an error in the Cyclone core
+      return std::numeric_limits<size_t>::max();
+    }
 
-  return str.position() + CDR_HEADER_SIZE;  // Include the additional bytes for the CDR header
+    return str.position() + CDR_HEADER_SIZE;  // Include the additional bytes for the CDR header
+  }
 }
 
 template <typename T>
@@ -20,6 +20,7 @@
 
 #include <dds/core/detail/conformance.hpp>
 #include <dds/core/policy/CorePolicy.hpp>
+#include <org/eclipse/cyclonedds/core/DdscQosCache.hpp>
 
 struct _DDS_NamedTopicQos;
 
@@ -62,6 +63,10 @@ public:
     dds_qos_t* ddsc_qos() const;
     void ddsc_qos(const dds_qos_t* qos);
 
+    /* The returned ddsc QoS is shared and must not be freed. It is
+     * translated once and reused until this QoS is modified. */
+    org::eclipse::cyclonedds::core::DdscQosCache::qos_ref cached_ddsc_qos() const;
+
     void named_qos(const struct _DDS_NamedTopicQos &qos);
 
     void check() const;
@@ -84,6 +89,7 @@ private:
     dds::core::policy::TransportPriority      priority_;
     dds::core::policy::Lifespan               lifespan_;
     dds::core::policy::Ownership              ownership_;
+    org::eclipse::cyclonedds::core::DdscQosCache ddsc_qos_cache_;
 };
 
 
@@ -99,6 +105,7 @@ TopicQosDelegate::policy<dds::core::policy::TopicData>() const
 template<> inline dds::core::policy::TopicData&
 TopicQosDelegate::policy<dds::core::policy::TopicData>()
 {
+    ddsc_qos_cache_.escape();
     return topic_data_;
 }
 
@@ -111,6 +118,7 @@ TopicQosDelegate::policy<dds::core::policy::Durability>() const
 template<> inline dds::core::policy::Durability&
 TopicQosDelegate::policy<dds::core::policy::Durability>()
 {
+    ddsc_qos_cache_.escape();
     return durability_;
 }
 
@@ -124,6 +132,7 @@ TopicQosDelegate::policy<dds::core::policy::DurabilityService>() const
 template<> inline dds::core::policy::DurabilityService&
 TopicQosDelegate::policy<dds::core::policy::DurabilityService>()
 {
+    ddsc_qos_cache_.escape();
     return durability_service_;
 }
 #endif  // OMG_DDS_PERSISTENCE_SUPPORT
@@ -137,6 +146,7 @@ TopicQosDelegate::policy<dds::core::policy::Deadline>() const
 template<> inline dds::core::policy::Deadline&
 TopicQosDelegate::policy<dds::core::policy::Deadline>()
 {
+    ddsc_qos_cache_.escape();
     return deadline_;
 }
 
@@ -149,6 +159,7 @@ TopicQosDelegate::policy<dds::core::policy::LatencyBudget>() const
 template<> inline dds::core::policy::LatencyBudget&
 TopicQosDelegate::policy<dds::core::policy::LatencyBudget>()
 {
+    ddsc_qos_cache_.escape();
     return budget_;
 }
 
@@ -161,6 +172,7 @@ TopicQosDelegate::policy<dds::core::policy::Liveliness>() const
 template<> inline dds::core::policy::Liveliness&
 TopicQosDelegate::policy<dds::core::policy::Liveliness>()
 {
+    ddsc_qos_cache_.escape();
     return liveliness_;
 }
 
@@ -173,6 +185,7 @@ TopicQosDelegate::policy<dds::core::policy::Reliability>() const
 template<> inline dds::core::policy::Reliability&
 TopicQosDelegate::policy<dds::core::policy::Reliability>()
 {
+    ddsc_qos_cache_.escape();
     return reliability_;
 }
 
@@ -185,6 +198,7 @@ TopicQosDelegate::policy<dds::core::policy::DestinationOrder>() const
 template<> inline dds::core::policy::DestinationOrder&
 TopicQosDelegate::policy<dds::core::policy::DestinationOrder>()
 {
+    ddsc_qos_cache_.escape();
     return order_;
 }
 
@@ -197,6 +211,7 @@ TopicQosDelegate::policy<dds::core::policy::History>() const
 template<> inline dds::core::policy::History&
 TopicQosDelegate::policy<dds::core::policy::History>()
 {
+    ddsc_qos_cache_.escape();
     return history_;
 }
 
@@ -209,6 +224,7 @@ TopicQosDelegate::policy<dds::core::policy::ResourceLimits>() const
 template<> inline dds::core::policy::ResourceLimits&
 TopicQosDelegate::policy<dds::core::policy::ResourceLimits>()
 {
+    ddsc_qos_cache_.escape();
     return resources_;
 }
 
@@ -221,6 +237,7 @@ TopicQosDelegate::policy<dds::core::policy::TransportPriority>() const
 template<> inline dds::core::policy::TransportPriority&
 TopicQosDelegate::policy<dds::core::policy::TransportPriority>()
 {
+    ddsc_qos_cache_.escape();
     return priority_;
 }
 
@@ -233,6 +250,7 @@ TopicQosDelegate::policy<dds::core::policy::Lifespan>() const
 template<> inline dds::core::policy::Lifespan&
 TopicQosDelegate::policy<dds::core::policy::Lifespan>()
 {
+    ddsc_qos_cache_.escape();
     return lifespan_;
 }
 
@@ -245,6 +263,7 @@ TopicQosDelegate::policy<dds::core::policy::Ownership>() const
 template<> inline dds::core::policy::Ownership&
 TopicQosDelegate::policy<dds::core::policy::Ownership>()
 {
+    ddsc_qos_cache_.escape();
     return ownership_;
 }
 
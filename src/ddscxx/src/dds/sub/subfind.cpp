@@ -17,6 +17,7 @@
 
 
 #include <dds/sub/find.hpp>
+#include <org/eclipse/cyclonedds/sub/BuiltinSubscriberDelegate.hpp>
 
 namespace dds
 {
@@ -26,15 +27,9 @@ namespace sub
 const Subscriber
 builtin_subscriber(const dds::domain::DomainParticipant& dp)
 {
-    (void)dp;
-    ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR, "Function not currently supported");
-#if 0
     org::eclipse::cyclonedds::sub::SubscriberDelegate::ref_type ref =
             org::eclipse::cyclonedds::sub::BuiltinSubscriberDelegate::get_builtin_subscriber(dp);
     return Subscriber(ref);
-#else
-    return Subscriber(dds::core::null);
-#endif
 }
 
 }
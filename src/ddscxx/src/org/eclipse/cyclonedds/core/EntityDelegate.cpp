@@ -35,6 +35,7 @@ org::eclipse::cyclonedds::core::EntityDelegate::EntityDelegate() :
   enabled_(false),
   listener_mask(0),
   listener_callbacks(NULL),
+  tracked_mask(0),
   listener(NULL)
 {
   this->callback_mutex = dds_alloc (sizeof (ddsrt_mutex_t));
@@ -48,6 +49,11 @@ org::eclipse::cyclonedds::core::EntityDelegate::EntityDelegate() :
 
 org::eclipse::cyclonedds::core::EntityDelegate::~EntityDelegate()
 {
+  if (this->executor)
+  {
+    this->executor->cancel(this->executor_strand);
+  }
+
   if (this->listener_callbacks != NULL)
   {
     dds_delete_listener(this->listener_callbacks);
@@ -63,7 +69,9 @@ org::eclipse::cyclonedds::core::EntityDelegate::~EntityDelegate()
 void org::eclipse::cyclonedds::core::EntityDelegate::enable()
 {
   dds_return_t ret;
+  ddsrt_mutex_lock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
   enabled_ = true;
+  ddsrt_mutex_unlock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
   ret = dds_set_listener (this->ddsc_entity, this->listener_callbacks);
   ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Could not set internal listener.");
 }
@@ -149,7 +157,9 @@ org::eclipse::cyclonedds::core::EntityDelegate::listener_set(
 {
     dds_listener_t *callbacks;
     this->listener = _listener;
+    ddsrt_mutex_lock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
     this->listener_mask = mask;
+    ddsrt_mutex_unlock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
 
     callbacks = dds_create_listener(this);
 
@@ -172,7 +182,13 @@ org::eclipse::cyclonedds::core::EntityDelegate::listener_set(
     {
         dds_lset_liveliness_lost(callbacks, callback_on_liveliness_lost);
     }
-    if (STATUS_MASK_CONTAINS(mask, dds::core::status::StatusMask::publication_matched()))
+    // A tracked status is not reset by ddsc: the callback forwards it to the
+    // listener that ddsc would have invoked (see listener_target), if any.
+    if (STATUS_MASK_CONTAINS(this->tracked_mask, dds::core::status::StatusMask::publication_matched()))
+    {
+        dds_lset_publication_matched_arg(callbacks, callback_on_publication_matched_tracked, this, false);
+    }
+    else if (STATUS_MASK_CONTAINS(mask, dds::core::status::StatusMask::publication_matched()))
     {
         dds_lset_publication_matched(callbacks, callback_on_publication_matched);
     }
@@ -198,7 +214,11 @@ org::eclipse::cyclonedds::core::EntityDelegate::listener_set(
     {
         dds_lset_data_available(callbacks, callback_on_data_available);
     }
-    if (STATUS_MASK_CONTAINS(mask, dds::core::status::StatusMask::subscription_matched()))
+    if (STATUS_MASK_CONTAINS(this->tracked_mask, dds::core::status::StatusMask::subscription_matched()))
+    {
+        dds_lset_subscription_matched_arg(callbacks, callback_on_subscription_matched_tracked, this, false);
+    }
+    else if (STATUS_MASK_CONTAINS(mask, dds::core::status::StatusMask::subscription_matched()))
     {
         dds_lset_subscription_matched(callbacks, callback_on_subscription_matched);
     }
@@ -221,6 +241,22 @@ org::eclipse::cyclonedds::core::EntityDelegate::listener_set(
         ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Setting listener failed.");
     }
 
+    // Queued callbacks invoke the listener that is current when they run, but
+    // one that is running may still be using the previous listener. Without
+    // a listener, the queued callbacks have become pointless.
+    ddsrt_mutex_lock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
+    ListenerExecutor::ref_type exec = this->executor;
+    ListenerExecutor::strand_ref strand = this->executor_strand;
+    ddsrt_mutex_unlock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
+    if (exec && _listener == NULL)
+    {
+        exec->cancel(strand);
+    }
+    else if (exec)
+    {
+        exec->quiesce(strand);
+    }
+
     // Delete previous ddsc listener callbacks object
     if (this->listener_callbacks != NULL)
     {
@@ -231,6 +267,43 @@ org::eclipse::cyclonedds::core::EntityDelegate::listener_set(
     this->listener_callbacks = callbacks;
 }
 
+org::eclipse::cyclonedds::core::EntityDelegate *
+org::eclipse::cyclonedds::core::EntityDelegate::listener_parent() const
+{
+    return NULL;
+}
+
+org::eclipse::cyclonedds::core::EntityDelegate *
+org::eclipse::cyclonedds::core::EntityDelegate::listener_target(
+                 const dds::core::status::StatusMask& status) const
+{
+    // Parents outlive their children, and the parent of an entity never
+    // changes, so the chain can be followed without locking the entities.
+    const EntityDelegate *e = this;
+    while (e != NULL && !e->listens_to(status))
+    {
+        e = e->listener_parent();
+    }
+    return const_cast<EntityDelegate *>(e);
+}
+
+bool
+org::eclipse::cyclonedds::core::EntityDelegate::listens_to(
+                 const dds::core::status::StatusMask& status) const
+{
+    bool listens;
+    ddsrt_mutex_lock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
+    listens = this->enabled_ && STATUS_MASK_CONTAINS(this->listener_mask, status);
+    ddsrt_mutex_unlock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
+    return listens;
+}
+
+void
+org::eclipse::cyclonedds::core::EntityDelegate::on_matched(
+                 dds_entity_t, dds_instance_handle_t, uint32_t)
+{
+}
+
 void * org::eclipse::cyclonedds::core::EntityDelegate::listener_get () const
 {
   return this->listener;
@@ -238,6 +311,17 @@ void * org::eclipse::cyclonedds::core::EntityDelegate::listener_get () const
 
 void org::eclipse::cyclonedds::core::EntityDelegate::prevent_callbacks ()
 {
+  ddsrt_mutex_lock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
+  ListenerExecutor::ref_type exec = this->executor;
+  ListenerExecutor::strand_ref strand = this->executor_strand;
+  ddsrt_mutex_unlock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
+
+  // Queued callbacks hold the callback lock: cancel them rather than wait
+  if (exec)
+  {
+    exec->cancel(strand);
+  }
+
   ddsrt_mutex_lock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
 
   if (this->get_weak_ref().expired () && (this->callback_count == 1))
@@ -292,6 +376,93 @@ void org::eclipse::cyclonedds::core::EntityDelegate::release_callback_lock ()
   ddsrt_mutex_unlock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
 }
 
+void org::eclipse::cyclonedds::core::EntityDelegate::listener_executor (const ListenerExecutor::ref_type& exec)
+{
+  ListenerExecutor::ref_type old_exec;
+  ListenerExecutor::strand_ref old_strand;
+
+  ddsrt_mutex_lock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
+  if (exec != this->executor)
+  {
+    old_exec = this->executor;
+    old_strand = this->executor_strand;
+    this->executor = exec;
+    this->executor_strand = exec ? exec->create_strand() : ListenerExecutor::strand_ref();
+  }
+  ddsrt_mutex_unlock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
+
+  // Let the callbacks that are already queued finish before any new ones can
+  // run, so that the order of the callbacks is maintained
+  if (old_exec)
+  {
+    old_exec->drain(old_strand);
+  }
+}
+
+org::eclipse::cyclonedds::core::ListenerExecutor::ref_type
+org::eclipse::cyclonedds::core::EntityDelegate::listener_executor () const
+{
+  ddsrt_mutex_lock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
+  ListenerExecutor::ref_type exec = this->executor;
+  ddsrt_mutex_unlock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
+
+  return exec;
+}
+
+bool org::eclipse::cyclonedds::core::EntityDelegate::has_listener_executor () const
+{
+  ddsrt_mutex_lock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
+  bool result = static_cast<bool>(this->executor);
+  ddsrt_mutex_unlock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
+
+  return result;
+}
+
+bool org::eclipse::cyclonedds::core::EntityDelegate::defer_callback (
+  std::function<void()>&& callback, bool coalescable)
+{
+  ddsrt_mutex_lock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
+  ListenerExecutor::ref_type exec = this->executor;
+  ListenerExecutor::strand_ref strand = this->executor_strand;
+  ddsrt_mutex_unlock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
+
+  if (!exec)
+  {
+    return false;
+  }
+
+  ListenerExecutor::task_type task = [this, cb = std::move(callback)] (bool run)
+  {
+    // The listener may have been reset after the callback was queued
+    if (run && this->listener_get() != NULL)
+    {
+      try
+      {
+        cb();
+      }
+      catch (...)
+      {
+        // The callback lock has to be released regardless
+      }
+    }
+    this->release_callback_lock();
+  };
+
+  switch (exec->submit(strand, std::move(task), coalescable))
+  {
+    case ListenerExecutor::queued:
+      break;
+    case ListenerExecutor::coalesced:
+      // Coalesced with a callback that is still queued
+      this->release_callback_lock();
+      break;
+    case ListenerExecutor::full:
+      // The pool was full and the strand idle: the callback already ran
+      break;
+  }
+  return true;
+}
+
 const dds::core::status::StatusMask
 org::eclipse::cyclonedds::core::EntityDelegate::get_listener_mask () const
 {
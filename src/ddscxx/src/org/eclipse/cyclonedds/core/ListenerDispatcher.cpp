@@ -24,6 +24,32 @@
 
 #include "dds/dds.h"
 
+#include <functional>
+
+
+/* Invokes a callback for which the callback lock was obtained, or queues it on
+ * the listener executor of the entity when it has one. Only callbacks that do
+ * not carry a status can be coalesced. */
+template <typename F>
+static void dispatch_callback(org::eclipse::cyclonedds::core::EntityDelegate *ed,
+                              F callback, bool coalescable = false)
+{
+  if (ed->has_listener_executor())
+  {
+    std::function<void()> deferred(std::move(callback));
+    if (ed->defer_callback(std::move(deferred), coalescable))
+    {
+      return;
+    }
+    // The executor was removed in the meantime, deferred was left untouched
+    deferred();
+  }
+  else
+  {
+    callback();
+  }
+  ed->release_callback_lock();
+}
 
 #ifdef _WIN32_DLL_
   #define DDS_FN_EXPORT __declspec (dllexport)
@@ -42,10 +68,11 @@ extern "C"
 
     if (ed->obtain_callback_lock())
     {
-       org::eclipse::cyclonedds::core::InconsistentTopicStatusDelegate sd;
-       sd.ddsc_status(&status);
-       ed->on_inconsistent_topic(topic, sd);
-       ed->release_callback_lock();
+       dispatch_callback(ed, [ed, topic, status]() {
+         org::eclipse::cyclonedds::core::InconsistentTopicStatusDelegate sd;
+         sd.ddsc_status(&status);
+         ed->on_inconsistent_topic(topic, sd);
+       });
     }
   }
 
@@ -58,10 +85,11 @@ extern "C"
 
     if (ed->obtain_callback_lock())
     {
-       org::eclipse::cyclonedds::core::OfferedDeadlineMissedStatusDelegate sd;
-       sd.ddsc_status(&status);
-       ed->on_offered_deadline_missed(writer, sd);
-       ed->release_callback_lock();
+       dispatch_callback(ed, [ed, writer, status]() {
+         org::eclipse::cyclonedds::core::OfferedDeadlineMissedStatusDelegate sd;
+         sd.ddsc_status(&status);
+         ed->on_offered_deadline_missed(writer, sd);
+       });
     }
   }
 
@@ -73,10 +101,11 @@ extern "C"
 
     if (ed->obtain_callback_lock())
     {
-       org::eclipse::cyclonedds::core::OfferedIncompatibleQosStatusDelegate sd;
-       sd.ddsc_status(&status);
-       ed->on_offered_incompatible_qos(writer, sd);
-       ed->release_callback_lock();
+       dispatch_callback(ed, [ed, writer, status]() {
+         org::eclipse::cyclonedds::core::OfferedIncompatibleQosStatusDelegate sd;
+         sd.ddsc_status(&status);
+         ed->on_offered_incompatible_qos(writer, sd);
+       });
     }
   }
 
@@ -88,10 +117,11 @@ extern "C"
 
     if (ed->obtain_callback_lock())
     {
-       org::eclipse::cyclonedds::core::LivelinessLostStatusDelegate sd;
-       sd.ddsc_status(&status);
-       ed->on_liveliness_lost(writer, sd);
-       ed->release_callback_lock();
+       dispatch_callback(ed, [ed, writer, status]() {
+         org::eclipse::cyclonedds::core::LivelinessLostStatusDelegate sd;
+         sd.ddsc_status(&status);
+         ed->on_liveliness_lost(writer, sd);
+       });
     }
   }
 
@@ -103,10 +133,35 @@ extern "C"
 
     if (ed->obtain_callback_lock())
     {
-       org::eclipse::cyclonedds::core::PublicationMatchedStatusDelegate sd;
-       sd.ddsc_status(&status);
-       ed->on_publication_matched(writer, sd);
-       ed->release_callback_lock();
+       dispatch_callback(ed, [ed, writer, status]() {
+         org::eclipse::cyclonedds::core::PublicationMatchedStatusDelegate sd;
+         sd.ddsc_status(&status);
+         ed->on_publication_matched(writer, sd);
+       });
+    }
+  }
+
+  DDS_FN_EXPORT void callback_on_publication_matched_tracked
+    (dds_entity_t writer, dds_publication_matched_status_t status, void* arg)
+  {
+    org::eclipse::cyclonedds::core::EntityDelegate *ed =
+        reinterpret_cast<org::eclipse::cyclonedds::core::EntityDelegate *>(arg);
+    org::eclipse::cyclonedds::core::EntityDelegate *target;
+
+    if (!ed->obtain_callback_lock())
+    {
+      return;
+    }
+    ed->on_matched(writer, status.last_subscription_handle, status.current_count);
+    target = ed->listener_target(dds::core::status::StatusMask::publication_matched());
+    ed->release_callback_lock();
+
+    // ddsc does not reset the status for the tracking callback, so it is reset
+    // here when there is a listener to invoke, like ddsc would have done.
+    if (target != NULL)
+    {
+      (void)dds_get_publication_matched_status(writer, NULL);
+      callback_on_publication_matched(writer, status, target);
     }
   }
 
@@ -119,10 +174,11 @@ extern "C"
 
     if (ed->obtain_callback_lock())
     {
-       org::eclipse::cyclonedds::core::RequestedDeadlineMissedStatusDelegate sd;
-       sd.ddsc_status(&status);
-       ed->on_requested_deadline_missed(reader, sd);
-       ed->release_callback_lock();
+       dispatch_callback(ed, [ed, reader, status]() {
+         org::eclipse::cyclonedds::core::RequestedDeadlineMissedStatusDelegate sd;
+         sd.ddsc_status(&status);
+         ed->on_requested_deadline_missed(reader, sd);
+       });
     }
   }
 
@@ -134,10 +190,11 @@ extern "C"
 
     if (ed->obtain_callback_lock())
     {
-       org::eclipse::cyclonedds::core::RequestedIncompatibleQosStatusDelegate sd;
-       sd.ddsc_status(&status);
-       ed->on_requested_incompatible_qos(reader, sd);
-       ed->release_callback_lock();
+       dispatch_callback(ed, [ed, reader, status]() {
+         org::eclipse::cyclonedds::core::RequestedIncompatibleQosStatusDelegate sd;
+         sd.ddsc_status(&status);
+         ed->on_requested_incompatible_qos(reader, sd);
+       });
     }
   }
 
@@ -149,10 +206,11 @@ extern "C"
 
     if (ed->obtain_callback_lock())
     {
-       org::eclipse::cyclonedds::core::SampleRejectedStatusDelegate sd;
-       sd.ddsc_status(&status);
-       ed->on_sample_rejected(reader, sd);
-       ed->release_callback_lock();
+       dispatch_callback(ed, [ed, reader, status]() {
+         org::eclipse::cyclonedds::core::SampleRejectedStatusDelegate sd;
+         sd.ddsc_status(&status);
+         ed->on_sample_rejected(reader, sd);
+       });
     }
   }
 
@@ -164,10 +222,11 @@ extern "C"
 
     if (ed->obtain_callback_lock())
     {
-       org::eclipse::cyclonedds::core::LivelinessChangedStatusDelegate sd;
-       sd.ddsc_status(&status);
-       ed->on_liveliness_changed(reader, sd);
-       ed->release_callback_lock();
+       dispatch_callback(ed, [ed, reader, status]() {
+         org::eclipse::cyclonedds::core::LivelinessChangedStatusDelegate sd;
+         sd.ddsc_status(&status);
+         ed->on_liveliness_changed(reader, sd);
+       });
     }
   }
 
@@ -177,8 +236,9 @@ extern "C"
         reinterpret_cast<org::eclipse::cyclonedds::core::EntityDelegate *>(arg);
     if (ed->obtain_callback_lock())
     {
-       ed->on_data_available(reader);
-       ed->release_callback_lock();
+       dispatch_callback(ed, [ed, reader]() {
+         ed->on_data_available(reader);
+       }, true);
     }
   }
 
@@ -190,10 +250,34 @@ extern "C"
 
     if (ed->obtain_callback_lock())
     {
-       org::eclipse::cyclonedds::core::SubscriptionMatchedStatusDelegate sd;
-       sd.ddsc_status(&status);
-       ed->on_subscription_matched(reader, sd);
-       ed->release_callback_lock();
+       dispatch_callback(ed, [ed, reader, status]() {
+         org::eclipse::cyclonedds::core::SubscriptionMatchedStatusDelegate sd;
+         sd.ddsc_status(&status);
+         ed->on_subscription_matched(reader, sd);
+       });
+    }
+  }
+
+  DDS_FN_EXPORT void callback_on_subscription_matched_tracked
+    (dds_entity_t reader, dds_subscription_matched_status_t status, void* arg)
+  {
+    org::eclipse::cyclonedds::core::EntityDelegate *ed =
+        reinterpret_cast<org::eclipse::cyclonedds::core::EntityDelegate *>(arg);
+    org::eclipse::cyclonedds::core::EntityDelegate *target;
+
+    if (!ed->obtain_callback_lock())
+    {
+      return;
+    }
+    ed->on_matched(reader, status.last_publication_handle, status.current_count);
+    target = ed->listener_target(dds::core::status::StatusMask::subscription_matched());
+    ed->release_callback_lock();
+
+    // See callback_on_publication_matched_tracked.
+    if (target != NULL)
+    {
+      (void)dds_get_subscription_matched_status(reader, NULL);
+      callback_on_subscription_matched(reader, status, target);
     }
   }
 
@@ -205,10 +289,11 @@ extern "C"
 
     if (ed->obtain_callback_lock())
     {
-       org::eclipse::cyclonedds::core::SampleLostStatusDelegate sd;
-       sd.ddsc_status(&status);
-       ed->on_sample_lost(reader, sd);
-       ed->release_callback_lock();
+       dispatch_callback(ed, [ed, reader, status]() {
+         org::eclipse::cyclonedds::core::SampleLostStatusDelegate sd;
+         sd.ddsc_status(&status);
+         ed->on_sample_lost(reader, sd);
+       });
     }
   }
 
@@ -219,8 +304,9 @@ extern "C"
         reinterpret_cast<org::eclipse::cyclonedds::core::EntityDelegate *>(arg);
     if (ed->obtain_callback_lock())
     {
-       ed->on_data_readers(subscriber);
-       ed->release_callback_lock();
+       dispatch_callback(ed, [ed, subscriber]() {
+         ed->on_data_readers(subscriber);
+       }, true);
     }
   }
 }
@@ -0,0 +1,355 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+
+
+/**
+ * @file
+ */
+
+#include <org/eclipse/cyclonedds/core/ListenerExecutor.hpp>
+#include <org/eclipse/cyclonedds/core/ReportUtils.hpp>
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace core
+{
+
+class ListenerExecutor::strand
+{
+public:
+    struct entry {
+        entry(task_type&& t, bool c) : task(std::move(t)), coalescable(c) { }
+        task_type task;
+        bool coalescable;
+    };
+
+    std::deque<entry> tasks;
+    /* In the ready queue of a worker or being run by one. */
+    bool scheduled = false;
+    bool running = false;
+    std::thread::id runner;
+    /* Has a coalescable task that did not start yet. */
+    bool coalesced = false;
+};
+
+/* Shared with the workers, so that a worker that happens to release the last
+ * reference to the executor from within a callback can still finish up. */
+struct ListenerExecutor::state
+{
+    state(uint32_t n, size_t cap, bool c)
+        : ready(n), next(0), pending(0), capacity(cap), coalesce(c), overflows(0), terminate(false)
+    {
+    }
+
+    static void run(std::shared_ptr<state> st, size_t index);
+    static void run_inline(state& st, const strand_ref& s,
+                           std::unique_lock<std::mutex>& lock, task_type&& task);
+    strand_ref take(size_t index);
+    bool is_worker() const;
+
+    std::mutex mutex;
+    std::condition_variable work_cond;
+    std::condition_variable idle_cond;
+    std::vector<std::deque<strand_ref> > ready;
+    size_t next;
+    size_t pending;
+    const size_t capacity;
+    const bool coalesce;
+    uint64_t overflows;
+    bool terminate;
+};
+
+static thread_local const void *current_state = NULL;
+static thread_local size_t current_index = 0;
+
+bool
+ListenerExecutor::state::is_worker() const
+{
+    return current_state == this;
+}
+
+ListenerExecutor::strand_ref
+ListenerExecutor::state::take(size_t index)
+{
+    strand_ref s;
+    if (!this->ready[index].empty()) {
+        s = this->ready[index].front();
+        this->ready[index].pop_front();
+        return s;
+    }
+    /* Steal from the back, where the work that was queued last waits. */
+    for (size_t i = 1; i < this->ready.size(); i++) {
+        std::deque<strand_ref>& victim = this->ready[(index + i) % this->ready.size()];
+        if (!victim.empty()) {
+            s = victim.back();
+            victim.pop_back();
+            return s;
+        }
+    }
+    return s;
+}
+
+void
+ListenerExecutor::state::run(std::shared_ptr<state> st, size_t index)
+{
+    current_state = st.get();
+    current_index = index;
+
+    std::unique_lock<std::mutex> lock(st->mutex);
+    while (true) {
+        strand_ref s = st->take(index);
+        if (!s) {
+            /* Pending work is still done at termination. */
+            if (st->terminate) {
+                break;
+            }
+            st->work_cond.wait(lock);
+            continue;
+        }
+        if (s->tasks.empty()) {
+            /* All its tasks were cancelled in the meantime. */
+            s->scheduled = false;
+            continue;
+        }
+
+        strand::entry e(std::move(s->tasks.front()));
+        s->tasks.pop_front();
+        if (e.coalescable) {
+            s->coalesced = false;
+        }
+        s->running = true;
+        s->runner = std::this_thread::get_id();
+        lock.unlock();
+
+        try {
+            e.task(true);
+        } catch (...) {
+            /* Never let an exception end a worker thread. */
+        }
+
+        lock.lock();
+        s->running = false;
+        s->runner = std::thread::id();
+        st->pending--;
+        if (s->tasks.empty()) {
+            s->scheduled = false;
+        } else {
+            /* One task at a time, so that busy strands do not starve others. */
+            st->ready[index].push_back(s);
+            if (st->ready[index].size() > 1) {
+                st->work_cond.notify_one();
+            }
+        }
+        st->idle_cond.notify_all();
+    }
+}
+
+ListenerExecutor::ListenerExecutor(
+    uint32_t threads,
+    size_t capacity,
+    bool coalesce)
+{
+    ISOCPP_BOOL_CHECK_AND_THROW(capacity > 0, ISOCPP_INVALID_ARGUMENT_ERROR,
+                                "The capacity of a listener executor must be at least 1.");
+
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+        if (threads == 0) {
+            threads = 1;
+        }
+    }
+
+    this->state_ = std::make_shared<state>(threads, capacity, coalesce);
+    for (uint32_t i = 0; i < threads; i++) {
+        this->threads_.push_back(std::thread(&state::run, this->state_, static_cast<size_t>(i)));
+    }
+}
+
+ListenerExecutor::~ListenerExecutor()
+{
+    std::unique_lock<std::mutex> lock(this->state_->mutex);
+    this->state_->terminate = true;
+    lock.unlock();
+    this->state_->work_cond.notify_all();
+    this->state_->idle_cond.notify_all();
+
+    for (std::vector<std::thread>::iterator it = this->threads_.begin(); it != this->threads_.end(); ++it) {
+        if (it->get_id() == std::this_thread::get_id()) {
+            it->detach();
+        } else {
+            it->join();
+        }
+    }
+}
+
+ListenerExecutor::strand_ref
+ListenerExecutor::create_strand()
+{
+    return std::make_shared<strand>();
+}
+
+/* Runs a task of an idle strand on the calling thread. The strand counts as
+ * scheduled meanwhile, so that the tasks that are submitted in the meantime
+ * are queued behind it instead of being handed to a worker. */
+void
+ListenerExecutor::state::run_inline(
+    state& st,
+    const strand_ref& s,
+    std::unique_lock<std::mutex>& lock,
+    task_type&& task)
+{
+    s->scheduled = true;
+    s->running = true;
+    s->runner = std::this_thread::get_id();
+    lock.unlock();
+
+    try {
+        task(true);
+    } catch (...) {
+        /* Like on a worker. */
+    }
+
+    lock.lock();
+    s->running = false;
+    s->runner = std::thread::id();
+    if (s->tasks.empty()) {
+        s->scheduled = false;
+    } else {
+        st.ready[st.next++ % st.ready.size()].push_back(s);
+        st.work_cond.notify_one();
+    }
+    st.idle_cond.notify_all();
+}
+
+ListenerExecutor::submit_result
+ListenerExecutor::submit(
+    const strand_ref& s,
+    task_type&& task,
+    bool coalescable)
+{
+    state& st = *this->state_;
+    std::unique_lock<std::mutex> lock(st.mutex);
+
+    coalescable = coalescable && st.coalesce;
+    if (coalescable && s->coalesced) {
+        return coalesced;
+    }
+    if (st.pending >= st.capacity && !st.terminate && !st.is_worker()) {
+        st.overflows++;
+        /* Running the task here while the strand has work would overtake that
+         * work, or run concurrently with it: it is queued past the bound then. */
+        if (!s->scheduled) {
+            state::run_inline(st, s, lock, std::move(task));
+            return full;
+        }
+    }
+
+    s->tasks.emplace_back(std::move(task), coalescable);
+    if (coalescable) {
+        s->coalesced = true;
+    }
+    st.pending++;
+
+    if (!s->scheduled) {
+        s->scheduled = true;
+        /* Work submitted from within a callback stays with that worker. */
+        size_t index = st.is_worker() ? current_index : (st.next++ % st.ready.size());
+        st.ready[index].push_back(s);
+        /* Notified while locked: the task may well release the executor. */
+        st.work_cond.notify_one();
+    }
+    return queued;
+}
+
+void
+ListenerExecutor::cancel(const strand_ref& s)
+{
+    state& st = *this->state_;
+    std::deque<strand::entry> cancelled;
+    std::unique_lock<std::mutex> lock(st.mutex);
+
+    cancelled.swap(s->tasks);
+    st.pending -= cancelled.size();
+    s->coalesced = false;
+    if (!cancelled.empty()) {
+        st.idle_cond.notify_all();
+    }
+    st.idle_cond.wait(lock, [&s] {
+        return !s->running || s->runner == std::this_thread::get_id();
+    });
+    lock.unlock();
+
+    for (std::deque<strand::entry>::iterator it = cancelled.begin(); it != cancelled.end(); ++it) {
+        try {
+            it->task(false);
+        } catch (...) {
+            /* A cancelled task has nobody to report to either. */
+        }
+    }
+}
+
+void
+ListenerExecutor::quiesce(const strand_ref& s)
+{
+    state& st = *this->state_;
+    std::unique_lock<std::mutex> lock(st.mutex);
+
+    st.idle_cond.wait(lock, [&s] {
+        return !s->running || s->runner == std::this_thread::get_id();
+    });
+}
+
+void
+ListenerExecutor::drain(const strand_ref& s)
+{
+    state& st = *this->state_;
+    std::unique_lock<std::mutex> lock(st.mutex);
+
+    st.idle_cond.wait(lock, [&s] {
+        return (s->running && s->runner == std::this_thread::get_id()) ||
+               (!s->running && s->tasks.empty());
+    });
+}
+
+uint32_t
+ListenerExecutor::threads() const
+{
+    return static_cast<uint32_t>(this->threads_.size());
+}
+
+size_t
+ListenerExecutor::capacity() const
+{
+    return this->state_->capacity;
+}
+
+bool
+ListenerExecutor::coalesce() const
+{
+    return this->state_->coalesce;
+}
+
+uint64_t
+ListenerExecutor::overflows() const
+{
+    std::lock_guard<std::mutex> lock(this->state_->mutex);
+    return this->state_->overflows;
+}
+
+}
+}
+}
+}
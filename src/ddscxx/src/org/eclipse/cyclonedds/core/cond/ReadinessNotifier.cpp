@@ -0,0 +1,299 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+
+
+/**
+ * @file
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#include <unistd.h>
+#elif !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <org/eclipse/cyclonedds/core/cond/ReadinessNotifier.hpp>
+#include <org/eclipse/cyclonedds/core/ReportUtils.hpp>
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace core
+{
+namespace cond
+{
+
+/*
+ * Waits for the conditions of all armed notifiers. A condition is attached to
+ * the waitset of the watcher for as long as at least one of the notifiers that
+ * contain it is armed, with the condition itself as the attach argument.
+ */
+class ReadinessNotifier::watcher
+{
+public:
+    static watcher& instance()
+    {
+        static watcher w;
+        return w;
+    }
+
+    std::mutex mutex;
+
+    /* The functions below are invoked with the lock held. */
+    void watch(ReadinessNotifier *notifier, dds_entity_t condition)
+    {
+        this->start();
+        this->entries_[condition].notifiers.push_back(notifier);
+    }
+
+    void unwatch(ReadinessNotifier *notifier, dds_entity_t condition)
+    {
+        std::map<dds_entity_t, entry>::iterator it = this->entries_.find(condition);
+        if (it != this->entries_.end()) {
+            std::vector<ReadinessNotifier*>& n = it->second.notifiers;
+            n.erase(std::find(n.begin(), n.end(), notifier));
+            if (n.empty()) {
+                this->entries_.erase(it);
+            }
+        }
+    }
+
+    /* Failures are ignored: a condition of which the entity has already been
+     * deleted simply never triggers. */
+    void arm(dds_entity_t condition)
+    {
+        if (this->entries_[condition].armed++ == 0) {
+            (void) dds_waitset_attach(this->waitset_, condition, static_cast<dds_attach_t>(condition));
+        }
+    }
+
+    void disarm(dds_entity_t condition)
+    {
+        if (--this->entries_[condition].armed == 0) {
+            (void) dds_waitset_detach(this->waitset_, condition);
+        }
+    }
+
+private:
+    struct entry {
+        entry() : armed(0) { }
+        std::vector<ReadinessNotifier*> notifiers;
+        size_t armed;
+    };
+
+    watcher() : waitset_(0), guard_(0), terminate_(false) { }
+
+    ~watcher()
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->terminate_ = true;
+        lock.unlock();
+        if (this->thread_.joinable()) {
+            (void) dds_set_guardcondition(this->guard_, true);
+            this->thread_.join();
+            (void) dds_delete(this->waitset_);
+            (void) dds_delete(this->guard_);
+        }
+    }
+
+    void start()
+    {
+        if (this->thread_.joinable()) {
+            return;
+        }
+
+        dds_entity_t ws = dds_create_waitset(DDS_CYCLONEDDS_HANDLE);
+        ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ws, "Could not create waitset of readiness watcher.");
+        dds_entity_t gc = dds_create_guardcondition(DDS_CYCLONEDDS_HANDLE);
+        if (gc < 0) {
+            (void) dds_delete(ws);
+            ISOCPP_DDSC_RESULT_CHECK_AND_THROW(gc, "Could not create guard condition of readiness watcher.");
+        }
+        dds_return_t ret = dds_waitset_attach(ws, gc, static_cast<dds_attach_t>(gc));
+        if (ret != DDS_RETCODE_OK) {
+            (void) dds_delete(gc);
+            (void) dds_delete(ws);
+            ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Could not attach guard condition of readiness watcher.");
+        }
+
+        this->waitset_ = ws;
+        this->guard_ = gc;
+        this->thread_ = std::thread(&watcher::run, this);
+    }
+
+    void run()
+    {
+        std::vector<dds_attach_t> triggered;
+        std::unique_lock<std::mutex> lock(this->mutex);
+
+        while (!this->terminate_) {
+            triggered.resize(this->entries_.size() + 1);
+            lock.unlock();
+            dds_return_t n = dds_waitset_wait(this->waitset_, triggered.data(), triggered.size(), DDS_INFINITY);
+            lock.lock();
+            if (n < 0) {
+                break;
+            }
+
+            /* Conditions that did not fit are still triggered next time. */
+            size_t nt = std::min(static_cast<size_t>(n), triggered.size());
+            for (size_t i = 0; i < nt; i++) {
+                dds_entity_t condition = static_cast<dds_entity_t>(triggered[i]);
+                if (condition == this->guard_) {
+                    (void) dds_set_guardcondition(this->guard_, false);
+                    continue;
+                }
+                /* It may have been detached in the meantime. */
+                std::map<dds_entity_t, entry>::iterator it = this->entries_.find(condition);
+                if (it != this->entries_.end()) {
+                    std::vector<ReadinessNotifier*>& notifiers = it->second.notifiers;
+                    for (std::vector<ReadinessNotifier*>::iterator nit = notifiers.begin(); nit != notifiers.end(); ++nit) {
+                        (*nit)->fire();
+                    }
+                }
+            }
+        }
+    }
+
+    std::map<dds_entity_t, entry> entries_;
+    dds_entity_t waitset_;
+    dds_entity_t guard_;
+    bool terminate_;
+    std::thread thread_;
+};
+
+ReadinessNotifier::ReadinessNotifier() :
+    armed_(true)
+{
+#if defined(_WIN32)
+    ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR, "Readiness notification is not supported on this platform.");
+#elif defined(__linux__)
+    this->fds_[0] = this->fds_[1] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    ISOCPP_BOOL_CHECK_AND_THROW(this->fds_[0] >= 0, ISOCPP_OUT_OF_RESOURCES_ERROR, "Could not create eventfd.");
+#else
+    ISOCPP_BOOL_CHECK_AND_THROW(pipe(this->fds_) == 0, ISOCPP_OUT_OF_RESOURCES_ERROR, "Could not create pipe.");
+    for (int i = 0; i < 2; i++) {
+        (void) fcntl(this->fds_[i], F_SETFL, fcntl(this->fds_[i], F_GETFL) | O_NONBLOCK);
+        (void) fcntl(this->fds_[i], F_SETFD, FD_CLOEXEC);
+    }
+#endif
+}
+
+ReadinessNotifier::~ReadinessNotifier()
+{
+    watcher& w = watcher::instance();
+    std::unique_lock<std::mutex> lock(w.mutex);
+    for (std::vector<dds_entity_t>::iterator it = this->conditions_.begin(); it != this->conditions_.end(); ++it) {
+        if (this->armed_) {
+            w.disarm(*it);
+        }
+        w.unwatch(this, *it);
+    }
+    lock.unlock();
+
+#if !defined(_WIN32)
+    (void) close(this->fds_[0]);
+    if (this->fds_[1] != this->fds_[0]) {
+        (void) close(this->fds_[1]);
+    }
+#endif
+}
+
+int
+ReadinessNotifier::fd() const
+{
+    return this->fds_[0];
+}
+
+void
+ReadinessNotifier::add(dds_entity_t condition)
+{
+    watcher& w = watcher::instance();
+    std::unique_lock<std::mutex> lock(w.mutex);
+    w.watch(this, condition);
+    this->conditions_.push_back(condition);
+    if (this->armed_) {
+        w.arm(condition);
+    }
+}
+
+void
+ReadinessNotifier::remove(dds_entity_t condition)
+{
+    watcher& w = watcher::instance();
+    std::unique_lock<std::mutex> lock(w.mutex);
+    std::vector<dds_entity_t>::iterator it =
+        std::find(this->conditions_.begin(), this->conditions_.end(), condition);
+    if (it != this->conditions_.end()) {
+        if (this->armed_) {
+            w.disarm(condition);
+        }
+        w.unwatch(this, condition);
+        this->conditions_.erase(it);
+    }
+}
+
+void
+ReadinessNotifier::rearm()
+{
+    watcher& w = watcher::instance();
+    std::unique_lock<std::mutex> lock(w.mutex);
+
+#if !defined(_WIN32)
+    uint64_t buf;
+    while (read(this->fds_[0], &buf, sizeof(buf)) > 0) { }
+#endif
+
+    if (!this->armed_) {
+        this->armed_ = true;
+        for (std::vector<dds_entity_t>::iterator it = this->conditions_.begin(); it != this->conditions_.end(); ++it) {
+            w.arm(*it);
+        }
+    }
+}
+
+void
+ReadinessNotifier::fire()
+{
+    if (!this->armed_) {
+        return;
+    }
+
+    watcher& w = watcher::instance();
+    this->armed_ = false;
+    for (std::vector<dds_entity_t>::iterator it = this->conditions_.begin(); it != this->conditions_.end(); ++it) {
+        w.disarm(*it);
+    }
+
+#if !defined(_WIN32)
+    uint64_t one = 1;
+    /* A full pipe is readable already. */
+    (void) !write(this->fds_[1], &one, (this->fds_[1] == this->fds_[0]) ? sizeof(one) : 1);
+#endif
+}
+
+}
+}
+}
+}
+}
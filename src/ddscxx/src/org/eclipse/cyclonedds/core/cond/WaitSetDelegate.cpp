@@ -15,6 +15,8 @@
  * @file
  */
 
+#include <algorithm>
+
 #include <dds/domain/DomainParticipant.hpp>
 #include <org/eclipse/cyclonedds/core/MiscUtils.hpp>
 #include <org/eclipse/cyclonedds/core/cond/WaitSetDelegate.hpp>
@@ -56,6 +58,7 @@ org::eclipse::cyclonedds::core::cond::WaitSetDelegate::close()
     org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
 
     conditions_.clear ();
+    notifier_.reset ();
 
     org::eclipse::cyclonedds::core::DDScObjectDelegate::close();
 }
@@ -65,32 +68,11 @@ org::eclipse::cyclonedds::core::cond::WaitSetDelegate::wait(
     ConditionSeq& triggered,
     const dds::core::Duration& timeout)
 {
-    dds_duration_t c_timeout = org::eclipse::cyclonedds::core::convertDuration(timeout);
-    const size_t sz = conditions_.size();
-    dds_attach_t * attach = new dds_attach_t[sz];
-    memset (attach, 0, sizeof(dds_attach_t) * sz);
-
-    dds_return_t n_triggered = dds_waitset_wait(this->get_ddsc_entity(), attach, sz, c_timeout);
-
-    if (n_triggered == 0) {
-        delete[] attach;
+    dds_return_t ret = this->try_wait(triggered, timeout);
+    if (ret == DDS_RETCODE_TIMEOUT) {
         ISOCPP_THROW_EXCEPTION(ISOCPP_TIMEOUT_ERROR, "dds::core::cond::WaitSet::wait() timed out.");
-    } else if (n_triggered > 0) {
-        const size_t nt = size_t(n_triggered);
-        triggered.reserve(nt);
-
-        for (size_t i = 0; i < nt && i < sz; i++) {
-            org::eclipse::cyclonedds::core::cond::ConditionDelegate *cd =
-                reinterpret_cast <org::eclipse::cyclonedds::core::cond::ConditionDelegate *>(attach[i]);
-            assert(cd);
-            cd->dispatch();
-            triggered.push_back(cd->wrapper());
-        }
-        delete[] attach;
-    } else {
-        delete[] attach;
-        ISOCPP_DDSC_RESULT_CHECK_AND_THROW(n_triggered, "dds_waitset_wait failed");
     }
+    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "dds_waitset_wait failed");
 
     return triggered;
 }
@@ -99,20 +81,53 @@ void
 org::eclipse::cyclonedds::core::cond::WaitSetDelegate::dispatch(
     const dds::core::Duration& timeout)
 {
-    ConditionSeq triggered;
-    try {
-        wait(triggered, timeout);
+    dds_return_t ret = this->try_dispatch(timeout);
+    if (ret == DDS_RETCODE_TIMEOUT) {
+        ISOCPP_THROW_EXCEPTION(ISOCPP_TIMEOUT_ERROR, "dds::core::cond::WaitSet::dispatch() timed out.");
     }
-    catch(dds::core::TimeoutError &) {
-        ISOCPP_THROW_EXCEPTION(ISOCPP_TIMEOUT_ERROR,
-            "dds::core::cond::WaitSet::dispatch() timed out.");
+    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "dds_waitset_wait failed");
+}
+
+dds_return_t
+org::eclipse::cyclonedds::core::cond::WaitSetDelegate::try_wait(
+    ConditionSeq& triggered,
+    const dds::core::Duration& timeout)
+{
+    dds_duration_t c_timeout = org::eclipse::cyclonedds::core::convertDuration(timeout);
+    std::vector<dds_attach_t> attach(conditions_.size());
+
+    dds_return_t n_triggered = dds_waitset_wait(this->get_ddsc_entity(), attach.data(), attach.size(), c_timeout);
+    if (n_triggered == 0) {
+        return DDS_RETCODE_TIMEOUT;
+    } else if (n_triggered < 0) {
+        return n_triggered;
     }
-    catch(...) {
-        throw;
+
+    const size_t nt = std::min(size_t(n_triggered), attach.size());
+    triggered.reserve(triggered.size() + nt);
+    for (size_t i = 0; i < nt; i++) {
+        org::eclipse::cyclonedds::core::cond::ConditionDelegate *cd =
+            reinterpret_cast <org::eclipse::cyclonedds::core::cond::ConditionDelegate *>(attach[i]);
+        assert(cd);
+        cd->dispatch();
+        triggered.push_back(cd->wrapper());
     }
-    for (ConditionSeq::iterator it = triggered.begin(); it != triggered.end(); ++it) {
-        it->dispatch();
+
+    return DDS_RETCODE_OK;
+}
+
+dds_return_t
+org::eclipse::cyclonedds::core::cond::WaitSetDelegate::try_dispatch(
+    const dds::core::Duration& timeout)
+{
+    ConditionSeq triggered;
+    dds_return_t ret = this->try_wait(triggered, timeout);
+    if (ret == DDS_RETCODE_OK) {
+        for (ConditionSeq::iterator it = triggered.begin(); it != triggered.end(); ++it) {
+            it->dispatch();
+        }
     }
+    return ret;
 }
 
 void
@@ -138,6 +153,10 @@ org::eclipse::cyclonedds::core::cond::WaitSetDelegate::attach_condition(
         ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Failed to attach condition");
 
         conditions_.insert(ConditionEntry(cond_delegate, cond));
+        poll_buffer_.resize(conditions_.size());
+        if (notifier_) {
+            notifier_->add(cond.delegate()->get_ddsc_entity());
+        }
     }
 }
 
@@ -159,6 +178,9 @@ org::eclipse::cyclonedds::core::cond::WaitSetDelegate::detach_condition(
 
         ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Failed to detach condition");
 
+        if (notifier_) {
+            notifier_->remove(cond->get_ddsc_entity());
+        }
         conditions_.erase(cond);
         result = true;
     }
@@ -194,3 +216,50 @@ org::eclipse::cyclonedds::core::cond::WaitSetDelegate::conditions(
     return conds;
 }
 
+int
+org::eclipse::cyclonedds::core::cond::WaitSetDelegate::notifier_fd()
+{
+    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
+
+    this->check();
+    if (!notifier_) {
+        std::unique_ptr<ReadinessNotifier> notifier(new ReadinessNotifier());
+        for (ConstConditionIterator it = conditions_.begin(); it != conditions_.end(); ++it) {
+            notifier->add(it->first->get_ddsc_entity());
+        }
+        notifier_ = std::move(notifier);
+    }
+
+    return notifier_->fd();
+}
+
+org::eclipse::cyclonedds::core::cond::WaitSetDelegate::ConditionSeq&
+org::eclipse::cyclonedds::core::cond::WaitSetDelegate::poll_triggered(
+    ConditionSeq& triggered)
+{
+    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
+
+    this->check();
+    triggered.clear();
+
+    /* Rearm first: a condition that triggers after it was polled then makes
+     * the descriptor readable again instead of getting lost. */
+    if (notifier_) {
+        notifier_->rearm();
+    }
+
+    dds_return_t n_triggered = dds_waitset_wait(this->get_ddsc_entity(),
+        poll_buffer_.data(), poll_buffer_.size(), 0);
+    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(n_triggered, "dds_waitset_wait failed");
+
+    const size_t nt = std::min(size_t(n_triggered), poll_buffer_.size());
+    for (size_t i = 0; i < nt; i++) {
+        org::eclipse::cyclonedds::core::cond::ConditionDelegate *cd =
+            reinterpret_cast <org::eclipse::cyclonedds::core::cond::ConditionDelegate *>(poll_buffer_[i]);
+        assert(cd);
+        cd->dispatch();
+        triggered.push_back(cd->wrapper());
+    }
+
+    return triggered;
+}
@@ -0,0 +1,244 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+
+
+/**
+ * @file
+ */
+
+#include <org/eclipse/cyclonedds/domain/DiscoveryCache.hpp>
+#include <org/eclipse/cyclonedds/topic/BuiltinTopicCopy.hpp>
+#include <org/eclipse/cyclonedds/core/ReportUtils.hpp>
+#include <org/eclipse/cyclonedds/core/ScopedLock.hpp>
+
+/* Maximum number of builtin topic samples that are taken in one go. */
+#define DISCOVERY_CACHE_BATCH 16
+
+extern "C"
+{
+  static void discovery_cache_on_data_available(dds_entity_t reader, void *arg)
+  {
+    org::eclipse::cyclonedds::domain::DiscoveryCache *cache =
+        reinterpret_cast<org::eclipse::cyclonedds::domain::DiscoveryCache *>(arg);
+    try {
+        cache->on_data_available(reader);
+    } catch (...) {
+        /* Never let an exception escape into ddsc. */
+    }
+  }
+}
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace domain
+{
+
+/* Updates of one map are serialized by its update mutex, from the take up to
+ * and including applying the samples. Otherwise, the initial update and the
+ * listener, or two listener invocations, could take consecutive batches and
+ * apply them in the wrong order, leaving an older sample in the map. */
+template <typename C, typename D, typename MAP>
+static void
+take_builtin_samples(
+    dds_entity_t reader,
+    const org::eclipse::cyclonedds::core::Mutex& update_mutex,
+    const org::eclipse::cyclonedds::core::Mutex& mutex,
+    MAP& map)
+{
+    void *samples[DISCOVERY_CACHE_BATCH];
+    dds_sample_info_t infos[DISCOVERY_CACHE_BATCH];
+    dds_return_t n;
+
+    org::eclipse::cyclonedds::core::ScopedMutexLock updateLock(update_mutex);
+    do {
+        /* A null pointer as first sample lets ddsc loan the samples. */
+        samples[0] = NULL;
+        n = dds_take(reader, samples, infos, DISCOVERY_CACHE_BATCH, DISCOVERY_CACHE_BATCH);
+        if (n <= 0) {
+            break;
+        }
+
+        org::eclipse::cyclonedds::core::ScopedMutexLock scopedLock(mutex);
+        for (int32_t i = 0; i < n; i++) {
+            const dds_instance_handle_t ih = infos[i].instance_handle;
+            if (infos[i].instance_state != DDS_IST_ALIVE) {
+                map.erase(ih);
+            } else if (infos[i].valid_data) {
+                D data;
+                org::eclipse::cyclonedds::topic::copyOut(*static_cast<const C*>(samples[i]), data);
+                map[ih] = data;
+            }
+        }
+        scopedLock.unlock();
+
+        (void)dds_return_loan(reader, samples, n);
+    } while (n == DISCOVERY_CACHE_BATCH);
+}
+
+template <typename MAP, typename D>
+static bool
+lookup_builtin_sample(
+    const org::eclipse::cyclonedds::core::Mutex& mutex,
+    const MAP& map,
+    dds_instance_handle_t handle,
+    D& data)
+{
+    org::eclipse::cyclonedds::core::ScopedMutexLock scopedLock(mutex);
+    typename MAP::const_iterator it = map.find(handle);
+    if (it == map.end()) {
+        return false;
+    }
+    data = it->second;
+    return true;
+}
+
+DiscoveryCache::DiscoveryCache(dds_entity_t participant)
+    : listener_(NULL),
+      participant_reader_(0),
+      publication_reader_(0),
+      subscription_reader_(0)
+{
+    try {
+        this->participant_reader_ = this->create_reader(participant, DDS_BUILTIN_TOPIC_DCPSPARTICIPANT);
+        this->publication_reader_ = this->create_reader(participant, DDS_BUILTIN_TOPIC_DCPSPUBLICATION);
+        this->subscription_reader_ = this->create_reader(participant, DDS_BUILTIN_TOPIC_DCPSSUBSCRIPTION);
+
+        /* Only attach the listener when all readers are known, so that
+         * the callback can always tell which cache has to be updated.
+         * Samples that arrived before this point are taken explicitly. */
+        this->listener_ = dds_create_listener(this);
+        dds_lset_data_available(this->listener_, discovery_cache_on_data_available);
+        dds_return_t ret;
+        ret = dds_set_listener(this->participant_reader_, this->listener_);
+        ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Could not set DCPSParticipant reader listener.");
+        ret = dds_set_listener(this->publication_reader_, this->listener_);
+        ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Could not set DCPSPublication reader listener.");
+        ret = dds_set_listener(this->subscription_reader_, this->listener_);
+        ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Could not set DCPSSubscription reader listener.");
+    } catch (...) {
+        this->close();
+        throw;
+    }
+
+    this->update_participants();
+    this->update_publications();
+    this->update_subscriptions();
+}
+
+DiscoveryCache::~DiscoveryCache()
+{
+    this->close();
+}
+
+dds_entity_t
+DiscoveryCache::create_reader(dds_entity_t participant, dds_entity_t topic)
+{
+    dds_entity_t reader = dds_create_reader(participant, topic, NULL, NULL);
+    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(reader, "Could not create builtin topic reader.");
+    return reader;
+}
+
+void
+DiscoveryCache::close()
+{
+    /* Deleting a reader waits for any listener callback that is still
+     * running on it, so the cache can safely be destroyed afterwards. */
+    if (this->participant_reader_ > 0) {
+        (void)dds_delete(this->participant_reader_);
+        this->participant_reader_ = 0;
+    }
+    if (this->publication_reader_ > 0) {
+        (void)dds_delete(this->publication_reader_);
+        this->publication_reader_ = 0;
+    }
+    if (this->subscription_reader_ > 0) {
+        (void)dds_delete(this->subscription_reader_);
+        this->subscription_reader_ = 0;
+    }
+    if (this->listener_) {
+        dds_delete_listener(this->listener_);
+        this->listener_ = NULL;
+    }
+
+    org::eclipse::cyclonedds::core::ScopedMutexLock scopedLock(this->mutex_);
+    this->participants_.clear();
+    this->publications_.clear();
+    this->subscriptions_.clear();
+}
+
+void
+DiscoveryCache::on_data_available(dds_entity_t reader)
+{
+    if (reader == this->participant_reader_) {
+        this->update_participants();
+    } else if (reader == this->publication_reader_) {
+        this->update_publications();
+    } else if (reader == this->subscription_reader_) {
+        this->update_subscriptions();
+    }
+}
+
+void
+DiscoveryCache::update_participants()
+{
+    take_builtin_samples<dds_builtintopic_participant_t, dds::topic::ParticipantBuiltinTopicData>(
+        this->participant_reader_, this->participant_update_mutex_, this->mutex_, this->participants_);
+}
+
+void
+DiscoveryCache::update_publications()
+{
+    take_builtin_samples<dds_builtintopic_endpoint_t, dds::topic::PublicationBuiltinTopicData>(
+        this->publication_reader_, this->publication_update_mutex_, this->mutex_, this->publications_);
+}
+
+void
+DiscoveryCache::update_subscriptions()
+{
+    take_builtin_samples<dds_builtintopic_endpoint_t, dds::topic::SubscriptionBuiltinTopicData>(
+        this->subscription_reader_, this->subscription_update_mutex_, this->mutex_, this->subscriptions_);
+}
+
+bool
+DiscoveryCache::participant_data(
+    dds_instance_handle_t handle,
+    dds::topic::ParticipantBuiltinTopicData& data) const
+{
+    /* Participants are not matched: all those that are discovered by the
+     * participant of the cache are visible to it, and no others are cached. */
+    return lookup_builtin_sample(this->mutex_, this->participants_, handle, data);
+}
+
+bool
+DiscoveryCache::publication_data(
+    dds_instance_handle_t handle,
+    dds::topic::PublicationBuiltinTopicData& data) const
+{
+    return lookup_builtin_sample(this->mutex_, this->publications_, handle, data);
+}
+
+bool
+DiscoveryCache::subscription_data(
+    dds_instance_handle_t handle,
+    dds::topic::SubscriptionBuiltinTopicData& data) const
+{
+    return lookup_builtin_sample(this->mutex_, this->subscriptions_, handle, data);
+}
+
+}
+}
+}
+}
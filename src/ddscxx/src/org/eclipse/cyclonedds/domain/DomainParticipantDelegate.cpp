@@ -26,11 +26,13 @@
 #include <org/eclipse/cyclonedds/domain/DomainParticipantDelegate.hpp>
 #include <org/eclipse/cyclonedds/domain/DomainParticipantRegistry.hpp>
 #include <org/eclipse/cyclonedds/domain/DomainParticipantListener.hpp>
+#include <org/eclipse/cyclonedds/domain/DiscoveryCache.hpp>
 #include <org/eclipse/cyclonedds/core/ReportUtils.hpp>
 #include <org/eclipse/cyclonedds/core/MiscUtils.hpp>
 #include <org/eclipse/cyclonedds/core/ScopedLock.hpp>
 #include <org/eclipse/cyclonedds/core/ListenerDispatcher.hpp>
 #include <org/eclipse/cyclonedds/pub/AnyDataWriterDelegate.hpp>
+#include <org/eclipse/cyclonedds/pub/AcknowledgmentWaiter.hpp>
 #include <org/eclipse/cyclonedds/sub/AnyDataReaderDelegate.hpp>
 #include <org/eclipse/cyclonedds/sub/SubscriberDelegate.hpp>
 #include <org/eclipse/cyclonedds/topic/AnyTopicDelegate.hpp>
@@ -52,7 +54,7 @@ org::eclipse::cyclonedds::domain::DomainParticipantDelegate::DomainParticipantDe
   : domain_id_ (id), qos_(qos)
 {
     org::eclipse::cyclonedds::domain::DomainWrap::map_ref_iter it;
-    dds_qos_t* ddsc_qos;
+    org::eclipse::cyclonedds::core::DdscQosCache::qos_ref ddsc_qos;
     dds_domainid_t did;
     dds_return_t ret;
 
@@ -80,10 +82,8 @@ org::eclipse::cyclonedds::domain::DomainParticipantDelegate::DomainParticipantDe
         }
     }
 
-    ddsc_qos = qos.delegate().ddsc_qos();
-    ddsc_par = dds_create_participant(static_cast<dds_domainid_t>(domain_id_), ddsc_qos, NULL);
-
-    dds_delete_qos (ddsc_qos);
+    ddsc_qos = qos.delegate().cached_ddsc_qos();
+    ddsc_par = dds_create_participant(static_cast<dds_domainid_t>(domain_id_), ddsc_qos.get(), NULL);
     ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ddsc_par, "Could not create DomainParticipant.");
 
     /* Domain id is possibly changed when using default_id() */
@@ -123,13 +123,13 @@ org::eclipse::cyclonedds::domain::DomainParticipantDelegate::DomainParticipantDe
   : domain_id_(id), qos_(qos)
 {
     org::eclipse::cyclonedds::domain::DomainWrap::map_ref_iter it;
-    dds_qos_t * ddsc_qos;
+    org::eclipse::cyclonedds::core::DdscQosCache::qos_ref ddsc_qos;
     dds_domainid_t did;
     dds_return_t ret;
 
     /* Validate the qos and get the corresponding ddsc qos. */
     qos.delegate().check();
-    ddsc_qos = qos.delegate().ddsc_qos();
+    ddsc_qos = qos.delegate().cached_ddsc_qos();
 
     dds_entity_t ddsc_par;
 
@@ -146,9 +146,7 @@ org::eclipse::cyclonedds::domain::DomainParticipantDelegate::DomainParticipantDe
        * that one automatically. */
     }
 
-    ddsc_par = dds_create_participant(static_cast<dds_domainid_t>(id), ddsc_qos, NULL);
-
-    dds_delete_qos(ddsc_qos);
+    ddsc_par = dds_create_participant(static_cast<dds_domainid_t>(id), ddsc_qos.get(), NULL);
     ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ddsc_par, "Could not create DomainParticipant.");
 
     /* Domain id is possibly changed when using default_id() */
@@ -206,7 +204,8 @@ org::eclipse::cyclonedds::domain::DomainParticipantDelegate::assert_liveliness()
 {
     org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
     this->check();
-    ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR, "Function not currently supported");
+    dds_return_t ret = dds_assert_liveliness(this->ddsc_entity);
+    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Could not assert liveliness.");
 }
 
 bool
@@ -256,10 +255,9 @@ org::eclipse::cyclonedds::domain::DomainParticipantDelegate::qos(
     this->check();
     qos.delegate().check();
 
-    dds_qos_t* p_qos = qos.delegate().ddsc_qos();
+    org::eclipse::cyclonedds::core::DdscQosCache::qos_ref p_qos = qos.delegate().cached_ddsc_qos();
 
-    dds_return_t ret = dds_set_qos(this->ddsc_entity, p_qos);
-    dds_delete_qos(p_qos);
+    dds_return_t ret = dds_set_qos(this->ddsc_entity, p_qos.get());
 
     ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Could not set participant qos.");
 
@@ -270,6 +268,20 @@ void
 org::eclipse::cyclonedds::domain::DomainParticipantDelegate::close()
 {
     org::eclipse::cyclonedds::domain::DomainWrap::map_ref_iter it;
+    org::eclipse::cyclonedds::pub::AcknowledgmentWaiter::ref_type waiter;
+
+    /* Fail the pending asynchronous acknowledgment waits first, without
+     * holding the lock, as their callbacks may use the participant. The
+     * closed waiter stays in place, so no new waits can be started. */
+    {
+        org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
+        this->check();
+        waiter = this->acknowledgment_waiter_;
+    }
+    if (waiter) {
+        waiter->close();
+    }
+
     org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
     this->check();
 
@@ -278,6 +290,18 @@ org::eclipse::cyclonedds::domain::DomainParticipantDelegate::close()
     this->cfTopics.all_close();
     this->topics.all_close();
 
+    /* Stop updating the discovery data. */
+    if (this->discovery_cache_) {
+        this->discovery_cache_->close();
+        this->discovery_cache_.reset();
+    }
+
+    /* Closed above already, unless it was created in the meantime. */
+    if (this->acknowledgment_waiter_) {
+        this->acknowledgment_waiter_->close();
+        this->acknowledgment_waiter_.reset();
+    }
+
     /* Stop listener. */
     this->listener_set(NULL, dds::core::status::StatusMask::none());
 
@@ -394,6 +418,11 @@ org::eclipse::cyclonedds::domain::DomainParticipantDelegate::add_publisher(
         org::eclipse::cyclonedds::core::EntityDelegate& publisher)
 {
     this->publishers.insert(publisher);
+
+    /* Callbacks go to the executor of the parent, unless told otherwise. */
+    if (!publisher.has_listener_executor()) {
+        publisher.listener_executor(this->listener_executor());
+    }
 }
 
 void
@@ -408,6 +437,11 @@ org::eclipse::cyclonedds::domain::DomainParticipantDelegate::add_subscriber(
         org::eclipse::cyclonedds::core::EntityDelegate& subscriber)
 {
     this->subscribers.insert(subscriber);
+
+    /* Callbacks go to the executor of the parent, unless told otherwise. */
+    if (!subscriber.has_listener_executor()) {
+        subscriber.listener_executor(this->listener_executor());
+    }
 }
 
 void
@@ -422,6 +456,11 @@ org::eclipse::cyclonedds::domain::DomainParticipantDelegate::add_topic(
         org::eclipse::cyclonedds::core::EntityDelegate& topic)
 {
     this->topics.insert(topic);
+
+    /* Callbacks go to the executor of the parent, unless told otherwise. */
+    if (!topic.has_listener_executor()) {
+        topic.listener_executor(this->listener_executor());
+    }
 }
 
 void
@@ -589,6 +628,37 @@ org::eclipse::cyclonedds::domain::DomainParticipantDelegate::builtin_subscriber(
     this->builtin_subscriber_ = subscriber;
 }
 
+org::eclipse::cyclonedds::domain::DiscoveryCache::ref_type
+org::eclipse::cyclonedds::domain::DomainParticipantDelegate::discovery_cache()
+{
+    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
+    this->check();
+
+    /* Created on first use: participants that never look at discovery
+     * data do not pay for the builtin topic readers. */
+    if (!this->discovery_cache_) {
+        this->discovery_cache_.reset(
+            new org::eclipse::cyclonedds::domain::DiscoveryCache(this->ddsc_entity));
+    }
+
+    return this->discovery_cache_;
+}
+
+::dds::core::smart_ptr_traits< org::eclipse::cyclonedds::pub::AcknowledgmentWaiter >::ref_type
+org::eclipse::cyclonedds::domain::DomainParticipantDelegate::acknowledgment_waiter()
+{
+    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
+    this->check();
+
+    /* Created on first use, like the discovery cache. */
+    if (!this->acknowledgment_waiter_) {
+        this->acknowledgment_waiter_.reset(
+            new org::eclipse::cyclonedds::pub::AcknowledgmentWaiter());
+    }
+
+    return this->acknowledgment_waiter_;
+}
+
 
 void org::eclipse::cyclonedds::domain::DomainParticipantDelegate::ignore_participant(
     const ::dds::core::InstanceHandle& handle)
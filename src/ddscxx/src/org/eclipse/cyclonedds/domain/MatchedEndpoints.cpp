@@ -0,0 +1,113 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+
+
+/**
+ * @file
+ */
+
+#include <org/eclipse/cyclonedds/domain/MatchedEndpoints.hpp>
+#include <org/eclipse/cyclonedds/core/ScopedLock.hpp>
+
+#include <vector>
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace domain
+{
+
+MatchedEndpoints::MatchedEndpoints(get_matched_fn get_matched)
+    : get_matched_(get_matched),
+      valid_(false)
+{
+}
+
+bool
+MatchedEndpoints::contains(
+    dds_entity_t entity,
+    dds_instance_handle_t handle,
+    bool tracked)
+{
+    org::eclipse::cyclonedds::core::ScopedMutexLock scopedLock(this->mutex_);
+    if (!this->valid_ || !tracked) {
+        this->resync(entity);
+        this->valid_ = tracked;
+    }
+    return this->handles_.find(handle) != this->handles_.end();
+}
+
+void
+MatchedEndpoints::update(
+    dds_entity_t entity,
+    dds_instance_handle_t last_handle,
+    uint32_t current_count)
+{
+    org::eclipse::cyclonedds::core::ScopedMutexLock scopedLock(this->mutex_);
+    /* Nothing to keep up to date until the first lookup. */
+    if (!this->valid_) {
+        return;
+    }
+
+    /* The set may already hold the change when it was read in between the
+     * match and this update, which is why the handle is added or removed
+     * depending on the count instead of on the count change. */
+    if (current_count > this->handles_.size()) {
+        (void)this->handles_.insert(last_handle);
+    } else if (current_count < this->handles_.size()) {
+        (void)this->handles_.erase(last_handle);
+    }
+    if (current_count != this->handles_.size()) {
+        this->resync(entity);
+    }
+}
+
+void
+MatchedEndpoints::clear()
+{
+    org::eclipse::cyclonedds::core::ScopedMutexLock scopedLock(this->mutex_);
+    this->handles_.clear();
+    this->valid_ = false;
+}
+
+void
+MatchedEndpoints::resync(dds_entity_t entity)
+{
+    std::vector<dds_instance_handle_t> handles;
+    dds_return_t n;
+
+    this->handles_.clear();
+
+    /* The number of matches can change in between both calls. */
+    do {
+        n = this->get_matched_(entity, NULL, 0);
+        if (n <= 0) {
+            return;
+        }
+        handles.resize(static_cast<size_t>(n));
+        n = this->get_matched_(entity, handles.data(), handles.size());
+        if (n <= 0) {
+            return;
+        }
+    } while (static_cast<size_t>(n) > handles.size());
+    handles.resize(static_cast<size_t>(n));
+
+    this->handles_.insert(handles.begin(), handles.end());
+}
+
+}
+}
+}
+}
@@ -38,7 +38,8 @@ DomainParticipantQosDelegate::DomainParticipantQosDelegate()
 DomainParticipantQosDelegate::DomainParticipantQosDelegate(
     const DomainParticipantQosDelegate& other)
     :  user_data_(other.user_data_),
-       entity_factory_(other.entity_factory_)
+       entity_factory_(other.entity_factory_),
+       ddsc_qos_cache_(other.ddsc_qos_cache_)
 {
 }
 
@@ -51,6 +52,7 @@ DomainParticipantQosDelegate::policy(const dds::core::policy::UserData& user_dat
 {
     user_data.delegate().check();
     user_data_ = user_data;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -58,6 +60,7 @@ DomainParticipantQosDelegate::policy(const dds::core::policy::EntityFactory& ent
 {
     entity_factory.delegate().check();
     entity_factory_ = entity_factory;
+    ddsc_qos_cache_.invalidate();
 }
 
 dds_qos_t*
@@ -69,10 +72,21 @@ DomainParticipantQosDelegate::ddsc_qos() const
     return qos;
 }
 
+org::eclipse::cyclonedds::core::DdscQosCache::qos_ref
+DomainParticipantQosDelegate::cached_ddsc_qos() const
+{
+    org::eclipse::cyclonedds::core::DdscQosCache::qos_ref qos = ddsc_qos_cache_.get();
+    if (!qos) {
+        qos = ddsc_qos_cache_.set(ddsc_qos());
+    }
+    return qos;
+}
+
 void
 DomainParticipantQosDelegate::ddsc_qos(const dds_qos_t* qos)
 {
     assert(qos);
+    ddsc_qos_cache_.invalidate();
     user_data_.delegate().set_iso_policy(qos);
     entity_factory_.delegate().set_iso_policy(qos);
 }
@@ -113,6 +127,7 @@ DomainParticipantQosDelegate::operator = (const DomainParticipantQosDelegate& ot
 {
     user_data_           = other.user_data_;
     entity_factory_      = other.entity_factory_;
+    ddsc_qos_cache_      = other.ddsc_qos_cache_;
     return *this;
 }
 
@@ -0,0 +1,259 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+
+
+/**
+ * @file
+ */
+
+#include <org/eclipse/cyclonedds/pub/AcknowledgmentWaiter.hpp>
+#include <org/eclipse/cyclonedds/core/ReportUtils.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace pub
+{
+
+static dds_time_t
+deadline_of(dds_duration_t timeout)
+{
+    dds_time_t now = dds_time();
+    if (timeout == DDS_INFINITY || timeout > DDS_NEVER - now) {
+        return DDS_NEVER;
+    }
+    return now + timeout;
+}
+
+static dds_duration_t
+remaining_until(dds_time_t deadline)
+{
+    if (deadline == DDS_NEVER) {
+        return DDS_INFINITY;
+    }
+    dds_time_t now = dds_time();
+    return (deadline > now) ? (deadline - now) : 0;
+}
+
+const dds_duration_t AcknowledgmentWaiter::min_poll_interval;
+const dds_duration_t AcknowledgmentWaiter::max_poll_interval;
+const size_t AcknowledgmentWaiter::max_checks_per_round;
+
+AcknowledgmentWaiter::AcknowledgmentWaiter()
+    : closed_(false)
+{
+}
+
+AcknowledgmentWaiter::~AcknowledgmentWaiter()
+{
+    /* The thread keeps the waiter alive, so it is gone by now. */
+    assert(!this->thread_.joinable());
+}
+
+dds_return_t
+AcknowledgmentWaiter::wait_until(
+    const std::vector<dds_entity_t>& writers,
+    dds_time_t deadline)
+{
+    /* Every writer gets the time that is left: waiting for them one after
+     * the other takes no longer than waiting for the slowest one. */
+    for (std::vector<dds_entity_t>::const_iterator it = writers.begin(); it != writers.end(); ++it) {
+        dds_return_t ret = dds_wait_for_acks(*it, remaining_until(deadline));
+        if (ret != DDS_RETCODE_OK) {
+            return ret;
+        }
+    }
+    return DDS_RETCODE_OK;
+}
+
+dds_return_t
+AcknowledgmentWaiter::check(request& req, size_t& budget)
+{
+    /* Samples written after the request was made do not count, so a writer
+     * that has acknowledged everything once is done. */
+    while (req.acked < req.writers.size()) {
+        dds_return_t ret = dds_wait_for_acks(req.writers[req.acked], 0);
+        if (budget > 0) {
+            budget--;
+        }
+        if (ret != DDS_RETCODE_OK) {
+            return ret;
+        }
+        req.acked++;
+    }
+    return DDS_RETCODE_OK;
+}
+
+dds_return_t
+AcknowledgmentWaiter::wait(
+    const std::vector<dds_entity_t>& writers,
+    dds_duration_t timeout)
+{
+    return wait_until(writers, deadline_of(timeout));
+}
+
+void
+AcknowledgmentWaiter::wait_async(
+    const std::vector<dds_entity_t>& writers,
+    dds_duration_t timeout,
+    const callback_type& callback)
+{
+    request req;
+
+    ISOCPP_BOOL_CHECK_AND_THROW(callback, ISOCPP_INVALID_ARGUMENT_ERROR, "No callback provided.");
+
+    req.writers = writers;
+    req.callback = callback;
+    req.acked = 0;
+    req.next_check = 0;
+    req.interval = min_poll_interval;
+
+    std::unique_lock<std::mutex> lock(this->mutex_);
+    ISOCPP_BOOL_CHECK_AND_THROW(!this->closed_, ISOCPP_ALREADY_CLOSED_ERROR,
+                                "The acknowledgment waiter has been closed.");
+    this->incoming_.insert(request_map::value_type(deadline_of(timeout), req));
+    if (!this->thread_.joinable()) {
+        /* The thread holds a reference, so that the waiter outlives it even
+         * when it is closed from a callback. */
+        ref_type self = this->shared_from_this();
+        this->thread_ = std::thread([self]() { self->run(); });
+    }
+    lock.unlock();
+    this->cond_.notify_one();
+}
+
+void
+AcknowledgmentWaiter::close()
+{
+    std::unique_lock<std::mutex> lock(this->mutex_);
+    if (this->closed_) {
+        return;
+    }
+    this->closed_ = true;
+    std::thread thread;
+    thread.swap(this->thread_);
+    lock.unlock();
+    this->cond_.notify_all();
+
+    if (thread.joinable()) {
+        if (thread.get_id() == std::this_thread::get_id()) {
+            /* Closed from a callback: the thread ends when it returns. */
+            thread.detach();
+        } else {
+            thread.join();
+        }
+    }
+}
+
+std::vector<dds_entity_t>
+AcknowledgmentWaiter::writers_of(dds_entity_t publisher)
+{
+    std::vector<dds_entity_t> writers;
+    dds_return_t n;
+
+    /* The number of writers can change in between both calls. */
+    do {
+        n = dds_get_children(publisher, NULL, 0);
+        ISOCPP_DDSC_RESULT_CHECK_AND_THROW(n, "Could not get the writers of the publisher.");
+        writers.resize(static_cast<size_t>(n));
+        if (n > 0) {
+            n = dds_get_children(publisher, writers.data(), writers.size());
+            ISOCPP_DDSC_RESULT_CHECK_AND_THROW(n, "Could not get the writers of the publisher.");
+        }
+    } while (static_cast<size_t>(n) > writers.size());
+    writers.resize(static_cast<size_t>(n));
+
+    return writers;
+}
+
+static void
+complete(const AcknowledgmentWaiter::callback_type& callback, bool acked)
+{
+    try {
+        callback(acked);
+    } catch (...) {
+        /* Never let an exception end the waiter thread. */
+    }
+}
+
+void
+AcknowledgmentWaiter::run()
+{
+    request_map pending;
+
+    std::unique_lock<std::mutex> lock(this->mutex_);
+    while (true) {
+        pending.insert(this->incoming_.begin(), this->incoming_.end());
+        this->incoming_.clear();
+        if (this->closed_) {
+            break;
+        }
+        lock.unlock();
+
+        /* Checking does not wait, so that a request never has to wait for
+         * others. Those that expire in the same round get a last check and
+         * fail in the order of their deadlines, whatever the budget. Those
+         * that are due but do not fit in the budget are checked first thing
+         * in the next round. */
+        dds_time_t now = dds_time();
+        dds_time_t wakeup = DDS_NEVER;
+        size_t budget = max_checks_per_round;
+        request_map::iterator it = pending.begin();
+        while (it != pending.end()) {
+            request& req = it->second;
+            bool expired = (it->first <= now);
+            if (!expired && (req.next_check > now || budget == 0)) {
+                wakeup = std::min(wakeup, std::min(req.next_check, it->first));
+                ++it;
+                continue;
+            }
+            dds_return_t ret = check(req, budget);
+            if (ret == DDS_RETCODE_TIMEOUT && !expired) {
+                req.next_check = now + req.interval;
+                req.interval = std::min(2 * req.interval, max_poll_interval);
+                wakeup = std::min(wakeup, std::min(req.next_check, it->first));
+                ++it;
+            } else {
+                complete(req.callback, ret == DDS_RETCODE_OK);
+                it = pending.erase(it);
+            }
+        }
+
+        lock.lock();
+        if (this->closed_ || !this->incoming_.empty()) {
+            continue;
+        }
+        if (pending.empty()) {
+            this->cond_.wait(lock, [this] { return this->closed_ || !this->incoming_.empty(); });
+        } else if (wakeup > now) {
+            this->cond_.wait_for(lock, std::chrono::nanoseconds(remaining_until(wakeup)));
+        }
+    }
+    lock.unlock();
+
+    /* The requests that are still pending at closing fail. */
+    for (request_map::iterator it = pending.begin(); it != pending.end(); ++it) {
+        complete(it->second.callback, false);
+    }
+}
+
+}
+}
+}
+}
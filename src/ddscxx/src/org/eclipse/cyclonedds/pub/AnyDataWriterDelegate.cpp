@@ -16,11 +16,16 @@
  */
 
 #include <dds/pub/AnyDataWriter.hpp>
+#include <dds/pub/Publisher.hpp>
 #include <org/eclipse/cyclonedds/pub/AnyDataWriterDelegate.hpp>
+#include <org/eclipse/cyclonedds/pub/PublisherDelegate.hpp>
+#include <org/eclipse/cyclonedds/pub/AcknowledgmentWaiter.hpp>
 #include <org/eclipse/cyclonedds/core/ReportUtils.hpp>
 #include <org/eclipse/cyclonedds/core/MiscUtils.hpp>
 #include <org/eclipse/cyclonedds/core/ScopedLock.hpp>
 #include <org/eclipse/cyclonedds/topic/BuiltinTopicCopy.hpp>
+#include <org/eclipse/cyclonedds/domain/DomainParticipantDelegate.hpp>
+#include <org/eclipse/cyclonedds/domain/DiscoveryCache.hpp>
 #include <dds/dds.h>
 #include <dds/ddsc/dds_loan_api.h>
 
@@ -47,8 +52,9 @@ namespace pub
 AnyDataWriterDelegate::AnyDataWriterDelegate(
         const dds::pub::qos::DataWriterQos& qos,
         const dds::topic::TopicDescription& td)
-    : qos_(qos), td_(td)
+    : qos_(qos), td_(td), matched_(dds_get_matched_subscriptions)
 {
+    this->tracked_mask = dds::core::status::StatusMask::publication_matched();
 }
 
 AnyDataWriterDelegate::~AnyDataWriterDelegate()
@@ -84,9 +90,8 @@ AnyDataWriterDelegate::qos(const dds::pub::qos::DataWriterQos& qos)
 {
     org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
     qos.delegate().check();
-    dds_qos_t *dwQos = qos.delegate().ddsc_qos();
-    dds_return_t ret = dds_set_qos(ddsc_entity, dwQos);
-    dds_delete_qos(dwQos);
+    org::eclipse::cyclonedds::core::DdscQosCache::qos_ref dwQos = qos.delegate().cached_ddsc_qos();
+    dds_return_t ret = dds_set_qos(ddsc_entity, dwQos.get());
     ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Could not set writer qos.");
     this->qos_ = qos;
 }
@@ -103,7 +108,8 @@ AnyDataWriterDelegate::write_cdr(
     struct ddsi_serdata *ser_data;
     ddsrt_iovec_t blob_holders[2];
 
-    /* Ignore the handle until ddsc supports writes with instance handles. */
+    /* ddsc does not support writes with instance handles: handles of cached
+     * instances have already been used by the typed writer at this point. */
     (void)handle;
 
     /* Create an array of ddsrt_iovec_t to contain both the encoding and the CDR payload. */
@@ -122,6 +128,12 @@ AnyDataWriterDelegate::write_cdr(
 
     ser_data->statusinfo = statusinfo;
 
+    if (this->deferring(writer)) {
+        ret = this->defer(writer, ser_data, timestamp, statusinfo);
+        ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "write_cdr failed.");
+        return;
+    }
+
     // if shared memory is supported by the writer
     if(dds_is_shared_memory_available(writer)) {
 #ifdef DDSCXX_HAS_SHM
@@ -193,6 +205,13 @@ AnyDataWriterDelegate::unregister_instance_cdr(
     const dds::core::InstanceHandle& handle,
     const dds::core::Time& timestamp)
 {
+    /* The key of a CDR blob is not known here, so drop all cached instances
+     * when no handle is given. */
+    if (handle != dds::core::null) {
+        keyhash_cache_.forget_handle(handle.delegate().handle());
+    } else {
+        keyhash_cache_.clear();
+    }
     this->write_cdr(writer, data, handle, timestamp, NN_STATUSINFO_UNREGISTER);
 }
 
@@ -231,19 +250,28 @@ AnyDataWriterDelegate::write(
     const dds::core::InstanceHandle& handle,
     const dds::core::Time& timestamp)
 {
-    dds_return_t ret;
-
-    /* Ignore the handle until ddsc supports writes with instance handles. */
+    /* ddsc does not support writes with instance handles: handles of cached
+     * instances have already been used by the typed writer at this point. */
     (void)handle;
 
+    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(this->try_write(writer, data, timestamp), "write failed.");
+}
+
+dds_return_t
+AnyDataWriterDelegate::try_write(
+    dds_entity_t writer,
+    const void *data,
+    const dds::core::Time& timestamp) noexcept
+{
+    if (this->deferring(writer)) {
+        return this->defer(writer, data, SDK_DATA, timestamp, 0);
+    }
+
     if (timestamp != dds::core::Time::invalid()) {
         dds_time_t ddsc_time = org::eclipse::cyclonedds::core::convertTime(timestamp);
-        ret = dds_write_ts(writer, data, ddsc_time);
-    } else {
-        ret = dds_write(writer, data);
+        return dds_write_ts(writer, data, ddsc_time);
     }
-
-    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "write failed.");
+    return dds_write(writer, data);
 }
 
 void
@@ -255,9 +283,16 @@ AnyDataWriterDelegate::writedispose(
 {
     dds_return_t ret;
 
-    /* Ignore the handle until ddsc supports writes with instance handles. */
+    /* ddsc does not support writes with instance handles: handles of cached
+     * instances have already been used by the typed writer at this point. */
     (void)handle;
 
+    if (this->deferring(writer)) {
+        ret = this->defer(writer, data, SDK_DATA, timestamp, NN_STATUSINFO_DISPOSE);
+        ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "writedispose failed.");
+        return;
+    }
+
     if (timestamp != dds::core::Time::invalid()) {
         dds_time_t ddsc_time = org::eclipse::cyclonedds::core::convertTime(timestamp);
         ret = dds_writedispose_ts(writer, data, ddsc_time);
@@ -302,6 +337,13 @@ AnyDataWriterDelegate::unregister_instance(
     }
     ih = handle.delegate().handle();
 
+    /* The handle may not be valid anymore after the unregistration. */
+    keyhash_cache_.forget_handle(ih);
+
+    if (this->deferring(writer) && this->defer(writer, handle, timestamp, NN_STATUSINFO_UNREGISTER)) {
+        return;
+    }
+
     if (timestamp != dds::core::Time::invalid()) {
         dds_time_t ddsc_time = org::eclipse::cyclonedds::core::convertTime(timestamp);
         ret = dds_unregister_instance_ih_ts(writer, ih, ddsc_time);
@@ -325,6 +367,12 @@ AnyDataWriterDelegate::unregister_instance(
                                "data is null");
     }
 
+    if (this->deferring(writer)) {
+        ret = this->defer(writer, data, SDK_KEY, timestamp, NN_STATUSINFO_UNREGISTER);
+        ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "unregister failed.");
+        return;
+    }
+
     if (timestamp != dds::core::Time::invalid()) {
         dds_time_t ddsc_time = org::eclipse::cyclonedds::core::convertTime(timestamp);
         ret = dds_unregister_instance_ts(writer, data, ddsc_time);
@@ -350,6 +398,10 @@ AnyDataWriterDelegate::dispose_instance(
     }
     ih = handle.delegate().handle();
 
+    if (this->deferring(writer) && this->defer(writer, handle, timestamp, NN_STATUSINFO_DISPOSE)) {
+        return;
+    }
+
     if (timestamp != dds::core::Time::invalid()) {
         dds_time_t ddsc_time = org::eclipse::cyclonedds::core::convertTime(timestamp);
         ret = dds_dispose_ih_ts(writer, ih, ddsc_time);
@@ -373,6 +425,12 @@ AnyDataWriterDelegate::dispose_instance(
                                "data is null");
     }
 
+    if (this->deferring(writer)) {
+        ret = this->defer(writer, data, SDK_KEY, timestamp, NN_STATUSINFO_DISPOSE);
+        ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "dispose failed.");
+        return;
+    }
+
     if (timestamp != dds::core::Time::invalid()) {
         dds_time_t ddsc_time = org::eclipse::cyclonedds::core::convertTime(timestamp);
         ret = dds_dispose_ts(writer, data, ddsc_time);
@@ -401,6 +459,171 @@ AnyDataWriterDelegate::lookup_instance(
     return dds_lookup_instance(writer, data);
 }
 
+void
+AnyDataWriterDelegate::write_serdata(
+    dds_entity_t writer,
+    ddsi_serdata *ser_data,
+    const dds::core::Time& timestamp,
+    uint32_t statusinfo)
+{
+    ISOCPP_BOOL_CHECK_AND_THROW(ser_data, ISOCPP_INVALID_ARGUMENT_ERROR, "Could not serialize sample.");
+    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(this->try_write_serdata(writer, ser_data, timestamp, statusinfo), "write failed.");
+}
+
+dds_return_t
+AnyDataWriterDelegate::try_write_serdata(
+    dds_entity_t writer,
+    ddsi_serdata *ser_data,
+    const dds::core::Time& timestamp,
+    uint32_t statusinfo) noexcept
+{
+    if (!ser_data) {
+        return DDS_RETCODE_BAD_PARAMETER;
+    }
+
+    if (this->deferring(writer)) {
+        return this->defer(writer, ser_data, timestamp, statusinfo);
+    }
+
+    ser_data->statusinfo = statusinfo;
+
+    if (timestamp != dds::core::Time::invalid()) {
+        ser_data->timestamp.v = org::eclipse::cyclonedds::core::convertTime(timestamp);
+        return dds_forwardcdr(writer, ser_data);
+    }
+    return dds_writecdr(writer, ser_data);
+}
+
+void
+AnyDataWriterDelegate::write_serdata(
+    dds_entity_t writer,
+    ddsi_serdata *ser_data,
+    const dds::core::Time& timestamp)
+{
+    this->write_serdata(writer, ser_data, timestamp, 0);
+}
+
+void
+AnyDataWriterDelegate::writedispose_serdata(
+    dds_entity_t writer,
+    ddsi_serdata *ser_data,
+    const dds::core::Time& timestamp)
+{
+    this->write_serdata(writer, ser_data, timestamp, NN_STATUSINFO_DISPOSE);
+}
+
+bool
+AnyDataWriterDelegate::deferring(dds_entity_t writer) const noexcept
+{
+    try {
+        return this->publisher().delegate()->suspended() && !dds_is_shared_memory_available(writer);
+    } catch (...) {
+        return false;
+    }
+}
+
+dds_return_t
+AnyDataWriterDelegate::defer(
+    dds_entity_t writer,
+    ddsi_serdata *ser_data,
+    const dds::core::Time& timestamp,
+    uint32_t statusinfo) noexcept
+{
+    ser_data->statusinfo = statusinfo;
+    try {
+        /* Stamped with the time of the write, not of the resume. */
+        ser_data->timestamp.v = (timestamp != dds::core::Time::invalid()) ?
+            org::eclipse::cyclonedds::core::convertTime(timestamp) : dds_time();
+        if (this->publisher().delegate()->defer(writer, ser_data)) {
+            return DDS_RETCODE_OK;
+        }
+    } catch (...) {
+        ddsi_serdata_unref(ser_data);
+        return DDS_RETCODE_OUT_OF_RESOURCES;
+    }
+    /* Resumed in the meantime. */
+    return dds_forwardcdr(writer, ser_data);
+}
+
+dds_return_t
+AnyDataWriterDelegate::defer(
+    dds_entity_t writer,
+    const void *data,
+    ddsi_serdata_kind kind,
+    const dds::core::Time& timestamp,
+    uint32_t statusinfo) noexcept
+{
+    ddsi_serdata *ser_data;
+    try {
+        ser_data = ddsi_serdata_from_sample(this->td_->get_ser_type(), kind, data);
+    } catch (...) {
+        return DDS_RETCODE_ERROR;
+    }
+    if (!ser_data) {
+        return DDS_RETCODE_BAD_PARAMETER;
+    }
+    return this->defer(writer, ser_data, timestamp, statusinfo);
+}
+
+bool
+AnyDataWriterDelegate::defer(
+    dds_entity_t writer,
+    const dds::core::InstanceHandle& handle,
+    const dds::core::Time& timestamp,
+    uint32_t statusinfo)
+{
+    dds_time_t ddsc_time = (timestamp != dds::core::Time::invalid()) ?
+        org::eclipse::cyclonedds::core::convertTime(timestamp) : dds_time();
+    return this->publisher().delegate()->defer(writer, handle.delegate().handle(), ddsc_time, statusinfo);
+}
+
+bool
+AnyDataWriterDelegate::cached_instance(
+    const dds::core::InstanceHandle& handle,
+    org::eclipse::cyclonedds::pub::KeyHashCache::entry& e) const
+{
+    if (handle == dds::core::null) {
+        return false;
+    }
+    ISOCPP_BOOL_CHECK_AND_THROW(keyhash_cache_.lookup(handle.delegate().handle(), e),
+                                ISOCPP_PRECONDITION_NOT_MET_ERROR,
+                                "The handle is not that of an instance registered by the writer.");
+    return true;
+}
+
+bool
+AnyDataWriterDelegate::cached_instance(
+    const dds::core::InstanceHandle& handle,
+    const std::vector<unsigned char>& key,
+    org::eclipse::cyclonedds::pub::KeyHashCache::entry& e) const
+{
+    bool key_matches;
+
+    if (handle == dds::core::null) {
+        return false;
+    }
+    ISOCPP_BOOL_CHECK_AND_THROW(keyhash_cache_.lookup(handle.delegate().handle(), key, e, key_matches),
+                                ISOCPP_PRECONDITION_NOT_MET_ERROR,
+                                "The handle is not that of an instance registered by the writer.");
+    ISOCPP_BOOL_CHECK_AND_THROW(key_matches, ISOCPP_PRECONDITION_NOT_MET_ERROR,
+                                "The sample does not belong to the instance of the handle.");
+    return true;
+}
+
+size_t
+AnyDataWriterDelegate::keyhash_cache_capacity() const
+{
+    this->check();
+    return keyhash_cache_.capacity();
+}
+
+void
+AnyDataWriterDelegate::keyhash_cache_capacity(size_t capacity)
+{
+    this->check();
+    keyhash_cache_.capacity(capacity);
+}
+
 const ::dds::core::status::LivelinessLostStatus
 AnyDataWriterDelegate::liveliness_lost_status()
 {
@@ -454,33 +677,94 @@ AnyDataWriterDelegate::publication_matched_status()
 ::dds::core::InstanceHandleSeq
 AnyDataWriterDelegate::matched_subscriptions()
 {
-    ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR, "Function not currently supported");
-
     ::dds::core::InstanceHandleSeq handleSeq;
+    std::vector<dds_instance_handle_t> handles;
+    dds_return_t ret;
+
+    this->check();
+
+    /* Subscriptions can get matched in between calls: retry until all fit. */
+    ret = dds_get_matched_subscriptions(ddsc_entity, NULL, 0);
+    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "dds_get_matched_subscriptions failed.");
+    while (static_cast<size_t>(ret) > handles.size()) {
+        handles.resize(static_cast<size_t>(ret));
+        ret = dds_get_matched_subscriptions(ddsc_entity, handles.data(), handles.size());
+        ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "dds_get_matched_subscriptions failed.");
+    }
+
+    handleSeq.reserve(static_cast<size_t>(ret));
+    for (size_t i = 0; i < static_cast<size_t>(ret); i++) {
+        handleSeq.push_back(::dds::core::InstanceHandle(handles[i]));
+    }
     return handleSeq;
 }
 
 const dds::topic::SubscriptionBuiltinTopicData
 AnyDataWriterDelegate::matched_subscription_data(const ::dds::core::InstanceHandle& h)
 {
-    ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR, "Function not currently supported");
     dds::topic::SubscriptionBuiltinTopicData dataSample;
-    (void)h;
+    dds_instance_handle_t ih = h.delegate().handle();
+
+    this->check();
+
+    ISOCPP_BOOL_CHECK_AND_THROW(this->matched_.contains(ddsc_entity, ih, this->enabled_),
+                                ISOCPP_INVALID_ARGUMENT_ERROR,
+                                "Instance handle does not belong to a matched subscription.");
+
+    org::eclipse::cyclonedds::domain::DiscoveryCache::ref_type cache =
+            this->td_.domain_participant().delegate()->discovery_cache();
+    if (!cache->subscription_data(ih, dataSample)) {
+        /* Not (yet) seen on DCPSSubscription: ask ddsc, which reports it as
+         * an error when it was unmatched in the meantime. The result is not
+         * cached, as the listener of the cache may have processed a newer
+         * sample or the disposal of the subscription in the meantime. */
+        dds_builtintopic_endpoint_t *endpoint = dds_get_matched_subscription_data(ddsc_entity, ih);
+        ISOCPP_BOOL_CHECK_AND_THROW(endpoint, ISOCPP_INVALID_ARGUMENT_ERROR,
+                                    "Instance handle does not belong to a matched subscription.");
+        org::eclipse::cyclonedds::topic::copyOut(*endpoint, dataSample);
+        dds_builtintopic_free_endpoint(endpoint);
+    }
     return dataSample;
 }
 
+void
+AnyDataWriterDelegate::on_matched(
+    dds_entity_t writer,
+    dds_instance_handle_t last_handle,
+    uint32_t current_count)
+{
+    this->matched_.update(writer, last_handle, current_count);
+}
+
 void
 AnyDataWriterDelegate::assert_liveliness()
 {
-   ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR, "Function not currently supported");
+    this->check();
+    dds_return_t ret = dds_assert_liveliness(this->ddsc_entity);
+    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Could not assert liveliness.");
 }
 
 void
 AnyDataWriterDelegate::wait_for_acknowledgments(
     const dds::core::Duration& timeout)
 {
-   ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR, "Function not currently supported");
-   (void)timeout;
+    /* Do not hold the object lock while blocking in ddsc. */
+    this->check();
+    dds_return_t ret = dds_wait_for_acks(this->ddsc_entity,
+                                         org::eclipse::cyclonedds::core::convertDuration(timeout));
+    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "wait_for_acknowledgments failed.");
+}
+
+void
+AnyDataWriterDelegate::wait_for_acknowledgments_async(
+    const dds::core::Duration& timeout,
+    const std::function<void(bool)>& callback)
+{
+    this->check();
+    std::vector<dds_entity_t> writers(1, this->ddsc_entity);
+    AcknowledgmentWaiter::ref_type waiter =
+            this->td_.domain_participant().delegate()->acknowledgment_waiter();
+    waiter->wait_async(writers, org::eclipse::cyclonedds::core::convertDuration(timeout), callback);
 }
 
 dds::pub::TAnyDataWriter<AnyDataWriterDelegate>
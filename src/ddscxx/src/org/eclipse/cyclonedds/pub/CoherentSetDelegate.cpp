@@ -0,0 +1,65 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+
+
+/**
+ * @file
+ */
+
+#include <org/eclipse/cyclonedds/pub/CoherentSetDelegate.hpp>
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace pub
+{
+
+CoherentSetDelegate::CoherentSetDelegate(const dds::pub::Publisher& p) :
+    pub(p),
+    ended(false)
+{
+    this->pub.delegate()->begin_coherent_changes();
+}
+
+CoherentSetDelegate::~CoherentSetDelegate()
+{
+    if (!this->ended) {
+        try {
+            this->end();
+        } catch (...) {
+
+        }
+    }
+}
+
+void
+CoherentSetDelegate::end()
+{
+    if (!this->ended) {
+        this->pub.delegate()->end_coherent_changes();
+        this->ended = true;
+    }
+}
+
+bool
+CoherentSetDelegate::operator==(const CoherentSetDelegate& other) const
+{
+    return this->pub == other.pub && this->ended == other.ended;
+}
+
+}
+}
+}
+}
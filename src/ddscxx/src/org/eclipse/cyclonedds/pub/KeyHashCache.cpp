@@ -0,0 +1,237 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+
+
+/**
+ * @file
+ */
+
+#include <org/eclipse/cyclonedds/pub/KeyHashCache.hpp>
+#include <org/eclipse/cyclonedds/core/ScopedLock.hpp>
+
+#include <algorithm>
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace pub
+{
+
+/* Returns the key as a string that can be looked up, in a buffer that is
+ * reused by the thread so that a lookup does not allocate. */
+static const std::string&
+key_string(const std::vector<unsigned char>& key)
+{
+    static thread_local std::string str;
+    str.assign(reinterpret_cast<const char*>(key.data()), key.size());
+    return str;
+}
+
+KeyHashCache::KeyHashCache(size_t capacity)
+    : capacity_(capacity)
+{
+}
+
+KeyHashCache::~KeyHashCache()
+{
+}
+
+size_t
+KeyHashCache::capacity() const
+{
+    return this->capacity_.load(std::memory_order_relaxed);
+}
+
+void
+KeyHashCache::capacity(size_t capacity)
+{
+    org::eclipse::cyclonedds::core::ScopedMutexLock scopedLock(this->mutex_);
+    this->capacity_.store(capacity, std::memory_order_relaxed);
+    this->evict();
+}
+
+size_t
+KeyHashCache::size() const
+{
+    org::eclipse::cyclonedds::core::ScopedMutexLock scopedLock(this->mutex_);
+    return this->registered_.size() + this->lru_.size();
+}
+
+bool
+KeyHashCache::lookup(const std::vector<unsigned char>& key, entry& e) const
+{
+    org::eclipse::cyclonedds::core::ScopedMutexLock scopedLock(this->mutex_);
+    std::unordered_map<std::string, item_list::iterator>::const_iterator it = this->by_key_.find(key_string(key));
+    if (it == this->by_key_.end()) {
+        return false;
+    }
+    if (it->second->second.handle == DDS_HANDLE_NIL) {
+        /* Move the entry to the front: it is the most recently used one now. */
+        this->lru_.splice(this->lru_.begin(), this->lru_, it->second);
+    }
+    e = it->second->second;
+    return true;
+}
+
+bool
+KeyHashCache::lookup(dds_instance_handle_t handle, entry& e) const
+{
+    org::eclipse::cyclonedds::core::ScopedMutexLock scopedLock(this->mutex_);
+    std::unordered_map<dds_instance_handle_t, item_list::iterator>::const_iterator it = this->by_handle_.find(handle);
+    if (it == this->by_handle_.end()) {
+        return false;
+    }
+    e = it->second->second;
+    return true;
+}
+
+bool
+KeyHashCache::lookup(dds_instance_handle_t handle, const std::vector<unsigned char>& key,
+                     entry& e, bool& key_matches) const
+{
+    org::eclipse::cyclonedds::core::ScopedMutexLock scopedLock(this->mutex_);
+    std::unordered_map<dds_instance_handle_t, item_list::iterator>::const_iterator it = this->by_handle_.find(handle);
+    if (it == this->by_handle_.end()) {
+        return false;
+    }
+    const std::string& cached = it->second->first;
+    key_matches = cached.size() == key.size() &&
+                  std::equal(key.begin(), key.end(), reinterpret_cast<const unsigned char*>(cached.data()));
+    e = it->second->second;
+    return true;
+}
+
+void
+KeyHashCache::insert(const std::vector<unsigned char>& key, const entry& e)
+{
+    org::eclipse::cyclonedds::core::ScopedMutexLock scopedLock(this->mutex_);
+    if (e.handle == DDS_HANDLE_NIL && this->capacity() == 0) {
+        return;
+    }
+
+    const std::string& k = key_string(key);
+    std::unordered_map<std::string, item_list::iterator>::iterator it = this->by_key_.find(k);
+    item_list::iterator item_it;
+    if (it != this->by_key_.end()) {
+        item_it = it->second;
+        if (item_it->second.handle != DDS_HANDLE_NIL) {
+            if (item_it->second.handle != e.handle) {
+                this->by_handle_.erase(item_it->second.handle);
+            }
+            item_it->second = e;
+            if (e.handle == DDS_HANDLE_NIL) {
+                this->unregistered(item_it);
+            } else {
+                this->by_handle_[e.handle] = item_it;
+            }
+            return;
+        }
+        item_it->second = e;
+    } else {
+        this->lru_.push_front(item(k, e));
+        item_it = this->lru_.begin();
+        this->by_key_[k] = item_it;
+    }
+
+    /* The entry is in the least recently used list now. */
+    if (e.handle != DDS_HANDLE_NIL) {
+        this->registered_.splice(this->registered_.begin(), this->lru_, item_it);
+        this->by_handle_[e.handle] = item_it;
+    } else {
+        this->lru_.splice(this->lru_.begin(), this->lru_, item_it);
+        this->evict();
+    }
+}
+
+void
+KeyHashCache::update_keyhash(const std::vector<unsigned char>& key, const entry& e)
+{
+    org::eclipse::cyclonedds::core::ScopedMutexLock scopedLock(this->mutex_);
+    std::unordered_map<std::string, item_list::iterator>::iterator it = this->by_key_.find(key_string(key));
+    if (it != this->by_key_.end()) {
+        entry& cached = it->second->second;
+        cached.keyhash = e.keyhash;
+        cached.key_md5_hashed = e.key_md5_hashed;
+        cached.hash = e.hash;
+        cached.keyhash_valid = e.keyhash_valid;
+    }
+}
+
+void
+KeyHashCache::forget_handle(dds_instance_handle_t handle)
+{
+    org::eclipse::cyclonedds::core::ScopedMutexLock scopedLock(this->mutex_);
+    std::unordered_map<dds_instance_handle_t, item_list::iterator>::iterator it = this->by_handle_.find(handle);
+    if (it != this->by_handle_.end()) {
+        item_list::iterator item_it = it->second;
+        this->by_handle_.erase(it);
+        item_it->second.handle = DDS_HANDLE_NIL;
+        this->unregistered(item_it);
+    }
+}
+
+void
+KeyHashCache::forget_handle(const std::vector<unsigned char>& key)
+{
+    org::eclipse::cyclonedds::core::ScopedMutexLock scopedLock(this->mutex_);
+    std::unordered_map<std::string, item_list::iterator>::iterator it = this->by_key_.find(key_string(key));
+    if (it != this->by_key_.end() && it->second->second.handle != DDS_HANDLE_NIL) {
+        item_list::iterator item_it = it->second;
+        this->by_handle_.erase(item_it->second.handle);
+        item_it->second.handle = DDS_HANDLE_NIL;
+        this->unregistered(item_it);
+    }
+}
+
+void
+KeyHashCache::clear()
+{
+    org::eclipse::cyclonedds::core::ScopedMutexLock scopedLock(this->mutex_);
+    this->by_handle_.clear();
+    this->by_key_.clear();
+    this->registered_.clear();
+    this->lru_.clear();
+}
+
+void
+KeyHashCache::unregistered(item_list::iterator it)
+{
+    /* Called with the mutex locked. The keyhash remains valid, so the entry
+     * is kept as the most recently used unregistered one, if there is room.
+     * An instance that was never written has no keyhash to keep. */
+    if (!it->second.keyhash_valid) {
+        this->by_key_.erase(it->first);
+        this->registered_.erase(it);
+        return;
+    }
+    this->lru_.splice(this->lru_.begin(), this->registered_, it);
+    this->evict();
+}
+
+void
+KeyHashCache::evict()
+{
+    /* Called with the mutex locked. */
+    size_t capacity = this->capacity();
+    while (this->lru_.size() > capacity) {
+        this->by_key_.erase(this->lru_.back().first);
+        this->lru_.pop_back();
+    }
+}
+
+}
+}
+}
+}
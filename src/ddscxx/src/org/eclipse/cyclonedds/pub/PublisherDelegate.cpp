@@ -23,8 +23,15 @@
 #include <org/eclipse/cyclonedds/core/ReportUtils.hpp>
 #include <org/eclipse/cyclonedds/pub/PublisherDelegate.hpp>
 #include <org/eclipse/cyclonedds/pub/AnyDataWriterDelegate.hpp>
+#include <org/eclipse/cyclonedds/pub/AcknowledgmentWaiter.hpp>
+#include <org/eclipse/cyclonedds/domain/DomainParticipantDelegate.hpp>
+#include <org/eclipse/cyclonedds/core/MiscUtils.hpp>
 #include <org/eclipse/cyclonedds/core/ScopedLock.hpp>
 
+#include <algorithm>
+
+#include "dds/ddsi/q_protocol.h"
+
 
 namespace org
 {
@@ -41,11 +48,13 @@ PublisherDelegate::PublisherDelegate(const dds::domain::DomainParticipant& dp,
                                      const dds::core::status::StatusMask& event_mask)
     :   dp_(dp),
         qos_(qos),
-        default_dwqos_()
+        default_dwqos_(),
+        suspend_depth_(0),
+        deferred_capacity_(65536)
 {
     dds_entity_t ddsc_par;
     dds_entity_t ddsc_pub;
-    dds_qos_t* ddsc_qos;
+    org::eclipse::cyclonedds::core::DdscQosCache::qos_ref ddsc_qos;
 
     ddsc_par = static_cast<dds_entity_t>(this->dp_.delegate()->get_ddsc_entity());
     if (!ddsc_par) {
@@ -53,13 +62,12 @@ PublisherDelegate::PublisherDelegate(const dds::domain::DomainParticipant& dp,
     }
 
     qos.delegate().check();
-    ddsc_qos = qos.delegate().ddsc_qos();
+    ddsc_qos = qos.delegate().cached_ddsc_qos();
     if (!ddsc_qos) {
         ISOCPP_THROW_EXCEPTION(ISOCPP_ERROR, "Could not convert publisher QoS.");
     }
 
-    ddsc_pub = dds_create_publisher(ddsc_par, ddsc_qos, NULL);
-    dds_delete_qos(ddsc_qos);
+    ddsc_pub = dds_create_publisher(ddsc_par, ddsc_qos.get(), NULL);
     ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ddsc_pub, "Could not create publisher.");
     this->set_ddsc_entity(ddsc_pub);
 
@@ -101,6 +109,9 @@ PublisherDelegate::close()
     /* Close the datawriters. */
     this->writers.all_close();
 
+    /* Publications that are still suspended are never sent. */
+    this->discard_deferred(0);
+
     /* Stop listener. */
     this->listener_set(NULL, dds::core::status::StatusMask::none());
 
@@ -121,17 +132,16 @@ void
 PublisherDelegate::qos(const dds::pub::qos::PublisherQos& pqos)
 {
     org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
-    dds_qos_t* ddsc_qos;
+    org::eclipse::cyclonedds::core::DdscQosCache::qos_ref ddsc_qos;
     dds_return_t ret;
 
     pqos.delegate().check();
-    ddsc_qos = pqos.delegate().ddsc_qos();
+    ddsc_qos = pqos.delegate().cached_ddsc_qos();
     if (!ddsc_qos) {
         ISOCPP_THROW_EXCEPTION(ISOCPP_ERROR, "Could not convert publisher qos.");
     }
 
-    ret = dds_set_qos(ddsc_entity, ddsc_qos);
-    dds_free(ddsc_qos);
+    ret = dds_set_qos(ddsc_entity, ddsc_qos.get());
     ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Could not set publisher qos.");
 
     this->qos_ = pqos;
@@ -156,34 +166,193 @@ PublisherDelegate::default_datawriter_qos(const dds::pub::qos::DataWriterQos& dw
 void
 PublisherDelegate::suspend_publications()
 {
-    ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR, "Function not currently supported");
+    this->check();
+
+    std::lock_guard<std::mutex> lock(this->deferred_mutex_);
+    this->suspend_depth_++;
 }
 
 void
 PublisherDelegate::resume_publications()
 {
-    ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR, "Function not currently supported");
+    this->check();
+
+    std::lock_guard<std::mutex> lock(this->deferred_mutex_);
+    ISOCPP_BOOL_CHECK_AND_THROW(this->suspend_depth_ > 0, ISOCPP_PRECONDITION_NOT_MET_ERROR,
+                                "Publications are not suspended.");
+    if (this->suspend_depth_ > 1) {
+        this->suspend_depth_--;
+        return;
+    }
+
+    /* Stay suspended while the deferred writes are sent: a concurrent write
+     * then waits in defer() instead of overtaking them. */
+    dds_return_t ret = this->send_deferred();
+    this->suspend_depth_ = 0;
+    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Could not send the suspended publications.");
+}
+
+size_t
+PublisherDelegate::suspended_capacity() const
+{
+    std::lock_guard<std::mutex> lock(this->deferred_mutex_);
+    return this->deferred_capacity_;
+}
+
+void
+PublisherDelegate::suspended_capacity(size_t capacity)
+{
+    ISOCPP_BOOL_CHECK_AND_THROW(capacity > 0, ISOCPP_INVALID_ARGUMENT_ERROR,
+                                "The capacity for suspended publications must be at least 1.");
+
+    std::lock_guard<std::mutex> lock(this->deferred_mutex_);
+    this->deferred_capacity_ = capacity;
+}
+
+bool
+PublisherDelegate::suspended() const
+{
+    return this->suspend_depth_.load(std::memory_order_acquire) > 0;
+}
+
+bool
+PublisherDelegate::defer(dds_entity_t writer, ddsi_serdata *ser_data)
+{
+    std::lock_guard<std::mutex> lock(this->deferred_mutex_);
+    if (this->suspend_depth_ == 0) {
+        return false;
+    }
+    ISOCPP_BOOL_CHECK_AND_THROW(this->deferred_.size() < this->deferred_capacity_, ISOCPP_OUT_OF_RESOURCES_ERROR,
+                                "Too many publications are suspended.");
+    deferred_write w = { writer, ser_data, 0, 0, 0 };
+    this->deferred_.push_back(w);
+    return true;
+}
+
+bool
+PublisherDelegate::defer(
+    dds_entity_t writer,
+    dds_instance_handle_t handle,
+    dds_time_t timestamp,
+    uint32_t statusinfo)
+{
+    std::lock_guard<std::mutex> lock(this->deferred_mutex_);
+    if (this->suspend_depth_ == 0) {
+        return false;
+    }
+    ISOCPP_BOOL_CHECK_AND_THROW(this->deferred_.size() < this->deferred_capacity_, ISOCPP_OUT_OF_RESOURCES_ERROR,
+                                "Too many publications are suspended.");
+    deferred_write w = { writer, NULL, handle, timestamp, statusinfo };
+    this->deferred_.push_back(w);
+    return true;
+}
+
+/* Sends the deferred writes in the order they were made, with the timestamps
+ * of when they were made. Every write is attempted, the first failure is
+ * returned. Called with the deferred_mutex_ held. */
+dds_return_t
+PublisherDelegate::send_deferred()
+{
+    dds_return_t result = DDS_RETCODE_OK;
+    std::vector<dds_entity_t> flush;
+
+    for (std::vector<deferred_write>::iterator it = this->deferred_.begin(); it != this->deferred_.end(); ++it) {
+        dds_return_t ret;
+        if (it->ser_data) {
+            ret = dds_forwardcdr(it->writer, it->ser_data);
+        } else if (it->statusinfo & NN_STATUSINFO_DISPOSE) {
+            ret = dds_dispose_ih_ts(it->writer, it->handle, it->timestamp);
+        } else {
+            ret = dds_unregister_instance_ih_ts(it->writer, it->handle, it->timestamp);
+        }
+        if (ret != DDS_RETCODE_OK && result == DDS_RETCODE_OK) {
+            result = ret;
+        }
+        if (std::find(flush.begin(), flush.end(), it->writer) == flush.end()) {
+            flush.push_back(it->writer);
+        }
+    }
+    this->deferred_.clear();
+
+    /* Writers that batch only pack their messages until flushed, so that
+     * every writer sends its backlog in as few messages as it can. */
+    for (std::vector<dds_entity_t>::iterator it = flush.begin(); it != flush.end(); ++it) {
+        (void) dds_write_flush(*it);
+    }
+
+    return result;
+}
+
+/* Drops the deferred writes of a writer that is closed, or of all writers
+ * when writer is 0. */
+void
+PublisherDelegate::discard_deferred(dds_entity_t writer)
+{
+    std::lock_guard<std::mutex> lock(this->deferred_mutex_);
+    std::vector<deferred_write>::iterator end = this->deferred_.begin();
+    for (std::vector<deferred_write>::iterator it = this->deferred_.begin(); it != this->deferred_.end(); ++it) {
+        if (writer == 0 || it->writer == writer) {
+            if (it->ser_data) {
+                ddsi_serdata_unref(it->ser_data);
+            }
+        } else {
+            *end++ = *it;
+        }
+    }
+    this->deferred_.erase(end, this->deferred_.end());
 }
 
 void
 PublisherDelegate::begin_coherent_changes()
 {
-    ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR, "Function not currently supported");
+    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
+
+    const dds::pub::qos::PublisherQos& pqos = this->qos_;
+    ISOCPP_BOOL_CHECK_AND_THROW(
+        pqos.delegate().policy<dds::core::policy::Presentation>().coherent_access(),
+        ISOCPP_PRECONDITION_NOT_MET_ERROR,
+        "Coherent changes require the coherent access of the Presentation QoS.");
+
+    /* The writes of all writers of the publisher go into one coherent set
+     * until it is ended, with GROUP access scope they are presented to the
+     * readers atomically. */
+    dds_return_t ret = dds_begin_coherent(this->get_ddsc_entity());
+    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Could not begin coherent changes.");
 }
 
 void
 PublisherDelegate::end_coherent_changes()
 {
-    ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR, "Function not currently supported");
+    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
+
+    dds_return_t ret = dds_end_coherent(this->get_ddsc_entity());
+    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Could not end coherent changes.");
 }
 
 void
 PublisherDelegate::wait_for_acknowledgments(const dds::core::Duration& max_wait)
 {
-    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
+    /* Do not hold the object lock while blocking in ddsc. The publisher
+     * waits for each of its writers, all within the same deadline. */
     this->check();
-    (void)max_wait;
-    ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR, "Function not currently supported");
+    std::vector<dds_entity_t> writers =
+        org::eclipse::cyclonedds::pub::AcknowledgmentWaiter::writers_of(this->ddsc_entity);
+    dds_return_t ret = org::eclipse::cyclonedds::pub::AcknowledgmentWaiter::wait(
+        writers, org::eclipse::cyclonedds::core::convertDuration(max_wait));
+    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "wait_for_acknowledgments failed.");
+}
+
+void
+PublisherDelegate::wait_for_acknowledgments_async(
+    const dds::core::Duration& max_wait,
+    const std::function<void(bool)>& callback)
+{
+    this->check();
+    std::vector<dds_entity_t> writers =
+        org::eclipse::cyclonedds::pub::AcknowledgmentWaiter::writers_of(this->ddsc_entity);
+    AcknowledgmentWaiter::ref_type waiter =
+            this->participant().delegate()->acknowledgment_waiter();
+    waiter->wait_async(writers, org::eclipse::cyclonedds::core::convertDuration(max_wait), callback);
 }
 
 void
@@ -221,12 +390,18 @@ PublisherDelegate::add_datawriter(
     org::eclipse::cyclonedds::core::EntityDelegate& datawriter)
 {
     this->writers.insert(datawriter);
+
+    /* Callbacks go to the executor of the parent, unless told otherwise. */
+    if (!datawriter.has_listener_executor()) {
+        datawriter.listener_executor(this->listener_executor());
+    }
 }
 
 void
 PublisherDelegate::remove_datawriter(
     org::eclipse::cyclonedds::core::EntityDelegate& datawriter)
 {
+    this->discard_deferred(datawriter.get_ddsc_entity());
     this->writers.erase(datawriter);
 }
 
@@ -329,6 +504,12 @@ void PublisherDelegate::on_publication_matched(dds_entity_t writer,
     this->listener()->on_publication_matched(adw, s);
 }
 
+org::eclipse::cyclonedds::core::EntityDelegate*
+PublisherDelegate::listener_parent() const
+{
+    return this->dp_.delegate().get();
+}
+
 
 
 }
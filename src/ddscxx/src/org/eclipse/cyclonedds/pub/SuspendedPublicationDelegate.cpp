@@ -0,0 +1,67 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+
+
+/**
+ * @file
+ */
+
+#include <org/eclipse/cyclonedds/pub/SuspendedPublicationDelegate.hpp>
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace pub
+{
+
+SuspendedPublicationDelegate::SuspendedPublicationDelegate(const dds::pub::Publisher& p) :
+    pub(p),
+    resumed(false)
+{
+    this->pub.delegate()->suspend_publications();
+}
+
+SuspendedPublicationDelegate::~SuspendedPublicationDelegate()
+{
+    if (!this->resumed) {
+        try {
+            this->resume();
+        } catch (...) {
+
+        }
+    }
+}
+
+void
+SuspendedPublicationDelegate::resume()
+{
+    if (!this->resumed) {
+        /* Marked first: the publications are resumed even when sending the
+         * deferred writes fails. */
+        this->resumed = true;
+        this->pub.delegate()->resume_publications();
+    }
+}
+
+bool
+SuspendedPublicationDelegate::operator==(const SuspendedPublicationDelegate& other) const
+{
+    return this->pub == other.pub && this->resumed == other.resumed;
+}
+
+}
+}
+}
+}
@@ -49,6 +49,7 @@ DataWriterQosDelegate::policy(const dds::core::policy::UserData& user_data)
 {
     user_data.delegate().check();
     user_data_ = user_data;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -56,6 +57,7 @@ DataWriterQosDelegate::policy(const dds::core::policy::Durability& durability)
 {
     durability.delegate().check();
     durability_ = durability;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -63,6 +65,7 @@ DataWriterQosDelegate::policy(const dds::core::policy::Deadline& deadline)
 {
     deadline.delegate().check();
     deadline_ = deadline;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -70,6 +73,7 @@ DataWriterQosDelegate::policy(const dds::core::policy::LatencyBudget&  budget)
 {
     budget.delegate().check();
     budget_ = budget;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -77,6 +81,7 @@ DataWriterQosDelegate::policy(const dds::core::policy::Liveliness& liveliness)
 {
     liveliness.delegate().check();
     liveliness_ = liveliness;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -84,6 +89,7 @@ DataWriterQosDelegate::policy(const dds::core::policy::Reliability& reliability)
 {
     reliability.delegate().check();
     reliability_ = reliability;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -91,6 +97,7 @@ DataWriterQosDelegate::policy(const dds::core::policy::DestinationOrder& order)
 {
     order.delegate().check();
     order_ = order;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -98,6 +105,7 @@ DataWriterQosDelegate::policy(const dds::core::policy::History& history)
 {
     history.delegate().check();
     history_ = history;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -105,6 +113,7 @@ DataWriterQosDelegate::policy(const dds::core::policy::ResourceLimits& resources
 {
     resources.delegate().check();
     resources_ = resources;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -112,6 +121,7 @@ DataWriterQosDelegate::policy(const dds::core::policy::TransportPriority& priori
 {
     priority.delegate().check();
     priority_ = priority;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -119,6 +129,7 @@ DataWriterQosDelegate::policy(const dds::core::policy::Lifespan& lifespan)
 {
     lifespan.delegate().check();
     lifespan_ = lifespan;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -126,6 +137,7 @@ DataWriterQosDelegate::policy(const dds::core::policy::Ownership& ownership)
 {
     ownership.delegate().check();
     ownership_ = ownership;
+    ddsc_qos_cache_.invalidate();
 }
 
 #ifdef  OMG_DDS_OWNERSHIP_SUPPORT
@@ -134,6 +146,7 @@ DataWriterQosDelegate::policy(const dds::core::policy::OwnershipStrength& streng
 {
     strength.delegate().check();
     strength_ = strength;
+    ddsc_qos_cache_.invalidate();
 }
 #endif  // OMG_DDS_OWNERSHIP_SUPPORT
 
@@ -142,6 +155,7 @@ DataWriterQosDelegate::policy(const dds::core::policy::WriterDataLifecycle& life
 {
     lifecycle.delegate().check();
     lifecycle_ = lifecycle;
+    ddsc_qos_cache_.invalidate();
 }
 
 dds_qos_t*
@@ -167,10 +181,21 @@ DataWriterQosDelegate::ddsc_qos() const
     return qos;
 }
 
+org::eclipse::cyclonedds::core::DdscQosCache::qos_ref
+DataWriterQosDelegate::cached_ddsc_qos() const
+{
+    org::eclipse::cyclonedds::core::DdscQosCache::qos_ref qos = ddsc_qos_cache_.get();
+    if (!qos) {
+        qos = ddsc_qos_cache_.set(ddsc_qos());
+    }
+    return qos;
+}
+
 void
 DataWriterQosDelegate::ddsc_qos(const dds_qos_t* qos)
 {
     assert(qos);
+    ddsc_qos_cache_.invalidate();
     user_data_   .delegate().set_iso_policy(qos);
     durability_  .delegate().set_iso_policy(qos);
     deadline_    .delegate().set_iso_policy(qos);
@@ -260,6 +285,7 @@ DataWriterQosDelegate::operator =(const org::eclipse::cyclonedds::topic::qos::To
     priority_    = tqos.policy<dds::core::policy::TransportPriority>();
     lifespan_    = tqos.policy<dds::core::policy::Lifespan>();
     ownership_   = tqos.policy<dds::core::policy::Ownership>();
+    ddsc_qos_cache_.invalidate();
     return *this;
 }
 
@@ -40,7 +40,8 @@ PublisherQosDelegate::PublisherQosDelegate(
     : presentation_(other.presentation_),
       partition_(other.partition_),
       gdata_(other.gdata_),
-      factory_policy_(other.factory_policy_)
+      factory_policy_(other.factory_policy_),
+      ddsc_qos_cache_(other.ddsc_qos_cache_)
 {
 }
 
@@ -53,6 +54,7 @@ PublisherQosDelegate::policy(const dds::core::policy::Presentation& presentation
 {
     presentation.delegate().check();
     presentation_ = presentation;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -60,6 +62,7 @@ PublisherQosDelegate::policy(const dds::core::policy::Partition& partition)
 {
     partition.delegate().check();
     partition_ = partition;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -67,6 +70,7 @@ PublisherQosDelegate::policy(const dds::core::policy::GroupData& gdata)
 {
     gdata.delegate().check();
     gdata_ = gdata;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -74,6 +78,7 @@ PublisherQosDelegate::policy(const dds::core::policy::EntityFactory& factory_pol
 {
     factory_policy.delegate().check();
     factory_policy_ = factory_policy;
+    ddsc_qos_cache_.invalidate();
 }
 
 dds_qos_t*
@@ -87,10 +92,21 @@ PublisherQosDelegate::ddsc_qos() const
     return qos;
 }
 
+org::eclipse::cyclonedds::core::DdscQosCache::qos_ref
+PublisherQosDelegate::cached_ddsc_qos() const
+{
+    org::eclipse::cyclonedds::core::DdscQosCache::qos_ref qos = ddsc_qos_cache_.get();
+    if (!qos) {
+        qos = ddsc_qos_cache_.set(ddsc_qos());
+    }
+    return qos;
+}
+
 void
 PublisherQosDelegate::ddsc_qos(const dds_qos_t* qos)
 {
     assert(qos);
+    ddsc_qos_cache_.invalidate();
     presentation_   .delegate().set_iso_policy(qos);
     partition_      .delegate().set_iso_policy(qos);
     gdata_          .delegate().set_iso_policy(qos);
@@ -136,6 +152,7 @@ PublisherQosDelegate::operator =(const PublisherQosDelegate& other)
     partition_      = other.partition_;
     gdata_          = other.gdata_;
     factory_policy_ = other.factory_policy_;
+    ddsc_qos_cache_ = other.ddsc_qos_cache_;
     return *this;
 }
 
@@ -15,6 +15,8 @@
  * @file
  */
 
+#include <new>
+
 #include <dds/sub/AnyDataReader.hpp>
 
 #include <org/eclipse/cyclonedds/sub/QueryDelegate.hpp>
@@ -24,6 +26,8 @@
 #include <org/eclipse/cyclonedds/core/ScopedLock.hpp>
 #include <dds/sub/status/detail/DataStateImpl.hpp>
 #include <org/eclipse/cyclonedds/topic/BuiltinTopicCopy.hpp>
+#include <org/eclipse/cyclonedds/domain/DomainParticipantDelegate.hpp>
+#include <org/eclipse/cyclonedds/domain/DiscoveryCache.hpp>
 
 #include "dds/dds.h"
 #include "dds/ddsc/dds_loan_api.h"
@@ -49,8 +53,9 @@ struct ReaderCopyInfo {
 AnyDataReaderDelegate::AnyDataReaderDelegate(
         const dds::sub::qos::DataReaderQos& qos,
         const dds::topic::TopicDescription& td)
-  : qos_(qos), td_(td), sample_(0)
+  : qos_(qos), td_(td), sample_(0), matched_(dds_get_matched_publications)
 {
+    this->tracked_mask = dds::core::status::StatusMask::subscription_matched();
 }
 
 AnyDataReaderDelegate::~AnyDataReaderDelegate()
@@ -79,9 +84,8 @@ AnyDataReaderDelegate::qos(const dds::sub::qos::DataReaderQos& qos)
 {
     org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
     qos->check();
-    dds_qos_t* ddsc_qos = qos.delegate().ddsc_qos();
-    dds_return_t ret = dds_set_qos(ddsc_entity, ddsc_qos);
-    dds_delete_qos(ddsc_qos);
+    org::eclipse::cyclonedds::core::DdscQosCache::qos_ref ddsc_qos = qos.delegate().cached_ddsc_qos();
+    dds_return_t ret = dds_set_qos(ddsc_entity, ddsc_qos.get());
     ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Could not set reader qos.");
     this->qos_ = qos;
 }
@@ -346,46 +350,62 @@ AnyDataReaderDelegate::loaned_take(
     const dds::sub::status::DataState& mask,
     dds::sub::detail::SamplesHolder& samples,
     uint32_t requested_max_samples)
+{
+    dds_return_t ret = this->try_loaned_take(reader, mask, samples, requested_max_samples);
+    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Getting sample failed.");
+}
+
+dds_return_t
+AnyDataReaderDelegate::try_loaned_take(
+    const dds_entity_t reader,
+    const dds::sub::status::DataState& mask,
+    dds::sub::detail::SamplesHolder& samples,
+    uint32_t requested_max_samples) noexcept
 {
     void ** c_sample_pointers = NULL;
     dds_sample_info_t * c_sample_infos = NULL;
     size_t c_sample_pointers_size = 0;
     uint32_t samples_to_read_cnt = 0;
     uint32_t ddsc_mask = get_ddsc_state_mask(mask);
-    bool expect_samples;
-
-    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
-    this->check();
-
-    expect_samples = this->init_samples_buffers(
-                               requested_max_samples,
-                               samples_to_read_cnt,
-                               c_sample_pointers_size,
-                               samples,
-                               c_sample_pointers,
-                               c_sample_infos);
+    dds_return_t ret = 0;
 
-    if (expect_samples)
-    {
-        dds_return_t ret;
-        /* The reader can also be a condition. */
-        ret = dds_takecdr(reader,
-                          reinterpret_cast<struct ddsi_serdata **>(c_sample_pointers),
-                          samples_to_read_cnt,
-                          c_sample_infos,
-                          ddsc_mask);
+    /* Not an object lock, as that reports a closed reader with an exception. */
+    org::eclipse::cyclonedds::core::ScopedMutexLock scopedLock(this->mutex);
+    if (this->closed) {
+        return DDS_RETCODE_ALREADY_DELETED;
+    }
 
-        if (ret > 0) {
-          /* When > 0, ret represents the number of samples read. */
-            samples.set_length(static_cast<uint32_t>(ret));
-            samples.set_sample_contents(c_sample_pointers, c_sample_infos);
-        } else {
-            samples.set_length(0);
+    try {
+        if (this->init_samples_buffers(
+                       requested_max_samples,
+                       samples_to_read_cnt,
+                       c_sample_pointers_size,
+                       samples,
+                       c_sample_pointers,
+                       c_sample_infos))
+        {
+            /* The reader can also be a condition. */
+            ret = dds_takecdr(reader,
+                              reinterpret_cast<struct ddsi_serdata **>(c_sample_pointers),
+                              samples_to_read_cnt,
+                              c_sample_infos,
+                              ddsc_mask);
+
+            if (ret > 0) {
+                /* When > 0, ret represents the number of samples read. */
+                samples.set_length(static_cast<uint32_t>(ret));
+                samples.set_sample_contents(c_sample_pointers, c_sample_infos);
+            } else {
+                samples.set_length(0);
+            }
+
+            samples.fini_samples_buffers(c_sample_pointers, c_sample_infos);
         }
-
-        samples.fini_samples_buffers(c_sample_pointers, c_sample_infos);
-        ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Getting sample failed.");
+    } catch (const std::bad_alloc&) {
+        ret = DDS_RETCODE_OUT_OF_RESOURCES;
     }
+
+    return ret;
 }
 
 void
@@ -878,20 +898,65 @@ AnyDataReaderDelegate::subscription_matched_status()
 ::dds::core::InstanceHandleSeq
 AnyDataReaderDelegate::matched_publications()
 {
-    ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR, "Function not currently supported");
     ::dds::core::InstanceHandleSeq handleSeq;
+    std::vector<dds_instance_handle_t> handles;
+    dds_return_t ret;
+
+    this->check();
+
+    /* Publications can get matched in between calls: retry until all fit. */
+    ret = dds_get_matched_publications(ddsc_entity, NULL, 0);
+    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "dds_get_matched_publications failed.");
+    while (static_cast<size_t>(ret) > handles.size()) {
+        handles.resize(static_cast<size_t>(ret));
+        ret = dds_get_matched_publications(ddsc_entity, handles.data(), handles.size());
+        ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "dds_get_matched_publications failed.");
+    }
+
+    handleSeq.reserve(static_cast<size_t>(ret));
+    for (size_t i = 0; i < static_cast<size_t>(ret); i++) {
+        handleSeq.push_back(::dds::core::InstanceHandle(handles[i]));
+    }
     return handleSeq;
 }
 
 const dds::topic::PublicationBuiltinTopicData
 AnyDataReaderDelegate::matched_publication_data(const ::dds::core::InstanceHandle& h)
 {
-    ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR, "Function not currently supported");
     dds::topic::PublicationBuiltinTopicData dataSample;
-    (void)h;
+    dds_instance_handle_t ih = h.delegate().handle();
+
+    this->check();
+
+    ISOCPP_BOOL_CHECK_AND_THROW(this->matched_.contains(ddsc_entity, ih, this->enabled_),
+                                ISOCPP_INVALID_ARGUMENT_ERROR,
+                                "Instance handle does not belong to a matched publication.");
+
+    org::eclipse::cyclonedds::domain::DiscoveryCache::ref_type cache =
+            this->td_.domain_participant().delegate()->discovery_cache();
+    if (!cache->publication_data(ih, dataSample)) {
+        /* Not (yet) seen on DCPSPublication: ask ddsc, which reports it as
+         * an error when it was unmatched in the meantime. The result is not
+         * cached, as the listener of the cache may have processed a newer
+         * sample or the disposal of the publication in the meantime. */
+        dds_builtintopic_endpoint_t *endpoint = dds_get_matched_publication_data(ddsc_entity, ih);
+        ISOCPP_BOOL_CHECK_AND_THROW(endpoint, ISOCPP_INVALID_ARGUMENT_ERROR,
+                                    "Instance handle does not belong to a matched publication.");
+        org::eclipse::cyclonedds::topic::copyOut(*endpoint, dataSample);
+        dds_builtintopic_free_endpoint(endpoint);
+    }
     return dataSample;
 }
 
+void
+AnyDataReaderDelegate::on_matched(
+    dds_entity_t reader,
+    dds_instance_handle_t last_handle,
+    uint32_t current_count)
+{
+    this->matched_.update(reader, last_handle, current_count);
+}
+
 void
 AnyDataReaderDelegate::close()
 {
@@ -57,7 +57,8 @@ org::eclipse::cyclonedds::sub::BuiltinSubscriberDelegate::BuiltinSubscriberDeleg
     const dds::sub::qos::SubscriberQos& qos) :
         SubscriberDelegate(dp, qos, NULL, dds::core::status::StatusMask::none())
 {
-
+    /* Make sure the participant keeps track of the discovery data from now on. */
+    (void)dp.delegate()->discovery_cache();
 }
 
 
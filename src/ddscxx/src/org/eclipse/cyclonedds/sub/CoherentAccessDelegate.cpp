@@ -0,0 +1,65 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+
+
+/**
+ * @file
+ */
+
+#include <org/eclipse/cyclonedds/sub/CoherentAccessDelegate.hpp>
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace sub
+{
+
+CoherentAccessDelegate::CoherentAccessDelegate(const dds::sub::Subscriber s) :
+    sub(s),
+    ended(false)
+{
+    this->sub.delegate()->begin_coherent_access();
+}
+
+CoherentAccessDelegate::~CoherentAccessDelegate()
+{
+    if (!this->ended) {
+        try {
+            this->end();
+        } catch (...) {
+
+        }
+    }
+}
+
+void
+CoherentAccessDelegate::end()
+{
+    if (!this->ended) {
+        this->sub.delegate()->end_coherent_access();
+        this->ended = true;
+    }
+}
+
+bool
+CoherentAccessDelegate::operator==(const CoherentAccessDelegate& other) const
+{
+    return this->sub == other.sub && this->ended == other.ended;
+}
+
+}
+}
+}
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+
+
+/**
+ * @file
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+
+#include <org/eclipse/cyclonedds/sub/DecoderPool.hpp>
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace sub
+{
+
+/* Shared with the workers, so that they never outlive what they use. */
+struct DecoderPool::state
+{
+    explicit state(uint32_t n)
+        : nthreads(n), func(NULL), count(0), chunk(1), next(0),
+          generation(0), busy(0), terminate(false)
+    {
+    }
+
+    static void run(std::shared_ptr<state> st);
+    void work();
+
+    const uint32_t nthreads;
+
+    std::mutex mutex;
+    std::condition_variable work_cond;
+    std::condition_variable done_cond;
+
+    /* The current job, only changed while no worker is busy. */
+    const std::function<void(size_t)> *func;
+    size_t count;
+    size_t chunk;
+    std::atomic<size_t> next;
+    std::exception_ptr error;
+
+    uint64_t generation;
+    uint32_t busy;
+    bool terminate;
+};
+
+/* Claims chunks of indices until none are left. */
+void
+DecoderPool::state::work()
+{
+    size_t begin;
+    while ((begin = this->next.fetch_add(this->chunk, std::memory_order_relaxed)) < this->count) {
+        size_t end = std::min(begin + this->chunk, this->count);
+        try {
+            for (size_t i = begin; i < end; i++) {
+                (*this->func)(i);
+            }
+        } catch (...) {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            if (!this->error) {
+                this->error = std::current_exception();
+            }
+            /* Leave the remainder, the caller gets the exception anyway. */
+            this->next.store(this->count, std::memory_order_relaxed);
+        }
+    }
+}
+
+void
+DecoderPool::state::run(std::shared_ptr<state> st)
+{
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(st->mutex);
+    while (true) {
+        if (st->terminate) {
+            break;
+        }
+        if (st->generation == seen) {
+            st->work_cond.wait(lock);
+            continue;
+        }
+
+        seen = st->generation;
+        lock.unlock();
+        st->work();
+        lock.lock();
+        if (--st->busy == 0) {
+            st->done_cond.notify_all();
+        }
+    }
+}
+
+DecoderPool::DecoderPool(uint32_t threads)
+{
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+        if (threads == 0) {
+            threads = 1;
+        }
+    }
+
+    this->state_ = std::make_shared<state>(threads);
+    for (uint32_t i = 1; i < threads; i++) {
+        this->threads_.push_back(std::thread(&state::run, this->state_));
+    }
+}
+
+DecoderPool::~DecoderPool()
+{
+    std::unique_lock<std::mutex> lock(this->state_->mutex);
+    this->state_->terminate = true;
+    lock.unlock();
+    this->state_->work_cond.notify_all();
+
+    for (std::vector<std::thread>::iterator it = this->threads_.begin(); it != this->threads_.end(); ++it) {
+        it->join();
+    }
+}
+
+void
+DecoderPool::for_each(size_t count, const std::function<void(size_t)>& func)
+{
+    /* Not worth waking up anybody for. */
+    if (count < 2 || this->threads_.empty()) {
+        for (size_t i = 0; i < count; i++) {
+            func(i);
+        }
+        return;
+    }
+
+    std::unique_lock<std::mutex> call_lock(this->call_mutex_);
+    state& st = *this->state_;
+
+    std::unique_lock<std::mutex> lock(st.mutex);
+    st.func = &func;
+    st.count = count;
+    /* A few chunks per thread, to even out samples of different sizes. */
+    st.chunk = std::max<size_t>(1, count / (static_cast<size_t>(st.nthreads) * 4));
+    st.next.store(0, std::memory_order_relaxed);
+    st.error = nullptr;
+    st.busy = static_cast<uint32_t>(this->threads_.size());
+    st.generation++;
+    lock.unlock();
+    st.work_cond.notify_all();
+
+    st.work();
+
+    lock.lock();
+    while (st.busy > 0) {
+        st.done_cond.wait(lock);
+    }
+    st.func = NULL;
+    std::exception_ptr error = st.error;
+    st.error = nullptr;
+    lock.unlock();
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+uint32_t
+DecoderPool::threads() const
+{
+    return this->state_->nthreads;
+}
+
+}
+}
+}
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+
+
+/**
+ * @file
+ */
+
+#include <algorithm>
+
+#include <org/eclipse/cyclonedds/sub/ReaderGroup.hpp>
+#include <org/eclipse/cyclonedds/sub/AnyDataReaderDelegate.hpp>
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace sub
+{
+
+ReaderGroup::ReaderGroup()
+{
+    this->waitset_ = dds_create_waitset(DDS_CYCLONEDDS_HANDLE);
+    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(this->waitset_, "Could not create waitset of reader group.");
+}
+
+ReaderGroup::~ReaderGroup()
+{
+    (void) dds_delete(this->waitset_);
+}
+
+ReaderGroup::tag_type
+ReaderGroup::attach(
+    std::unique_ptr<member>&& m,
+    dds_entity_t reader,
+    const dds::sub::status::DataState& state)
+{
+    tag_type tag = this->members_.size();
+    uint32_t mask = AnyDataReaderDelegate::get_ddsc_state_mask(state);
+
+    m->state = state;
+    m->condition = dds_create_readcondition(reader, mask);
+    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(m->condition, "Could not create read condition of reader group.");
+    dds_return_t ret = dds_waitset_attach(this->waitset_, m->condition, static_cast<dds_attach_t>(tag));
+    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Could not attach reader to reader group.");
+
+    this->members_.push_back(std::move(m));
+    this->triggered_.resize(this->members_.size());
+    return tag;
+}
+
+size_t
+ReaderGroup::take(result_type& result)
+{
+    result.clear();
+    if (this->members_.empty()) {
+        return 0;
+    }
+
+    /* Only returns the conditions that are triggered, without waiting. */
+    dds_return_t n = dds_waitset_wait(this->waitset_, this->triggered_.data(), this->triggered_.size(), 0);
+    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(n, "Could not determine the readers with data.");
+
+    size_t nt = std::min(static_cast<size_t>(n), this->triggered_.size());
+    for (size_t i = 0; i < nt; i++) {
+        tag_type tag = static_cast<tag_type>(this->triggered_[i]);
+        uint32_t length = this->members_[tag]->take();
+        if (length > 0) {
+            batch b = { tag, length };
+            result.push_back(b);
+        }
+    }
+    return result.size();
+}
+
+size_t
+ReaderGroup::size() const
+{
+    return this->members_.size();
+}
+
+}
+}
+}
+}
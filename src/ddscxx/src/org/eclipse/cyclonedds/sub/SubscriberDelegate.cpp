@@ -41,23 +41,23 @@ SubscriberDelegate::SubscriberDelegate(
     dds::sub::SubscriberListener* listener,
     const dds::core::status::StatusMask& event_mask) :
     dp_(dp),
-    qos_(qos)
+    qos_(qos),
+    coherent_access_depth_(0)
 {
     dds_entity_t ddsc_par;
     dds_entity_t ddsc_sub;
-    dds_qos_t* ddsc_qos;
+    org::eclipse::cyclonedds::core::DdscQosCache::qos_ref ddsc_qos;
 
     ddsc_par = static_cast<dds_entity_t>(this->dp_.delegate()->get_ddsc_entity());
     ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ddsc_par, "Could not get subscriber participant.");
 
     qos.delegate().check();
-    ddsc_qos = qos.delegate().ddsc_qos();
+    ddsc_qos = qos.delegate().cached_ddsc_qos();
     if (!ddsc_qos) {
         ISOCPP_THROW_EXCEPTION(ISOCPP_ERROR, "Could not convert subscriber QoS.");
     }
 
-    ddsc_sub = dds_create_subscriber(ddsc_par, ddsc_qos, NULL);
-    dds_delete_qos(ddsc_qos);
+    ddsc_sub = dds_create_subscriber(ddsc_par, ddsc_qos.get(), NULL);
     ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ddsc_sub, "Could not create subscriber.");
     this->set_ddsc_entity(ddsc_sub);
 
@@ -119,17 +119,16 @@ void
 SubscriberDelegate::qos(const dds::sub::qos::SubscriberQos& sqos)
 {
     org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
-    dds_qos_t* ddsc_qos;
+    org::eclipse::cyclonedds::core::DdscQosCache::qos_ref ddsc_qos;
     dds_return_t ret;
 
     sqos.delegate().check();
-    ddsc_qos = sqos.delegate().ddsc_qos();
+    ddsc_qos = sqos.delegate().cached_ddsc_qos();
     if (!ddsc_qos) {
         ISOCPP_THROW_EXCEPTION(ISOCPP_ERROR, "Could not convert subscriber qos.");
     }
 
-    ret = dds_set_qos(ddsc_entity, ddsc_qos);
-    dds_delete_qos(ddsc_qos);
+    ret = dds_set_qos(ddsc_entity, ddsc_qos.get());
     ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Could not set subscriber qos.");
 
     this->qos_ = sqos;
@@ -151,16 +150,40 @@ SubscriberDelegate::default_datareader_qos(const dds::sub::qos::DataReaderQos& d
     this->default_dr_qos_ = drqos;
 }
 
+/*
+ * ddsc only makes the samples of a coherent set available to the readers once
+ * the whole set has been received, so readers never observe partial sets
+ * regardless of coherent access. Accesses can be nested; only the outermost
+ * one is passed on to ddsc, which is allowed to not support it.
+ */
 void
 SubscriberDelegate::begin_coherent_access()
 {
-    ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR, "Function not currently supported");
+    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
+
+    if (this->coherent_access_depth_ == 0) {
+        dds_return_t ret = dds_begin_coherent(this->get_ddsc_entity());
+        if (ret != DDS_RETCODE_UNSUPPORTED) {
+            ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Could not begin coherent access.");
+        }
+    }
+    this->coherent_access_depth_++;
 }
 
 void
 SubscriberDelegate::end_coherent_access()
 {
-    ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR, "Function not currently supported");
+    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
+
+    ISOCPP_BOOL_CHECK_AND_THROW(this->coherent_access_depth_ > 0, ISOCPP_PRECONDITION_NOT_MET_ERROR,
+                                "No coherent access to end.");
+    if (this->coherent_access_depth_ == 1) {
+        dds_return_t ret = dds_end_coherent(this->get_ddsc_entity());
+        if (ret != DDS_RETCODE_UNSUPPORTED) {
+            ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Could not end coherent access.");
+        }
+    }
+    this->coherent_access_depth_--;
 }
 
 const dds::domain::DomainParticipant&
@@ -198,6 +221,11 @@ SubscriberDelegate::add_datareader(
     org::eclipse::cyclonedds::core::EntityDelegate& datareader)
 {
     this->readers.insert(datareader);
+
+    /* Callbacks go to the executor of the parent, unless told otherwise. */
+    if (!datareader.has_listener_executor()) {
+        datareader.listener_executor(this->listener_executor());
+    }
 }
 
 void
@@ -236,10 +264,33 @@ std::vector<org::eclipse::cyclonedds::sub::AnyDataReaderDelegate::ref_type>
 SubscriberDelegate::get_datareaders(
     const dds::sub::status::DataState& mask)
 {
-    (void)mask;
-    ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR, "Function not currently supported");
-    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
     std::vector<org::eclipse::cyclonedds::sub::AnyDataReaderDelegate::ref_type> _readers;
+
+    org::eclipse::cyclonedds::core::EntitySet::vector entities;
+    org::eclipse::cyclonedds::core::EntitySet::vectorIterator iter;
+    uint32_t ddsc_mask = AnyDataReaderDelegate::get_ddsc_state_mask(mask);
+
+    this->check();
+    entities = this->readers.copy();
+    _readers.reserve(entities.size());
+    for (iter = entities.begin(); iter != entities.end(); ++iter) {
+        org::eclipse::cyclonedds::core::ObjectDelegate::ref_type ref = iter->lock();
+        if (ref) {
+            org::eclipse::cyclonedds::sub::AnyDataReaderDelegate::ref_type tmp =
+                    ::std::dynamic_pointer_cast<AnyDataReaderDelegate>(ref);
+            assert(tmp);
+            /* A read condition tells whether there are matching samples
+             * without changing their sample state, as reading would. */
+            dds_entity_t cond = dds_create_readcondition(tmp->get_ddsc_entity(), ddsc_mask);
+            if (cond > 0) {
+                if (dds_triggered(cond) > 0) {
+                    _readers.push_back(tmp);
+                }
+                (void) dds_delete(cond);
+            }
+        }
+    }
+
     return _readers;
 }
 
@@ -377,6 +428,12 @@ void SubscriberDelegate::on_sample_lost(dds_entity_t reader,
     this->listener()->on_sample_lost(adr, s);
 }
 
+org::eclipse::cyclonedds::core::EntityDelegate*
+SubscriberDelegate::listener_parent() const
+{
+    return this->dp_.delegate().get();
+}
+
 
 
 
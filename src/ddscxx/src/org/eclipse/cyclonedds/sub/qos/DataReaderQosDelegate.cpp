@@ -46,6 +46,7 @@ DataReaderQosDelegate::policy(const dds::core::policy::UserData& user_data)
 {
     user_data.delegate().check();
     user_data_ = user_data;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -53,6 +54,7 @@ DataReaderQosDelegate::policy(const dds::core::policy::Durability& durability)
 {
     durability.delegate().check();
     durability_ = durability;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -60,6 +62,7 @@ DataReaderQosDelegate::policy(const dds::core::policy::Deadline& deadline)
 {
     deadline.delegate().check();
     deadline_ = deadline;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -67,6 +70,7 @@ DataReaderQosDelegate::policy(const dds::core::policy::LatencyBudget&  budget)
 {
     budget.delegate().check();
     budget_ = budget;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -74,6 +78,7 @@ DataReaderQosDelegate::policy(const dds::core::policy::Liveliness& liveliness)
 {
     liveliness.delegate().check();
     liveliness_ = liveliness;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -81,6 +86,7 @@ DataReaderQosDelegate::policy(const dds::core::policy::Reliability& reliability)
 {
     reliability.delegate().check();
     reliability_ = reliability;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -88,6 +94,7 @@ DataReaderQosDelegate::policy(const dds::core::policy::DestinationOrder& order)
 {
     order.delegate().check();
     order_ = order;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -95,6 +102,7 @@ DataReaderQosDelegate::policy(const dds::core::policy::History& history)
 {
     history.delegate().check();
     history_ = history;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -102,6 +110,7 @@ DataReaderQosDelegate::policy(const dds::core::policy::ResourceLimits& resources
 {
     resources.delegate().check();
     resources_ = resources;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -109,6 +118,7 @@ DataReaderQosDelegate::policy(const dds::core::policy::Ownership& ownership)
 {
     ownership.delegate().check();
     ownership_ = ownership;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -116,6 +126,7 @@ DataReaderQosDelegate::policy(const dds::core::policy::TimeBasedFilter& tfilter)
 {
     tfilter.delegate().check();
     tfilter_ = tfilter;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -123,6 +134,7 @@ DataReaderQosDelegate::policy(const dds::core::policy::ReaderDataLifecycle& life
 {
     lifecycle.delegate().check();
     lifecycle_ = lifecycle;
+    ddsc_qos_cache_.invalidate();
 }
 
 dds_qos_t*
@@ -144,10 +156,21 @@ DataReaderQosDelegate::ddsc_qos() const
     return qos;
 }
 
+org::eclipse::cyclonedds::core::DdscQosCache::qos_ref
+DataReaderQosDelegate::cached_ddsc_qos() const
+{
+    org::eclipse::cyclonedds::core::DdscQosCache::qos_ref qos = ddsc_qos_cache_.get();
+    if (!qos) {
+        qos = ddsc_qos_cache_.set(ddsc_qos());
+    }
+    return qos;
+}
+
 void
 DataReaderQosDelegate::ddsc_qos(const dds_qos_t* qos)
 {
     assert(qos);
+    ddsc_qos_cache_.invalidate();
     deadline_    .delegate().set_iso_policy(qos);
     durability_  .delegate().set_iso_policy(qos);
     history_     .delegate().set_iso_policy(qos);
@@ -225,6 +248,7 @@ DataReaderQosDelegate::operator =(const org::eclipse::cyclonedds::topic::qos::To
     history_     = tqos.policy<dds::core::policy::History>();
     resources_   = tqos.policy<dds::core::policy::ResourceLimits>();
     ownership_   = tqos.policy<dds::core::policy::Ownership>();
+    ddsc_qos_cache_.invalidate();
     return *this;
 }
 
@@ -40,7 +40,8 @@ SubscriberQosDelegate::SubscriberQosDelegate(
     : presentation_(other.presentation_),
       partition_(other.partition_),
       group_data_(other.group_data_),
-      entity_factory_(other.entity_factory_)
+      entity_factory_(other.entity_factory_),
+      ddsc_qos_cache_(other.ddsc_qos_cache_)
 {
 }
 
@@ -53,6 +54,7 @@ SubscriberQosDelegate::policy(const dds::core::policy::Presentation& presentatio
 {
     presentation.delegate().check();
     presentation_ = presentation;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -60,6 +62,7 @@ SubscriberQosDelegate::policy(const dds::core::policy::Partition& partition)
 {
     partition.delegate().check();
     partition_ = partition;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -67,6 +70,7 @@ SubscriberQosDelegate::policy(const dds::core::policy::GroupData& group_data)
 {
     group_data.delegate().check();
     group_data_ = group_data;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -74,6 +78,7 @@ SubscriberQosDelegate::policy(const dds::core::policy::EntityFactory& entity_fac
 {
     entity_factory.delegate().check();
     entity_factory_ = entity_factory;
+    ddsc_qos_cache_.invalidate();
 }
 
 dds_qos_t*
@@ -87,10 +92,21 @@ SubscriberQosDelegate::ddsc_qos() const
     return qos;
 }
 
+org::eclipse::cyclonedds::core::DdscQosCache::qos_ref
+SubscriberQosDelegate::cached_ddsc_qos() const
+{
+    org::eclipse::cyclonedds::core::DdscQosCache::qos_ref qos = ddsc_qos_cache_.get();
+    if (!qos) {
+        qos = ddsc_qos_cache_.set(ddsc_qos());
+    }
+    return qos;
+}
+
 void
 SubscriberQosDelegate::ddsc_qos(const dds_qos_t* qos)
 {
     assert(qos);
+    ddsc_qos_cache_.invalidate();
     presentation_   .delegate().set_iso_policy(qos);
     partition_      .delegate().set_iso_policy(qos);
     group_data_     .delegate().set_iso_policy(qos);
@@ -136,6 +152,7 @@ SubscriberQosDelegate::operator =(const SubscriberQosDelegate& other)
     partition_      = other.partition_;
     group_data_     = other.group_data_;
     entity_factory_ = other.entity_factory_;
+    ddsc_qos_cache_ = other.ddsc_qos_cache_;
     return *this;
 }
 
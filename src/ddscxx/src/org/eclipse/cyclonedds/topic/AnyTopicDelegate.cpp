@@ -93,12 +93,11 @@ AnyTopicDelegate::qos(const dds::topic::qos::TopicQos& qos)
     // get and validate the ddsc qos
     org::eclipse::cyclonedds::topic::qos::TopicQosDelegate tQos = qos.delegate();
     tQos.check();
-    dds_qos_t* ddsc_topic = tQos.ddsc_qos();
+    org::eclipse::cyclonedds::core::DdscQosCache::qos_ref ddsc_topic = tQos.cached_ddsc_qos();
     if (!ddsc_topic) {
         ISOCPP_THROW_EXCEPTION(ISOCPP_OUT_OF_RESOURCES_ERROR, "Could not convert topic qos.");
     }
-    ddsc_ret = dds_set_qos(ddsc_entity, ddsc_topic);
-    dds_delete_qos(ddsc_topic);
+    ddsc_ret = dds_set_qos(ddsc_entity, ddsc_topic.get());
     ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ddsc_ret, "Could not set topic qos.");
 
     qos_ = qos;
@@ -0,0 +1,113 @@
+/*
+ * Copyright(c) 2006 to 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+
+
+/**
+ * @file
+ */
+
+#include <cstring>
+
+#include <org/eclipse/cyclonedds/topic/BuiltinTopicCopy.hpp>
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace topic
+{
+
+static void
+guid_to_key(const dds_guid_t &guid, int32_t key[3])
+{
+    memcpy(key, &guid.v[sizeof(guid.v) - 3 * sizeof(int32_t)], 3 * sizeof(int32_t));
+}
+
+void
+copyOut(const dds_builtintopic_participant_t &from, dds::topic::ParticipantBuiltinTopicData &to)
+{
+    int32_t key[3];
+
+    guid_to_key(from.key, key);
+    to.delegate().key(key);
+    if (from.qos) {
+        to.delegate().user_data(from.qos);
+    }
+}
+
+void
+copyOut(const dds_builtintopic_endpoint_t &from, dds::topic::PublicationBuiltinTopicData &to)
+{
+    int32_t key[3];
+    org::eclipse::cyclonedds::topic::PublicationBuiltinTopicDataDelegate &d = to.delegate();
+
+    guid_to_key(from.key, key);
+    d.key(key);
+    guid_to_key(from.participant_key, key);
+    d.participant_key(key);
+    d.topic_name(from.topic_name ? from.topic_name : "");
+    d.type_name(from.type_name ? from.type_name : "");
+    if (from.qos) {
+        d.durability(from.qos);
+        d.deadline(from.qos);
+        d.latency_budget(from.qos);
+        d.liveliness(from.qos);
+        d.reliability(from.qos);
+        d.lifespan(from.qos);
+        d.destination_order(from.qos);
+        d.ownership(from.qos);
+#ifdef  OMG_DDS_OWNERSHIP_SUPPORT
+        d.ownership_strength(from.qos);
+#endif  // OMG_DDS_OWNERSHIP_SUPPORT
+        d.partition(from.qos);
+        d.presentation(from.qos);
+        d.topic_data(from.qos);
+        d.user_data(from.qos);
+        d.group_data(from.qos);
+    }
+}
+
+void
+copyOut(const dds_builtintopic_endpoint_t &from, dds::topic::SubscriptionBuiltinTopicData &to)
+{
+    int32_t key[3];
+    org::eclipse::cyclonedds::topic::SubscriptionBuiltinTopicDataDelegate &d = to.delegate();
+
+    guid_to_key(from.key, key);
+    d.key(key);
+    guid_to_key(from.participant_key, key);
+    d.participant_key(key);
+    d.topic_name(from.topic_name ? from.topic_name : "");
+    d.type_name(from.type_name ? from.type_name : "");
+    if (from.qos) {
+        d.durability(from.qos);
+        d.deadline(from.qos);
+        d.latency_budget(from.qos);
+        d.liveliness(from.qos);
+        d.reliability(from.qos);
+        d.destination_order(from.qos);
+        d.time_based_filter(from.qos);
+        d.ownership(from.qos);
+        d.topic_data(from.qos);
+        d.partition(from.qos);
+        d.presentation(from.qos);
+        d.user_data(from.qos);
+        d.group_data(from.qos);
+    }
+}
+
+}
+}
+}
+}
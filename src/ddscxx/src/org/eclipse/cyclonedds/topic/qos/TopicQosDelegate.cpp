@@ -40,6 +40,7 @@ TopicQosDelegate::policy(const dds::core::policy::TopicData& topic_data)
 {
     topic_data.delegate().check();
     topic_data_ = topic_data;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -47,6 +48,7 @@ TopicQosDelegate::policy(const dds::core::policy::Durability& durability)
 {
     durability.delegate().check();
     durability_ = durability;
+    ddsc_qos_cache_.invalidate();
 }
 
 #ifdef  OMG_DDS_PERSISTENCE_SUPPORT
@@ -55,6 +57,7 @@ TopicQosDelegate::policy(const dds::core::policy::DurabilityService& durability_
 {
     durability_service.delegate().check();
     durability_service_ = durability_service;
+    ddsc_qos_cache_.invalidate();
 }
 #endif  // OMG_DDS_PERSISTENCE_SUPPORT
 
@@ -63,6 +66,7 @@ TopicQosDelegate::policy(const dds::core::policy::Deadline& deadline)
 {
     deadline.delegate().check();
     deadline_ = deadline;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -70,6 +74,7 @@ TopicQosDelegate::policy(const dds::core::policy::LatencyBudget&  budget)
 {
     budget.delegate().check();
     budget_ = budget;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -77,6 +82,7 @@ TopicQosDelegate::policy(const dds::core::policy::Liveliness& liveliness)
 {
     liveliness.delegate().check();
     liveliness_ = liveliness;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -84,6 +90,7 @@ TopicQosDelegate::policy(const dds::core::policy::Reliability& reliability)
 {
     reliability.delegate().check();
     reliability_ = reliability;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -91,6 +98,7 @@ TopicQosDelegate::policy(const dds::core::policy::DestinationOrder& order)
 {
     order.delegate().check();
     order_ = order;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -98,6 +106,7 @@ TopicQosDelegate::policy(const dds::core::policy::History& history)
 {
     history.delegate().check();
     history_ = history;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -105,6 +114,7 @@ TopicQosDelegate::policy(const dds::core::policy::ResourceLimits& resources)
 {
     resources.delegate().check();
     resources_ = resources;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -112,6 +122,7 @@ TopicQosDelegate::policy(const dds::core::policy::TransportPriority& priority)
 {
     priority.delegate().check();
     priority_ = priority;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -119,6 +130,7 @@ TopicQosDelegate::policy(const dds::core::policy::Lifespan& lifespan)
 {
     lifespan.delegate().check();
     lifespan_ = lifespan;
+    ddsc_qos_cache_.invalidate();
 }
 
 void
@@ -126,6 +138,7 @@ TopicQosDelegate::policy(const dds::core::policy::Ownership& ownership)
 {
     ownership.delegate().check();
     ownership_ = ownership;
+    ddsc_qos_cache_.invalidate();
 }
 
 dds_qos_t*
@@ -153,10 +166,21 @@ TopicQosDelegate::ddsc_qos() const
     return qos;
 }
 
+org::eclipse::cyclonedds::core::DdscQosCache::qos_ref
+TopicQosDelegate::cached_ddsc_qos() const
+{
+    org::eclipse::cyclonedds::core::DdscQosCache::qos_ref qos = ddsc_qos_cache_.get();
+    if (!qos) {
+        qos = ddsc_qos_cache_.set(ddsc_qos());
+    }
+    return qos;
+}
+
 void
 TopicQosDelegate::ddsc_qos(const dds_qos_t* qos)
 {
     assert(qos);
+    ddsc_qos_cache_.invalidate();
     topic_data_  .delegate().set_iso_policy(qos);
     durability_  .delegate().set_iso_policy(qos);
 #ifdef  OMG_DDS_PERSISTENCE_SUPPORT
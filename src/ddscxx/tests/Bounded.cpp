@@ -11,10 +11,13 @@
  */
 #include <gtest/gtest.h>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 #include "Util.hpp"
 #include "dds/dds.hpp"
 #include "Serialization.hpp"
+#include "Inline.hpp"
 
 /**
  * Fixture for the tests
@@ -225,3 +228,61 @@ TEST_F(Bounds, boolean)
         TryWriteBooleanSequence(256);
     }, dds::core::InvalidArgumentError) << "Writing a boolean sequence with length in excess of its bound did not throw an exception.";
 }
+
+/**
+ * Types generated with "-f inline-max-elements=32" store bounded members of
+ * at most 32 elements inline
+ */
+static_assert(std::is_same<std::remove_reference<decltype(std::declval<Inline::Msg&>().name())>::type,
+                           dds::core::bounded_string<32> >::value,
+              "string<32> must map to an inline bounded string");
+static_assert(std::is_same<std::remove_reference<decltype(std::declval<Inline::Msg&>().items())>::type,
+                           dds::core::bounded_sequence<Inline::Item, 4> >::value,
+              "sequence<Item, 4> must map to an inline bounded sequence");
+static_assert(std::is_same<std::remove_reference<decltype(std::declval<Inline::Msg&>().large())>::type,
+                           std::string>::value,
+              "string<64> exceeds the inline maximum");
+
+TEST(InlineBounds, containers)
+{
+    dds::core::bounded_string<8> str("12345678");
+    ASSERT_EQ(str, "12345678");
+    ASSERT_THROW(str.push_back('9'), std::length_error);
+    ASSERT_THROW(str = std::string("123456789"), std::length_error);
+
+    dds::core::bounded_sequence<float, 2> seq{1.0f, 2.0f};
+    ASSERT_EQ(seq.size(), 2u);
+    ASSERT_THROW(seq.push_back(3.0f), std::length_error);
+    ASSERT_THROW(seq.resize(3), std::length_error);
+    seq.pop_back();
+    ASSERT_EQ(seq.size(), 1u);
+}
+
+TEST(InlineBounds, self_contained)
+{
+    ASSERT_TRUE(org::eclipse::cyclonedds::topic::TopicTraits<Inline::Item>::isSelfContained());
+    /* The large string is still allocated on the heap. */
+    ASSERT_FALSE(org::eclipse::cyclonedds::topic::TopicTraits<Inline::Msg>::isSelfContained());
+}
+
+TEST(InlineBounds, write_read)
+{
+    char topicname[64];
+    dds::domain::DomainParticipant participant(org::eclipse::cyclonedds::domain::default_id());
+    create_unique_topic_name("inline_bounds_test_topic", topicname, sizeof(topicname));
+    dds::topic::Topic<Inline::Msg> topic(participant, topicname);
+    dds::pub::DataWriter<Inline::Msg> writer(dds::pub::Publisher(participant), topic);
+    dds::sub::DataReader<Inline::Msg> reader(dds::sub::Subscriber(participant), topic);
+
+    Inline::Msg msg;
+    msg.id(1);
+    msg.name("a name of 32 characters at most");
+    msg.values().assign(16, 0.5f);
+    msg.items().emplace_back(dds::core::bounded_string<8>("label"), 1.5f);
+    msg.large(std::string(64, 'x'));
+    writer.write(msg);
+
+    auto samples = reader.take();
+    ASSERT_EQ(samples.length(), 1u);
+    ASSERT_EQ(samples.begin()->data(), msg);
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+#include "dds/dds.hpp"
+
+#include "Util.hpp"
+#include "Space.hpp"
+#include "HelloWorldData.hpp"
+
+class Coherent : public ::testing::Test
+{
+public:
+    dds::domain::DomainParticipant participant;
+    dds::pub::Publisher publisher;
+    dds::sub::Subscriber subscriber;
+    dds::sub::DataReader<Space::Type1> reader1;
+    dds::sub::DataReader<HelloWorldData::Msg> reader2;
+    dds::pub::DataWriter<Space::Type1> writer1;
+    dds::pub::DataWriter<HelloWorldData::Msg> writer2;
+
+    Coherent() :
+        participant(dds::core::null),
+        publisher(dds::core::null),
+        subscriber(dds::core::null),
+        reader1(dds::core::null),
+        reader2(dds::core::null),
+        writer1(dds::core::null),
+        writer2(dds::core::null)
+    {
+    }
+
+    void SetUp()
+    {
+        char name1[64], name2[64];
+        create_unique_topic_name("ddscxx_coherent_1", name1, sizeof(name1));
+        create_unique_topic_name("ddscxx_coherent_2", name2, sizeof(name2));
+
+        this->participant = dds::domain::DomainParticipant(org::eclipse::cyclonedds::domain::default_id());
+        dds::topic::Topic<Space::Type1> topic1(this->participant, name1);
+        dds::topic::Topic<HelloWorldData::Msg> topic2(this->participant, name2);
+
+        /* Coherent sets that span the writers of the publisher. */
+        dds::core::policy::Presentation group = dds::core::policy::Presentation::GroupAccessScope(true, false);
+        this->publisher = dds::pub::Publisher(this->participant,
+            this->participant.default_publisher_qos() << group);
+        this->subscriber = dds::sub::Subscriber(this->participant,
+            this->participant.default_subscriber_qos() << group);
+
+        dds::sub::qos::DataReaderQos rqos = this->subscriber.default_datareader_qos();
+        rqos << dds::core::policy::Reliability::Reliable()
+             << dds::core::policy::History::KeepAll();
+        this->reader1 = dds::sub::DataReader<Space::Type1>(this->subscriber, topic1, rqos);
+        this->reader2 = dds::sub::DataReader<HelloWorldData::Msg>(this->subscriber, topic2, rqos);
+
+        dds::pub::qos::DataWriterQos wqos = this->publisher.default_datawriter_qos();
+        wqos << dds::core::policy::Reliability::Reliable()
+             << dds::core::policy::History::KeepAll();
+        this->writer1 = dds::pub::DataWriter<Space::Type1>(this->publisher, topic1, wqos);
+        this->writer2 = dds::pub::DataWriter<HelloWorldData::Msg>(this->publisher, topic2, wqos);
+    }
+
+    void TearDown()
+    {
+        this->writer2 = dds::core::null;
+        this->writer1 = dds::core::null;
+        this->reader2 = dds::core::null;
+        this->reader1 = dds::core::null;
+        this->subscriber = dds::core::null;
+        this->publisher = dds::core::null;
+        this->participant = dds::core::null;
+    }
+};
+
+TEST_F(Coherent, no_partial_sets)
+{
+    for (int32_t i = 0; i < 10; i++) {
+        dds::pub::CoherentSet set(this->publisher);
+        this->writer1 << Space::Type1(i, i, i);
+        this->writer2 << HelloWorldData::Msg(i, "coherent");
+
+        /* Nothing of the set is visible before it has ended. */
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        ASSERT_EQ(this->reader1.read().length(), 0u);
+        ASSERT_EQ(this->reader2.read().length(), 0u);
+
+        this->writer1 << Space::Type1(i + 100, i, i);
+        set.end();
+
+        /* Then all of it is. */
+        dds::sub::LoanedSamples<Space::Type1> s1;
+        dds::sub::LoanedSamples<HelloWorldData::Msg> s2;
+        for (int n = 0; n < 500; n++) {
+            s1 = this->reader1.read();
+            s2 = this->reader2.read();
+            if (s1.length() > 0 || s2.length() > 0) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        ASSERT_EQ(s1.length(), 2u);
+        ASSERT_EQ(s2.length(), 1u);
+        ASSERT_EQ(s2.begin()->data().userID(), i);
+
+        (void) this->reader1.take();
+        (void) this->reader2.take();
+    }
+}
+
+TEST_F(Coherent, coherent_access)
+{
+    this->writer1 << Space::Type1(1, 1, 1);
+    for (int n = 0; n < 500 && this->reader1.read().length() == 0; n++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    {
+        /* Accesses can be nested. */
+        dds::sub::CoherentAccess outer(this->subscriber);
+        dds::sub::CoherentAccess inner(this->subscriber);
+        inner.end();
+        inner.end();
+        outer.end();
+    }
+    ASSERT_THROW(this->subscriber.delegate()->end_coherent_access(), dds::core::PreconditionNotMetError);
+
+    /* Only the readers with matching data are found. */
+    std::vector<dds::sub::AnyDataReader> readers;
+    dds::sub::find<dds::sub::AnyDataReader>(this->subscriber, dds::sub::status::DataState::any(),
+                                            std::back_inserter(readers));
+    ASSERT_EQ(readers.size(), 1u);
+    ASSERT_EQ(readers[0], dds::sub::AnyDataReader(this->reader1));
+}
+
+TEST_F(Coherent, requires_coherent_access)
+{
+    dds::pub::Publisher plain(this->participant);
+    ASSERT_THROW({
+        dds::pub::CoherentSet set(plain);
+    }, dds::core::PreconditionNotMetError);
+}
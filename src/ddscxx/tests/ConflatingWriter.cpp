@@ -0,0 +1,207 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "dds/dds.hpp"
+#include "org/eclipse/cyclonedds/pub/ConflatingWriter.hpp"
+
+#include "Util.hpp"
+#include "Space.hpp"
+
+using org::eclipse::cyclonedds::pub::ConflatingWriter;
+
+class ConflatingWriterTest : public ::testing::Test
+{
+public:
+    dds::domain::DomainParticipant participant;
+    dds::sub::DataReader<Space::Type1> reader;
+    dds::pub::DataWriter<Space::Type1> writer;
+
+    /* The simulated clock of the conflating writers. */
+    dds::core::Time now;
+
+    ConflatingWriterTest() :
+        participant(dds::core::null),
+        reader(dds::core::null),
+        writer(dds::core::null),
+        now(dds::core::Time::from_secs(100))
+    {
+    }
+
+    void SetUp()
+    {
+        char name[64];
+        create_unique_topic_name("ddscxx_conflating_writer", name, sizeof(name));
+
+        this->participant = dds::domain::DomainParticipant(org::eclipse::cyclonedds::domain::default_id());
+        dds::topic::Topic<Space::Type1> topic(this->participant, name);
+        dds::sub::Subscriber subscriber(this->participant);
+        dds::pub::Publisher publisher(this->participant);
+
+        dds::sub::qos::DataReaderQos rqos = subscriber.default_datareader_qos();
+        rqos << dds::core::policy::Reliability::Reliable()
+             << dds::core::policy::History::KeepAll();
+        this->reader = dds::sub::DataReader<Space::Type1>(subscriber, topic, rqos);
+        this->writer = dds::pub::DataWriter<Space::Type1>(publisher, topic);
+    }
+
+    void TearDown()
+    {
+        this->writer = dds::core::null;
+        this->reader = dds::core::null;
+        this->participant = dds::core::null;
+    }
+
+    ConflatingWriter<Space::Type1>::clock_type clock()
+    {
+        return [this]() { return this->now; };
+    }
+};
+
+TEST_F(ConflatingWriterTest, rate_limit)
+{
+    ConflatingWriter<Space::Type1> cw(this->writer, dds::core::Duration::from_millisecs(10), this->clock());
+    ASSERT_EQ(cw.next_deadline(), dds::core::Time::invalid());
+
+    /* The first sample of an instance goes out right away. */
+    ASSERT_TRUE(cw.write(Space::Type1(1, 0, 0)));
+    ASSERT_EQ(this->reader.take().length(), 1u);
+
+    /* The burst that follows within the period is held back, only the last
+     * sample of it survives. */
+    for (int32_t i = 1; i <= 5; i++) {
+        ASSERT_FALSE(cw.write(Space::Type1(1, i, 0)));
+    }
+    ASSERT_EQ(cw.pending(), 1u);
+    ASSERT_EQ(cw.dropped(), 4u);
+    ASSERT_EQ(cw.next_deadline(), this->now + dds::core::Duration::from_millisecs(10));
+
+    /* Other instances have periods of their own. */
+    ASSERT_TRUE(cw.write(Space::Type1(2, 0, 0)));
+    ASSERT_EQ(this->reader.take().length(), 1u);
+
+    this->now += dds::core::Duration::from_millisecs(5);
+    ASSERT_EQ(cw.poll(), 0u);
+    ASSERT_EQ(this->reader.take().length(), 0u);
+
+    this->now += dds::core::Duration::from_millisecs(5);
+    ASSERT_EQ(cw.poll(), 1u);
+    dds::sub::LoanedSamples<Space::Type1> samples = this->reader.take();
+    ASSERT_EQ(samples.length(), 1u);
+    ASSERT_EQ(samples.begin()->data().long_1(), 1);
+    ASSERT_EQ(samples.begin()->data().long_2(), 5);
+    ASSERT_EQ(cw.pending(), 0u);
+
+    /* Published by the poll, so the period starts anew. */
+    ASSERT_FALSE(cw.write(Space::Type1(1, 6, 0)));
+    this->now += dds::core::Duration::from_millisecs(10);
+    ASSERT_TRUE(cw.write(Space::Type1(1, 7, 0)));
+    samples = this->reader.take();
+    ASSERT_EQ(samples.length(), 1u);
+    ASSERT_EQ(samples.begin()->data().long_2(), 7);
+    ASSERT_EQ(cw.dropped(), 5u);
+}
+
+TEST_F(ConflatingWriterTest, flush)
+{
+    ConflatingWriter<Space::Type1> cw(this->writer, dds::core::Duration::from_secs(1), this->clock());
+
+    for (int32_t key = 0; key < 3; key++) {
+        ASSERT_TRUE(cw.write(Space::Type1(key, 0, 0)));
+        ASSERT_FALSE(cw.write(Space::Type1(key, 1, 0)));
+    }
+    ASSERT_EQ(this->reader.take().length(), 3u);
+    ASSERT_EQ(cw.poll(), 0u);
+
+    /* Regardless of the period. */
+    ASSERT_EQ(cw.flush(), 3u);
+    ASSERT_EQ(cw.pending(), 0u);
+    dds::sub::LoanedSamples<Space::Type1> samples = this->reader.take();
+    ASSERT_EQ(samples.length(), 3u);
+    for (dds::sub::LoanedSamples<Space::Type1>::const_iterator it = samples.begin(); it != samples.end(); ++it) {
+        ASSERT_EQ(it->data().long_2(), 1);
+    }
+}
+
+TEST_F(ConflatingWriterTest, deadline_order)
+{
+    ConflatingWriter<Space::Type1> cw(this->writer, dds::core::Duration::from_millisecs(10), this->clock());
+    dds::core::Time start = this->now;
+
+    /* Instances published 2ms apart, held back in the reverse order. */
+    for (int32_t key = 0; key < 3; key++) {
+        ASSERT_TRUE(cw.write(Space::Type1(key, 0, 0)));
+        this->now += dds::core::Duration::from_millisecs(2);
+    }
+    for (int32_t key = 2; key >= 0; key--) {
+        ASSERT_FALSE(cw.write(Space::Type1(key, 1, 0)));
+    }
+    ASSERT_EQ(this->reader.take().length(), 3u);
+    ASSERT_EQ(cw.next_deadline(), start + dds::core::Duration::from_millisecs(10));
+
+    /* Only those that are due are published, in the order of their deadlines. */
+    this->now = start + dds::core::Duration::from_millisecs(12);
+    ASSERT_EQ(cw.poll(), 2u);
+    ASSERT_EQ(cw.pending(), 1u);
+    ASSERT_EQ(cw.next_deadline(), start + dds::core::Duration::from_millisecs(14));
+    dds::sub::LoanedSamples<Space::Type1> samples = this->reader.take();
+    ASSERT_EQ(samples.length(), 2u);
+
+    /* An instance that stayed idle for a period is published right away. */
+    this->now += dds::core::Duration::from_millisecs(100);
+    ASSERT_EQ(cw.poll(), 1u);
+    this->now += dds::core::Duration::from_millisecs(100);
+    ASSERT_TRUE(cw.write(Space::Type1(0, 2, 0)));
+    ASSERT_EQ(cw.pending(), 0u);
+}
+
+TEST_F(ConflatingWriterTest, background)
+{
+    /* On the real clock, as the thread sleeps until the deadlines. */
+    ConflatingWriter<Space::Type1> cw(this->writer, dds::core::Duration::from_millisecs(10));
+    cw.start();
+
+    ASSERT_TRUE(cw.write(Space::Type1(1, 0, 0)));
+    ASSERT_FALSE(cw.write(Space::Type1(1, 1, 0)));
+    ASSERT_FALSE(cw.write(Space::Type1(1, 2, 0)));
+
+    /* The last sample of the burst goes out without a poll(). */
+    std::vector<int32_t> values;
+    for (int i = 0; i < 100 && values.size() < 2; i++) {
+        dds::sub::LoanedSamples<Space::Type1> samples = this->reader.take();
+        for (dds::sub::LoanedSamples<Space::Type1>::const_iterator it = samples.begin(); it != samples.end(); ++it) {
+            values.push_back(it->data().long_2());
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(values, std::vector<int32_t>({ 0, 2 }));
+    ASSERT_EQ(cw.pending(), 0u);
+    ASSERT_EQ(cw.dropped(), 1u);
+
+    /* After stopping, it is up to the application again. */
+    cw.stop();
+    ASSERT_FALSE(cw.write(Space::Type1(1, 3, 0)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_EQ(cw.pending(), 1u);
+    ASSERT_EQ(cw.poll(), 1u);
+}
+
+TEST_F(ConflatingWriterTest, invalid_period)
+{
+    ASSERT_THROW({
+        ConflatingWriter<Space::Type1> cw(this->writer, dds::core::Duration::zero());
+    }, dds::core::InvalidArgumentError);
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+
+#include "dds/dds.hpp"
+#include "org/eclipse/cyclonedds/core/Coroutines.hpp"
+
+#include "Util.hpp"
+#include "HelloWorldData.hpp"
+
+#if defined(CYCLONEDDS_HAS_COROUTINES)
+
+using org::eclipse::cyclonedds::core::CoroutineScheduler;
+using org::eclipse::cyclonedds::core::Task;
+
+class Coroutines : public ::testing::Test
+{
+public:
+    dds::domain::DomainParticipant participant;
+    dds::topic::Topic<HelloWorldData::Msg> topic;
+    dds::sub::DataReader<HelloWorldData::Msg> reader;
+    dds::pub::DataWriter<HelloWorldData::Msg> writer;
+
+    Coroutines() :
+        participant(dds::core::null),
+        topic(dds::core::null),
+        reader(dds::core::null),
+        writer(dds::core::null)
+    {
+    }
+
+    void SetUp()
+    {
+        char topic_name[64];
+        create_unique_topic_name("ddscxx_coroutines", topic_name, sizeof(topic_name));
+
+        this->participant = dds::domain::DomainParticipant(org::eclipse::cyclonedds::domain::default_id());
+        this->topic = dds::topic::Topic<HelloWorldData::Msg>(this->participant, topic_name);
+
+        dds::sub::qos::DataReaderQos rqos;
+        rqos << dds::core::policy::Reliability::Reliable()
+             << dds::core::policy::History::KeepAll();
+        this->reader = dds::sub::DataReader<HelloWorldData::Msg>(
+            dds::sub::Subscriber(this->participant), this->topic, rqos);
+
+        dds::pub::qos::DataWriterQos wqos;
+        wqos << dds::core::policy::Reliability::Reliable()
+             << dds::core::policy::History::KeepAll();
+        this->writer = dds::pub::DataWriter<HelloWorldData::Msg>(
+            dds::pub::Publisher(this->participant), this->topic, wqos);
+    }
+
+    void TearDown()
+    {
+        this->writer = dds::core::null;
+        this->reader = dds::core::null;
+        this->topic = dds::core::null;
+        this->participant = dds::core::null;
+    }
+};
+
+static Task
+take_samples(CoroutineScheduler& scheduler,
+             dds::sub::DataReader<HelloWorldData::Msg> reader,
+             uint32_t expected,
+             std::promise<uint32_t>& done)
+{
+    uint32_t received = 0;
+    while (received < expected) {
+        dds::sub::LoanedSamples<HelloWorldData::Msg> samples = co_await scheduler.take(reader);
+        for (auto it = samples.begin(); it != samples.end(); ++it) {
+            if (it->info().valid()) {
+                received++;
+            }
+        }
+    }
+    done.set_value(received);
+}
+
+static Task
+wait_condition(CoroutineScheduler& scheduler,
+               dds::core::cond::Condition cond,
+               std::atomic<uint32_t>& woken)
+{
+    co_await scheduler.wait(cond);
+    woken++;
+}
+
+static Task
+wait_acknowledgments(CoroutineScheduler& scheduler,
+                     dds::pub::AnyDataWriter writer,
+                     std::promise<bool>& done)
+{
+    bool acknowledged = co_await scheduler.wait_for_acknowledgments(writer, dds::core::Duration::from_secs(5));
+    done.set_value(acknowledged);
+}
+
+TEST_F(Coroutines, take)
+{
+    CoroutineScheduler scheduler(2);
+    std::promise<uint32_t> done;
+    std::future<uint32_t> result = done.get_future();
+    const uint32_t n_samples = 20;
+
+    take_samples(scheduler, reader, n_samples, done);
+    for (uint32_t i = 0; i < n_samples; i++) {
+        writer << HelloWorldData::Msg(static_cast<int32_t>(i), "coroutine");
+    }
+
+    ASSERT_EQ(result.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    ASSERT_EQ(result.get(), n_samples);
+
+    // Every suspension waited on the same read condition
+    dds_entity_t ddsc_reader = reader.delegate()->get_ddsc_entity();
+    ASSERT_EQ(dds_get_children(ddsc_reader, NULL, 0), 1);
+
+    // Which is one for the reader, not for the coroutine
+    std::promise<uint32_t> again;
+    std::future<uint32_t> again_result = again.get_future();
+    take_samples(scheduler, reader, 1, again);
+    writer << HelloWorldData::Msg(static_cast<int32_t>(n_samples), "coroutine");
+    ASSERT_EQ(again_result.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    ASSERT_EQ(dds_get_children(ddsc_reader, NULL, 0), 1);
+}
+
+TEST_F(Coroutines, conditions)
+{
+    CoroutineScheduler scheduler(2);
+    std::atomic<uint32_t> woken(0);
+    dds::core::cond::GuardCondition guard;
+    dds::sub::cond::ReadCondition rc(reader, dds::sub::status::DataState::any());
+    dds::core::cond::StatusCondition sc(reader);
+    sc.enabled_statuses(dds::core::status::StatusMask::data_available());
+
+    for (int i = 0; i < 10; i++) {
+        wait_condition(scheduler, guard, woken);
+    }
+    wait_condition(scheduler, rc, woken);
+    wait_condition(scheduler, sc, woken);
+    ASSERT_EQ(woken.load(), 0U);
+
+    guard.trigger_value(true);
+    writer << HelloWorldData::Msg(1, "coroutine");
+
+    for (int i = 0; i < 500 && woken.load() < 12; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(woken.load(), 12U);
+}
+
+TEST_F(Coroutines, wait_for_acknowledgments)
+{
+    CoroutineScheduler scheduler(1);
+    std::promise<bool> done;
+    std::future<bool> result = done.get_future();
+
+    writer << HelloWorldData::Msg(1, "coroutine");
+    wait_acknowledgments(scheduler, writer, done);
+
+    ASSERT_EQ(result.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    ASSERT_TRUE(result.get());
+}
+
+TEST_F(Coroutines, abandoned)
+{
+    std::atomic<uint32_t> woken(0);
+    dds::core::cond::GuardCondition guard;
+    {
+        CoroutineScheduler scheduler(1);
+        wait_condition(scheduler, guard, woken);
+    }
+    guard.trigger_value(true);
+    ASSERT_EQ(woken.load(), 0U);
+}
+
+#endif /* CYCLONEDDS_HAS_COROUTINES */
@@ -11,7 +11,11 @@
  */
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <stdexcept>
+
 #include "dds/dds.hpp"
+#include "org/eclipse/cyclonedds/core/BulkCreate.hpp"
 #include "Space.hpp"
 
 /**
@@ -453,6 +457,36 @@ TEST_F(DataReader, read_SamplesBIIterator)
 }
 
 
+TEST_F(DataReader, read_SamplePool)
+{
+    static const uint32_t MAX_INSTANCES = 5;
+    org::eclipse::cyclonedds::sub::SamplePool<Space::Type1> pool(3);
+    std::vector<Space::Type1> test_samples;
+    uint32_t len;
+
+    /* Create and write data. */
+    test_samples = this->WriteData(MAX_INSTANCES);
+
+    /* The pool limits the number of samples that are read. */
+    len = this->reader->read(pool);
+    ASSERT_EQ(len, 3u);
+    ASSERT_EQ(pool.length(), 3u);
+    for (uint32_t i = 0; i < len; i++) {
+        ASSERT_EQ(pool[i].data(), test_samples[i]);
+        ASSERT_EQ(pool[i].info().state().sample_state(), dds::sub::status::SampleState::not_read());
+    }
+
+    /* Reading again reuses the same samples. */
+    const Space::Type1 *first = &pool[0].data();
+    len = this->reader->read(pool);
+    ASSERT_EQ(len, 3u);
+    ASSERT_EQ(&pool[0].data(), first);
+    ASSERT_EQ(pool[0].data(), test_samples[0]);
+    ASSERT_EQ(pool[0].info().state().sample_state(), dds::sub::status::SampleState::read());
+    ASSERT_EQ(static_cast<uint32_t>(std::distance(pool.begin(), pool.end())), len);
+}
+
+
 TEST_F(DataReader, read_default_filter_read)
 {
     dds::sub::status::DataState state =
@@ -664,6 +698,66 @@ TEST_F(DataReader, take_no_data)
 }
 
 
+TEST_F(DataReader, try_take)
+{
+    dds::sub::LoanedSamples<Space::Type1> samples;
+    std::vector<Space::Type1> test_samples;
+
+    /* Create reader. */
+    this->CreateReader();
+    ASSERT_EQ(this->reader.delegate()->try_take(samples), 0);
+    ASSERT_EQ(samples.length(), 0);
+
+    /* Create and write data. */
+    test_samples = this->WriteData(5);
+
+    /* Check result by taking. */
+    ASSERT_EQ(this->reader.delegate()->try_take(samples), 5);
+    this->CheckData(samples, test_samples);
+
+    /* A closed reader is reported, the samples are left alone. */
+    this->reader.close();
+    ASSERT_EQ(this->reader.delegate()->try_take(samples), DDS_RETCODE_ALREADY_DELETED);
+    ASSERT_EQ(samples.length(), 5);
+}
+
+
+TEST_F(DataReader, take_DecoderPool)
+{
+    org::eclipse::cyclonedds::sub::DecoderPool decoders(4);
+    dds::sub::LoanedSamples<Space::Type1> samples;
+    std::vector<Space::Type1> test_samples;
+
+    /* Create and write data. */
+    test_samples = this->WriteData(50);
+
+    /* Check result by taking, the samples are deserialized already. */
+    samples = this->reader->take(decoders);
+    this->CheckData(samples, test_samples);
+
+    /* Nothing is left to take. */
+    samples = this->reader->take(decoders);
+    ASSERT_EQ(samples.length(), 0);
+
+    /* An exception stops the work and reaches the caller. */
+    std::atomic<size_t> done(0);
+    ASSERT_THROW({
+        decoders.for_each(1000, [&done](size_t i) {
+            if (i == 10) {
+                throw std::runtime_error("decoding failed");
+            }
+            done++;
+        });
+    }, std::runtime_error);
+    ASSERT_LT(done.load(), 1000u);
+
+    /* The pool is still usable afterwards. */
+    done = 0;
+    decoders.for_each(1000, [&done](size_t) { done++; });
+    ASSERT_EQ(done.load(), 1000u);
+}
+
+
 TEST_F(DataReader, take_SamplesFWIterator)
 {
     static const uint32_t MAX_INSTANCES = 5;
@@ -698,6 +792,77 @@ TEST_F(DataReader, take_SamplesBIIterator)
 }
 
 
+TEST_F(DataReader, take_SamplePool)
+{
+    static const uint32_t MAX_INSTANCES = 5;
+    org::eclipse::cyclonedds::sub::SamplePool<Space::Type1> pool(MAX_INSTANCES);
+    std::vector<Space::Type1> test_samples;
+    uint32_t len;
+
+    /* Create and write data. */
+    test_samples = this->WriteData(MAX_INSTANCES);
+
+    /* Check result by taking. */
+    len = this->reader->take(pool);
+    ASSERT_EQ(len, MAX_INSTANCES);
+    for (uint32_t i = 0; i < len; i++) {
+        ASSERT_EQ(pool[i].data(), test_samples[i]);
+    }
+
+    /* Nothing is left to take. */
+    len = this->reader->take(pool);
+    ASSERT_EQ(len, 0u);
+    ASSERT_EQ(pool.length(), 0u);
+    ASSERT_TRUE(pool.begin() == pool.end());
+
+    /* A pool needs room for at least one sample. */
+    ASSERT_THROW({
+        org::eclipse::cyclonedds::sub::SamplePool<Space::Type1> empty(0);
+    }, dds::core::InvalidArgumentError);
+}
+
+
+TEST_F(DataReader, take_latest)
+{
+    static const int32_t MAX_INSTANCES = 3;
+    org::eclipse::cyclonedds::sub::SamplePool<Space::Type1> pool(MAX_INSTANCES);
+    std::vector<Space::Type1> test_samples;
+    uint32_t len;
+
+    /* The default history is KEEP_LAST 1. */
+    this->SetupCommunication();
+    len = this->reader->take_latest(pool);
+    ASSERT_EQ(len, 0u);
+
+    /* Only the last update of every instance is taken. */
+    for (int32_t update = 0; update < 10; update++) {
+        for (int32_t i = 0; i < MAX_INSTANCES; i++) {
+            this->writer.write(Space::Type1(i, update, i));
+        }
+    }
+    for (int32_t i = 0; i < MAX_INSTANCES; i++) {
+        test_samples.push_back(Space::Type1(i, 9, i));
+    }
+    len = this->reader->take_latest(pool);
+    ASSERT_EQ(len, static_cast<uint32_t>(MAX_INSTANCES));
+    for (uint32_t i = 0; i < len; i++) {
+        ASSERT_EQ(pool[i].data(), test_samples[i]);
+    }
+
+    this->writer.write(Space::Type1(1, 10, 1));
+    dds::sub::LoanedSamples<Space::Type1> samples = this->reader->take_latest();
+    ASSERT_EQ(samples.length(), 1u);
+    ASSERT_EQ(samples.begin()->data(), Space::Type1(1, 10, 1));
+
+    /* Keeping more than the latest sample is refused. */
+    dds::sub::DataReader<Space::Type1> keep_all(this->subscriber, this->topic,
+        this->subscriber.default_datareader_qos() << dds::core::policy::History::KeepAll());
+    ASSERT_THROW({
+        keep_all->take_latest(pool);
+    }, dds::core::PreconditionNotMetError);
+}
+
+
 TEST_F(DataReader, take_default_filter_read)
 {
     dds::sub::status::DataState state =
@@ -1195,3 +1360,20 @@ TEST_F(DataReader, use_after_deletion)
         (void)this->reader.take(biter);
     }, dds::core::NullReferenceError);
 }
+
+TEST_F(DataReader, create_datareaders)
+{
+    this->SetupReader();
+
+    std::vector< dds::sub::DataReader<Space::Type1> > readers =
+        org::eclipse::cyclonedds::sub::create_datareaders(
+            this->subscriber, this->topic, 3, this->reliable_qos);
+    ASSERT_EQ(readers.size(), 3U);
+
+    for (size_t i = 0; i < readers.size(); i++) {
+        ASSERT_NE(readers[i], dds::core::null);
+        ASSERT_EQ(readers[i].qos(), this->reliable_qos);
+        /* All readers share the one translation of the QoS. */
+        ASSERT_EQ(readers[i].qos()->cached_ddsc_qos(), this->reliable_qos->cached_ddsc_qos());
+    }
+}
@@ -11,6 +11,7 @@
  */
 #include "dds/dds.hpp"
 #include <gtest/gtest.h>
+#include <future>
 #include "Space.hpp"
 
 
@@ -383,6 +384,25 @@ TEST_F(DataWriter, write_data)
     ReadAndCheckSampleType1(testData, notReadState, true);
 }
 
+TEST_F(DataWriter, try_write)
+{
+    Space::Type1 testData(0,1,2);
+    this->SetupCommunication(false);
+
+    /* Write one sample. */
+    ASSERT_EQ(this->writer.delegate()->try_write(testData), DDS_RETCODE_OK);
+
+    /* Check result. */
+    dds::sub::status::DataState notReadState(dds::sub::status::SampleState::not_read(),
+                                             dds::sub::status::ViewState::new_view(),
+                                             dds::sub::status::InstanceState::alive());
+    ReadAndCheckSampleType1(testData, notReadState, true);
+
+    /* A closed writer is reported instead of thrown. */
+    this->writer.close();
+    ASSERT_EQ(this->writer.delegate()->try_write(testData), DDS_RETCODE_ALREADY_DELETED);
+}
+
 TEST_F(DataWriter, write_InstanceHandle)
 {
     Space::Type1 testInstance(1,0,0);
@@ -607,6 +627,54 @@ TEST_F(DataWriter, writedispose)
     ReadAndCheckSampleType1(testData3, viewedDisposedState,  true);
 }
 
+TEST_F(DataWriter, writedispose_InstanceHandle)
+{
+    Space::Type1 testData1(1,1,1);
+    Space::Type1 testData2(1,2,2);
+    dds::core::InstanceHandle ih;
+    dds::sub::status::DataState notReadState(
+                        dds::sub::status::SampleState::not_read(),
+                        dds::sub::status::ViewState::new_view(),
+                        dds::sub::status::InstanceState::alive());
+    dds::sub::status::DataState notReadDisposedState(
+                        dds::sub::status::SampleState::not_read(),
+                        dds::sub::status::ViewState::new_view(),
+                        dds::sub::status::InstanceState::not_alive_disposed());
+
+    /* Non-default to have history-keep-all. */
+    this->SetupCommunication(true);
+    ih = this->writer.register_instance(testData1);
+    ASSERT_NE(ih, dds::core::null);
+
+    /* Both use the keyhash that was cached when registering. */
+    this->writer.write(testData1, ih);
+    ReadAndCheckSampleType1(testData1, notReadState, true);
+    this->writer->writedispose(testData2, ih);
+    ReadAndCheckSampleType1(testData2, notReadDisposedState, true);
+
+    /* A sample of another instance is not written with the wrong keyhash. */
+    ASSERT_THROW({
+        this->writer.write(Space::Type1(2,1,1), ih);
+    }, dds::core::PreconditionNotMetError);
+
+    /* Neither a handle that is not registered anymore, nor one that was
+     * never registered by the writer, is written by the key. */
+    this->writer.unregister_instance(ih);
+    ASSERT_THROW({
+        this->writer.write(testData1, ih);
+    }, dds::core::PreconditionNotMetError);
+    ASSERT_THROW({
+        this->writer->writedispose(testData1, ih);
+    }, dds::core::PreconditionNotMetError);
+    ASSERT_THROW({
+        this->writer.write(testData1, dds::core::InstanceHandle(ih.delegate().handle() + 1));
+    }, dds::core::PreconditionNotMetError);
+
+    /* Without a handle, the key is used. */
+    this->writer.write(testData1, dds::core::InstanceHandle(dds::core::null));
+    ReadAndCheckSampleType1(testData1, notReadState, true);
+}
+
 TEST_F(DataWriter, dispose_instance)
 {
     static const int32_t MAX_INSTANCES =  5;
@@ -729,24 +797,77 @@ TEST_F(DataWriter, matched_subscriptions_sequence)
 {
     this->SetupCommunication(false);
 
-    /* TODO: Check returned instance handle against the reader instance.
-     * Instance handles are not yet supported. So, this isn't either. */
-    ASSERT_THROW({
-        ::dds::core::InstanceHandleSeq handleSeq;
-        handleSeq = dds::pub::matched_subscriptions(this->writer);
-    }, dds::core::UnsupportedError);
+    ::dds::core::InstanceHandleSeq handleSeq;
+    handleSeq = dds::pub::matched_subscriptions(this->writer);
+    ASSERT_EQ(handleSeq.size(), 1U);
+    ASSERT_EQ(handleSeq[0], this->reader.instance_handle());
 }
 
 TEST_F(DataWriter, matched_subscriptions_array)
 {
     this->SetupCommunication(false);
 
-    /* TODO: Check returned instance handle against the reader instance.
-     * Instance handles are not yet supported. So, this isn't either. */
+    ::dds::core::InstanceHandle handleArr[2]; /* Make sure we have more than enough. */
+    uint32_t cnt = dds::pub::matched_subscriptions(this->writer, handleArr, 2);
+    ASSERT_EQ(cnt, 1U);
+    ASSERT_EQ(handleArr[0], this->reader.instance_handle());
+}
+
+TEST_F(DataWriter, matched_subscription_data)
+{
+    this->SetupCommunication(false);
+
+    ::dds::core::InstanceHandleSeq handleSeq;
+    handleSeq = dds::pub::matched_subscriptions(this->writer);
+    ASSERT_EQ(handleSeq.size(), 1U);
+
+    /* The second lookup is served from the participant's discovery cache. */
+    for (int i = 0; i < 2; i++) {
+        dds::topic::SubscriptionBuiltinTopicData data =
+                dds::pub::matched_subscription_data(this->writer, handleSeq[0]);
+        ASSERT_EQ(data.topic_name(), this->topic.name());
+        ASSERT_EQ(data.type_name(), this->topic.type_name());
+    }
+
     ASSERT_THROW({
-        ::dds::core::InstanceHandle handleArr[2]; /* Make sure we have more than enough. */
-        (void)dds::pub::matched_subscriptions(this->writer, handleArr, 2);
-    }, dds::core::UnsupportedError);
+        (void)dds::pub::matched_subscription_data(this->writer, this->writer.instance_handle());
+    }, dds::core::InvalidArgumentError);
+
+    /* A subscription that has been discovered, but is not matched, is not
+     * found in the discovery cache either. */
+    dds::topic::Topic<Space::Type1> other(this->participant, "matched_subscription_data_other");
+    dds::sub::DataReader<Space::Type1> unmatched(this->subscriber, other);
+    for (int i = 0; i < 2; i++) {
+        ASSERT_THROW({
+            (void)dds::pub::matched_subscription_data(this->writer, unmatched.instance_handle());
+        }, dds::core::InvalidArgumentError);
+        dds_sleepfor(DDS_MSECS(100));
+    }
+
+    /* Once the reader is gone, its subscription is no longer matched. */
+    this->reader = dds::core::null;
+    for (int i = 0; i < 100 && this->writer.publication_matched_status().current_count() > 0; i++) {
+        dds_sleepfor(DDS_MSECS(10));
+    }
+    ASSERT_EQ(this->writer.publication_matched_status().current_count(), 0);
+    ASSERT_THROW({
+        (void)dds::pub::matched_subscription_data(this->writer, handleSeq[0]);
+    }, dds::core::InvalidArgumentError);
+}
+
+TEST_F(DataWriter, matched_publications)
+{
+    this->SetupCommunication(false);
+
+    ::dds::core::InstanceHandleSeq handleSeq;
+    handleSeq = dds::sub::matched_publications(this->reader);
+    ASSERT_EQ(handleSeq.size(), 1U);
+    ASSERT_EQ(handleSeq[0], this->writer.instance_handle());
+
+    dds::topic::PublicationBuiltinTopicData data =
+            dds::sub::matched_publication_data(this->reader, handleSeq[0]);
+    ASSERT_EQ(data.topic_name(), this->topic.name());
+    ASSERT_EQ(data.type_name(), this->topic.type_name());
 }
 
 TEST_F(DataWriter, shift_sample)
@@ -850,6 +971,151 @@ TEST_F(DataWriter, lookup_instance)
     ASSERT_EQ(ih_found2, ih_registered2);
 }
 
+TEST_F(DataWriter, register_instances)
+{
+    std::vector<Space::Type1> testData;
+    dds::core::InstanceHandleSeq handles;
+    dds::core::InstanceHandleSeq again;
+
+    testData.push_back(Space::Type1(111,100,200));
+    testData.push_back(Space::Type1(112,100,200));
+    testData.push_back(Space::Type1(113,100,200));
+
+    this->SetupCommunication(false);
+
+    /* Register all samples in one go. */
+    handles = this->writer->register_instances(testData.begin(), testData.end());
+    ASSERT_EQ(handles.size(), testData.size());
+    for (size_t i = 0; i < testData.size(); i++) {
+        ASSERT_NE(handles[i], dds::core::null);
+        ASSERT_EQ(handles[i], this->writer.lookup_instance(testData[i]));
+    }
+
+    /* Registering known instances again returns the same handles. */
+    again = this->writer->register_instances(testData.begin(), testData.end());
+    ASSERT_EQ(again, handles);
+    ASSERT_EQ(this->writer.register_instance(testData[1]), handles[1]);
+
+    /* Writing the registered instances is not affected by the cache. */
+    this->writer.write(testData.begin(), testData.end());
+    dds::sub::status::DataState state(dds::sub::status::SampleState::not_read(),
+                                      dds::sub::status::ViewState::new_view(),
+                                      dds::sub::status::InstanceState::alive());
+    for (size_t i = 0; i < testData.size(); i++) {
+        this->ReadAndCheckSampleType1(testData[i], state, true);
+    }
+
+    /* An unregistered instance gets a fresh registration. */
+    this->writer.unregister_instance(testData[0]);
+    ASSERT_NE(this->writer.register_instance(testData[0]), dds::core::null);
+}
+
+TEST_F(DataWriter, keyhash_cache_capacity)
+{
+    Space::Type1 testData(121,100,200);
+
+    this->SetupCommunication(false);
+
+    /* The cache is disabled unless sized by the application. */
+    ASSERT_EQ(this->writer->keyhash_cache_capacity(), 0u);
+    this->writer->keyhash_cache_capacity(1024);
+    ASSERT_EQ(this->writer->keyhash_cache_capacity(), 1024u);
+    this->writer.write(testData);
+    this->writer->keyhash_cache_capacity(0);
+    ASSERT_EQ(this->writer->keyhash_cache_capacity(), 0u);
+
+    /* Without a cache, everything still works. */
+    ASSERT_NE(this->writer.register_instance(testData), dds::core::null);
+    this->writer.write(testData);
+    this->ReadAndCheckSampleType1(testData,
+                                  dds::sub::status::DataState(dds::sub::status::SampleState::not_read(),
+                                                              dds::sub::status::ViewState::new_view(),
+                                                              dds::sub::status::InstanceState::alive()),
+                                  true);
+}
+
+TEST(KeyHashCache, eviction)
+{
+    org::eclipse::cyclonedds::pub::KeyHashCache cache(2);
+    org::eclipse::cyclonedds::pub::KeyHashCache::entry e;
+    std::vector<unsigned char> keys[4] = { { 1 }, { 2 }, { 3 }, { 4 } };
+
+    memset(&e, 0, sizeof(e));
+    e.keyhash_valid = true;
+    e.handle = 100;
+    cache.insert(keys[0], e);
+    e.handle = DDS_HANDLE_NIL;
+    cache.insert(keys[1], e);
+    cache.insert(keys[2], e);
+    cache.insert(keys[3], e);
+
+    /* Registered instances do not count against the capacity. */
+    ASSERT_EQ(cache.size(), 3u);
+    ASSERT_TRUE(cache.lookup(keys[0], e));
+    ASSERT_TRUE(cache.lookup(dds_instance_handle_t(100), e));
+    bool key_matches = false;
+    ASSERT_TRUE(cache.lookup(dds_instance_handle_t(100), keys[0], e, key_matches));
+    ASSERT_TRUE(key_matches);
+    ASSERT_TRUE(cache.lookup(dds_instance_handle_t(100), keys[1], e, key_matches));
+    ASSERT_FALSE(key_matches);
+    ASSERT_FALSE(cache.lookup(keys[1], e));
+    ASSERT_TRUE(cache.lookup(keys[2], e));
+    ASSERT_TRUE(cache.lookup(keys[3], e));
+
+    /* An unregistered instance becomes the most recently used one. */
+    cache.forget_handle(dds_instance_handle_t(100));
+    ASSERT_FALSE(cache.lookup(dds_instance_handle_t(100), e));
+    ASSERT_TRUE(cache.lookup(keys[0], e));
+    ASSERT_EQ(e.handle, DDS_HANDLE_NIL);
+    ASSERT_FALSE(cache.lookup(keys[2], e));
+    ASSERT_EQ(cache.size(), 2u);
+
+    /* Without capacity, only registered instances are cached. */
+    cache.capacity(0);
+    ASSERT_EQ(cache.size(), 0u);
+    cache.insert(keys[1], e);
+    ASSERT_FALSE(cache.lookup(keys[1], e));
+    e.handle = 200;
+    cache.insert(keys[1], e);
+    ASSERT_TRUE(cache.lookup(dds_instance_handle_t(200), e));
+    ASSERT_EQ(cache.size(), 1u);
+}
+
+TEST(KeyHashCache, deferred_keyhash)
+{
+    org::eclipse::cyclonedds::pub::KeyHashCache cache(2);
+    org::eclipse::cyclonedds::pub::KeyHashCache::entry e;
+    std::vector<unsigned char> keys[2] = { { 1 }, { 2 } };
+
+    /* Registered instances are cached before their keyhash is known. */
+    memset(&e, 0, sizeof(e));
+    e.handle = 100;
+    cache.insert(keys[0], e);
+    e.handle = 200;
+    cache.insert(keys[1], e);
+    ASSERT_TRUE(cache.lookup(dds_instance_handle_t(100), e));
+    ASSERT_FALSE(e.keyhash_valid);
+
+    /* Storing the keyhash leaves the registration alone. */
+    e.keyhash.value[0] = 0x5a;
+    e.hash = 0x1234;
+    e.keyhash_valid = true;
+    e.handle = DDS_HANDLE_NIL;
+    cache.update_keyhash(keys[0], e);
+    ASSERT_TRUE(cache.lookup(dds_instance_handle_t(100), e));
+    ASSERT_TRUE(e.keyhash_valid);
+    ASSERT_EQ(e.keyhash.value[0], 0x5a);
+    ASSERT_EQ(e.hash, 0x1234u);
+    ASSERT_EQ(e.handle, dds_instance_handle_t(100));
+
+    /* On unregistration, only a calculated keyhash is worth keeping. */
+    cache.forget_handle(dds_instance_handle_t(100));
+    cache.forget_handle(dds_instance_handle_t(200));
+    ASSERT_TRUE(cache.lookup(keys[0], e));
+    ASSERT_FALSE(cache.lookup(keys[1], e));
+    ASSERT_EQ(cache.size(), 1u);
+}
+
 TEST_F(DataWriter, unregister_instance)
 {
     Space::Type1 testData(201,100,200);
@@ -956,6 +1222,35 @@ TEST_F(DataWriter, key_value_sample)
     ASSERT_EQ(key.long_1(), testData.long_1());
 }
 
+TEST_F(DataWriter, wait_for_acknowledgments)
+{
+    Space::Type1 testData(1,2,3);
+
+    /* The default reader and writer QoS are reliable. */
+    this->SetupCommunication(false);
+    this->writer.write(testData);
+    ASSERT_NO_THROW({
+        this->writer.wait_for_acknowledgments(dds::core::Duration::from_secs(10));
+    });
+
+    this->writer.write(testData);
+    std::promise<bool> acked;
+    this->writer->wait_for_acknowledgments_async(dds::core::Duration::from_secs(10),
+        [&acked](bool result) { acked.set_value(result); });
+    ASSERT_TRUE(acked.get_future().get());
+}
+
+TEST_F(DataWriter, assert_liveliness)
+{
+    this->CreateWriter(false);
+    ASSERT_NO_THROW({
+        this->writer.assert_liveliness();
+    });
+    ASSERT_NO_THROW({
+        this->participant.assert_liveliness();
+    });
+}
+
 TEST_F(DataWriter, topic)
 {
     this->CreateWriter(false);
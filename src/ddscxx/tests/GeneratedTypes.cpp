@@ -0,0 +1,100 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+#include <type_traits>
+#include <gtest/gtest.h>
+#include "dds/dds.hpp"
+#include "Serialization.hpp"
+
+static_assert(std::is_nothrow_move_constructible<UnBounded::Msg>::value,
+              "generated structs must be nothrow move constructible");
+static_assert(std::is_nothrow_move_assignable<UnBounded::Msg>::value,
+              "generated structs must be nothrow move assignable");
+static_assert(std::is_nothrow_move_constructible<Endianness::U>::value,
+              "generated unions must be nothrow move constructible");
+static_assert(std::is_nothrow_move_assignable<Endianness::U>::value,
+              "generated unions must be nothrow move assignable");
+
+/* Large enough to rule out any small buffer optimization. */
+#define LARGE_MEMBER_SIZE 100000
+
+TEST(GeneratedTypes, move_setters)
+{
+    std::string str(LARGE_MEMBER_SIZE, 'x');
+    std::vector<int32_t> seq(LARGE_MEMBER_SIZE, 1);
+    const char *str_data = str.data();
+    const int32_t *seq_data = seq.data();
+
+    UnBounded::Msg msg;
+    msg.unbounded_string(std::move(str));
+    msg.unbounded_sequence_long(std::move(seq));
+    ASSERT_EQ(msg.unbounded_string().data(), str_data);
+    ASSERT_EQ(msg.unbounded_sequence_long().data(), seq_data);
+
+    UnBounded::Msg moved(std::move(msg));
+    ASSERT_EQ(moved.unbounded_string().data(), str_data);
+    ASSERT_EQ(moved.unbounded_sequence_long().data(), seq_data);
+
+    UnBounded::Msg assigned;
+    assigned = std::move(moved);
+    ASSERT_EQ(assigned.unbounded_string().data(), str_data);
+    ASSERT_EQ(assigned.unbounded_sequence_long().data(), seq_data);
+}
+
+TEST(GeneratedTypes, move_constructor_parameters)
+{
+    std::string str(LARGE_MEMBER_SIZE, 'x');
+    std::vector<int32_t> seq(LARGE_MEMBER_SIZE, 1);
+    const char *str_data = str.data();
+    const int32_t *seq_data = seq.data();
+
+    UnBounded::Msg msg(std::move(str), std::move(seq), std::vector<bool>());
+    ASSERT_EQ(msg.unbounded_string().data(), str_data);
+    ASSERT_EQ(msg.unbounded_sequence_long().data(), seq_data);
+}
+
+TEST(GeneratedTypes, swap)
+{
+    std::vector<int32_t> seq(LARGE_MEMBER_SIZE, 1);
+    const int32_t *seq_data = seq.data();
+
+    UnBounded::Msg a, b;
+    a.unbounded_sequence_long(std::move(seq));
+    b.unbounded_string("b");
+
+    swap(a, b);
+    ASSERT_EQ(b.unbounded_sequence_long().data(), seq_data);
+    ASSERT_TRUE(a.unbounded_sequence_long().empty());
+    ASSERT_EQ(a.unbounded_string(), "b");
+    ASSERT_TRUE(b.unbounded_string().empty());
+}
+
+TEST(GeneratedTypes, union_move_setters)
+{
+    std::string str(LARGE_MEMBER_SIZE, 'x');
+    const char *str_data = str.data();
+
+    Endianness::U u;
+    u.str(std::move(str), 4);
+    ASSERT_EQ(u._d(), 4);
+    ASSERT_EQ(u.str().data(), str_data);
+
+    Endianness::UnionStr s;
+    s.u(std::move(u));
+    ASSERT_EQ(s.u().str().data(), str_data);
+
+    Endianness::U other;
+    other.d(1.0);
+    swap(other, s.u());
+    ASSERT_EQ(other._d(), 4);
+    ASSERT_EQ(other.str().data(), str_data);
+    ASSERT_EQ(s.u().d(), 1.0);
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+
+/*
+ * Measures the cost of writing many instances with different keyhash cache
+ * capacities, and of registering instances and writing them by their handle.
+ *
+ *   ddscxx_keyhash_benchmark [instances [rounds]]
+ *
+ * Every round writes all instances once, in the same order, which is the
+ * worst case for a cache that is smaller than the number of instances.
+ */
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "dds/dds.hpp"
+#include "Space.hpp"
+#include "Serialization.hpp"
+
+typedef std::chrono::steady_clock clock_type;
+
+static void report(const std::string& type, const std::string& what, size_t count,
+                   clock_type::duration elapsed, const std::string& unit = "write")
+{
+    double ns = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    std::cout << type << " " << what << ": " << ns / static_cast<double>(count) << " ns/" << unit << std::endl;
+}
+
+template <typename T>
+static void run(const dds::domain::DomainParticipant& participant,
+                const std::string& type, const std::vector<T>& samples, unsigned rounds)
+{
+    dds::topic::Topic<T> topic(participant, "keyhash_benchmark_" + type);
+    dds::pub::Publisher publisher(participant);
+    size_t writes = samples.size() * rounds;
+
+    const size_t capacities[] = { 0, 4096, samples.size() };
+    for (size_t capacity : capacities) {
+        dds::pub::DataWriter<T> writer(publisher, topic);
+        writer->keyhash_cache_capacity(capacity);
+
+        clock_type::time_point start = clock_type::now();
+        for (unsigned r = 0; r < rounds; r++) {
+            for (const T& sample : samples) {
+                writer.write(sample);
+            }
+        }
+        report(type, "capacity " + std::to_string(capacity), writes, clock_type::now() - start);
+    }
+
+    /* Registered instances are found by their handle, whatever the capacity. */
+    dds::pub::DataWriter<T> writer(publisher, topic);
+    std::vector<dds::core::InstanceHandle> handles;
+    handles.reserve(samples.size());
+    clock_type::time_point start = clock_type::now();
+    for (const T& sample : samples) {
+        handles.push_back(writer.register_instance(sample));
+    }
+    report(type, "registration", samples.size(), clock_type::now() - start, "registration");
+
+    start = clock_type::now();
+    for (unsigned r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < samples.size(); i++) {
+            writer.write(samples[i], handles[i]);
+        }
+    }
+    report(type, "registered", writes, clock_type::now() - start);
+}
+
+int main(int argc, char *argv[])
+{
+    size_t instances = (argc > 1) ? std::strtoul(argv[1], NULL, 10) : 500000;
+    unsigned rounds = (argc > 2) ? static_cast<unsigned>(std::strtoul(argv[2], NULL, 10)) : 4;
+
+    try {
+        dds::domain::DomainParticipant participant(org::eclipse::cyclonedds::domain::default_id());
+
+        /* A key that fits in a keyhash as is. */
+        std::vector<Space::Type1> simple;
+        simple.reserve(instances);
+        for (size_t i = 0; i < instances; i++) {
+            simple.push_back(Space::Type1(static_cast<int32_t>(i), 0, 0));
+        }
+        run(participant, "Space::Type1", simple, rounds);
+
+        /* A key that is too large for that, so that it is MD5 hashed. */
+        std::vector<Sizes::ComplexKey> complex;
+        complex.reserve(instances);
+        for (size_t i = 0; i < instances; i++) {
+            complex.push_back(Sizes::ComplexKey({ static_cast<int64_t>(i), 0 }, "key"));
+        }
+        run(participant, "Sizes::ComplexKey", complex, rounds);
+    } catch (const dds::core::Exception& e) {
+        std::cerr << "Exception: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -9,8 +9,11 @@
  *
  * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
  */
+#include <atomic>
 #include <chrono>
+#include <mutex>
 #include <thread>
+#include <vector>
 #include <gtest/gtest.h>
 
 #include "dds/dds.hpp"
@@ -1472,3 +1475,212 @@ TEST_F(Listener, DISABLED_propagation)
     ASSERT_EQ(publisherListener.publication_matched_writer.delegate(), writer.delegate());
     ASSERT_EQ(participantListener.data_on_readers_subscriber.delegate(), subscriber.delegate());
 }
+
+/*
+ * LISTENER EXECUTOR
+ */
+
+class SlowDataReaderListener : public virtual dds::sub::NoOpDataReaderListener<HelloWorldData::Msg>
+{
+public:
+    std::thread::id thread;
+    uint32_t invocations;
+    uint32_t samples;
+
+    SlowDataReaderListener() : invocations(0), samples(0) { }
+
+protected:
+    virtual void on_data_available(dds::sub::DataReader<HelloWorldData::Msg>& reader)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        dds::sub::LoanedSamples<HelloWorldData::Msg> taken = reader.take();
+
+        ddsrt_mutex_lock(&g_mutex);
+        cb_called |= DDS_DATA_AVAILABLE_STATUS;
+        this->thread = std::this_thread::get_id();
+        this->invocations++;
+        this->samples += taken.length();
+        ddsrt_cond_broadcast(&g_cond);
+        ddsrt_mutex_unlock(&g_mutex);
+    }
+};
+
+/*
+ * A reader inherits the executor of its subscriber, which invokes the listener
+ * on one of its own threads and coalesces the data available notifications
+ * that arrive while the listener is busy.
+ */
+TEST_F(Listener, data_available_executor)
+{
+    org::eclipse::cyclonedds::core::ListenerExecutor::ref_type executor =
+        std::make_shared<org::eclipse::cyclonedds::core::ListenerExecutor>(2);
+    SlowDataReaderListener readerListener;
+    dds::core::status::StatusMask mask =
+        dds::core::status::StatusMask() <<
+        dds::core::status::StatusMask::data_available();
+    const uint32_t n_samples = 10;
+
+    subscriber.delegate()->listener_executor(executor);
+
+    // Create reader with listener
+    dds::sub::DataReader<HelloWorldData::Msg> reader(
+        subscriber, topic, dds::sub::qos::DataReaderQos(), &readerListener, mask);
+    ASSERT_NE(reader, dds::core::null);
+    ASSERT_EQ(reader.delegate()->listener_executor(), executor);
+
+    // Create writer
+    dds::pub::DataWriter<HelloWorldData::Msg> writer(
+        publisher, topic);
+    ASSERT_NE(writer, dds::core::null);
+
+    // Write samples of different instances
+    for (uint32_t i = 0; i < n_samples; i++) {
+        HelloWorldData::Msg sample(static_cast<int32_t>(i), "test");
+        writer << sample;
+    }
+
+    // All samples should be taken by the listener, in fewer invocations
+    ddsrt_mutex_lock(&g_mutex);
+    bool signalled = true;
+    while (readerListener.samples < n_samples && signalled) {
+        signalled = ddsrt_cond_waitfor(&g_cond, &g_mutex, 5 * DDS_NSECS_IN_SEC);
+    }
+    uint32_t samples = readerListener.samples;
+    uint32_t invocations = readerListener.invocations;
+    std::thread::id thread = readerListener.thread;
+    ddsrt_mutex_unlock(&g_mutex);
+
+    ASSERT_EQ(samples, n_samples);
+    ASSERT_LT(invocations, n_samples);
+    ASSERT_NE(thread, std::this_thread::get_id());
+
+    reader.close();
+}
+
+TEST(ListenerExecutor, strand_order)
+{
+    org::eclipse::cyclonedds::core::ListenerExecutor executor(4);
+    org::eclipse::cyclonedds::core::ListenerExecutor::strand_ref strand = executor.create_strand();
+    std::vector<int> order;
+
+    for (int i = 0; i < 100; i++) {
+        ASSERT_EQ(executor.submit(strand, [&order, i](bool run) {
+            if (run) {
+                order.push_back(i);
+            }
+        }), org::eclipse::cyclonedds::core::ListenerExecutor::queued);
+    }
+    executor.drain(strand);
+
+    ASSERT_EQ(order.size(), 100u);
+    for (int i = 0; i < 100; i++) {
+        ASSERT_EQ(order[static_cast<size_t>(i)], i);
+    }
+}
+
+TEST(ListenerExecutor, coalesce)
+{
+    org::eclipse::cyclonedds::core::ListenerExecutor executor(1);
+    org::eclipse::cyclonedds::core::ListenerExecutor::strand_ref strand = executor.create_strand();
+    std::atomic<bool> release(false);
+    std::atomic<int> runs(0);
+    int accepted = 0;
+
+    // Keep the strand busy
+    executor.submit(strand, [&release](bool) {
+        while (!release) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    for (int i = 0; i < 10; i++) {
+        if (executor.submit(strand, [&runs](bool run) { if (run) runs++; }, true) ==
+            org::eclipse::cyclonedds::core::ListenerExecutor::queued) {
+            accepted++;
+        }
+    }
+    ASSERT_EQ(accepted, 1);
+
+    release = true;
+    executor.drain(strand);
+    ASSERT_EQ(runs, 1);
+
+    // Once started, the next one is queued again
+    ASSERT_EQ(executor.submit(strand, [&runs](bool run) { if (run) runs++; }, true),
+              org::eclipse::cyclonedds::core::ListenerExecutor::queued);
+    executor.drain(strand);
+    ASSERT_EQ(runs, 2);
+}
+
+TEST(ListenerExecutor, full)
+{
+    org::eclipse::cyclonedds::core::ListenerExecutor executor(1, 2, false);
+    org::eclipse::cyclonedds::core::ListenerExecutor::strand_ref busy = executor.create_strand();
+    org::eclipse::cyclonedds::core::ListenerExecutor::strand_ref idle = executor.create_strand();
+    std::atomic<bool> release(false);
+    std::mutex mutex;
+    std::vector<int> order;
+    std::thread::id runner;
+
+    executor.submit(busy, [&release](bool) {
+        while (!release) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    for (int i = 0; i < 3; i++) {
+        // Past the capacity, the tasks of a busy strand are queued regardless,
+        // so that they keep their order and never run concurrently
+        ASSERT_EQ(executor.submit(busy, [&mutex, &order, i](bool run) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (run) order.push_back(i);
+        }), org::eclipse::cyclonedds::core::ListenerExecutor::queued);
+    }
+    ASSERT_EQ(executor.overflows(), 2u);
+
+    // The task of an idle strand is run by the submitter instead
+    ASSERT_EQ(executor.submit(idle, [&runner](bool run) {
+        if (run) runner = std::this_thread::get_id();
+    }), org::eclipse::cyclonedds::core::ListenerExecutor::full);
+    ASSERT_EQ(runner, std::this_thread::get_id());
+    ASSERT_EQ(executor.overflows(), 3u);
+
+    release = true;
+    executor.drain(busy);
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(order, std::vector<int>({0, 1, 2}));
+}
+
+TEST(ListenerExecutor, cancel)
+{
+    org::eclipse::cyclonedds::core::ListenerExecutor executor(1);
+    org::eclipse::cyclonedds::core::ListenerExecutor::strand_ref strand = executor.create_strand();
+    std::atomic<bool> release(false);
+    std::atomic<int> runs(0);
+    std::atomic<int> cancelled(0);
+
+    executor.submit(strand, [&release](bool) {
+        while (!release) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    for (int i = 0; i < 5; i++) {
+        executor.submit(strand, [&runs, &cancelled](bool run) {
+            if (run) {
+                runs++;
+            } else {
+                cancelled++;
+            }
+        });
+    }
+
+    // Cancelling waits for the running task
+    std::thread releaser([&release] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        release = true;
+    });
+    executor.cancel(strand);
+    releaser.join();
+
+    ASSERT_EQ(runs, 0);
+    ASSERT_EQ(cancelled, 5);
+}
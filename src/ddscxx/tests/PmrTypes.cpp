@@ -0,0 +1,63 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+#include <memory_resource>
+#include <type_traits>
+#include <gtest/gtest.h>
+#include "dds/dds.hpp"
+#include "Pmr.hpp"
+
+static_assert(std::uses_allocator<Pmr::Msg, Pmr::Msg::allocator_type>::value,
+              "types generated with -f pmr must be allocator aware");
+static_assert(!std::is_nothrow_move_assignable<Pmr::Msg>::value,
+              "moving std::pmr members may copy, so it must not be noexcept");
+
+TEST(PmrTypes, allocator_propagation)
+{
+    std::pmr::monotonic_buffer_resource arena;
+    Pmr::Msg msg{Pmr::Msg::allocator_type(&arena)};
+
+    msg.inners().resize(2);
+    msg.inners()[1].name("a name that does not fit in the small string buffer");
+    ASSERT_EQ(msg.text().get_allocator().resource(), &arena);
+    ASSERT_EQ(msg.inners().get_allocator().resource(), &arena);
+    ASSERT_EQ(msg.inners()[1].name().get_allocator().resource(), &arena);
+    ASSERT_EQ(msg.inners()[1].values().get_allocator().resource(), &arena);
+
+    /* Allocator-extended copy. */
+    std::pmr::monotonic_buffer_resource other;
+    Pmr::Msg copy(msg, Pmr::Msg::allocator_type(&other));
+    ASSERT_EQ(copy, msg);
+    ASSERT_EQ(copy.inners()[1].name().get_allocator().resource(), &other);
+}
+
+TEST(PmrTypes, received_samples_use_an_arena)
+{
+    dds::domain::DomainParticipant participant(org::eclipse::cyclonedds::domain::default_id());
+    dds::topic::Topic<Pmr::Msg> topic(participant, "pmr_types_topic");
+    dds::pub::DataWriter<Pmr::Msg> writer(dds::pub::Publisher(participant), topic);
+    dds::sub::DataReader<Pmr::Msg> reader(dds::sub::Subscriber(participant), topic);
+
+    Pmr::Msg msg;
+    msg.id(1);
+    msg.text("a text that does not fit in the small string buffer");
+    msg.inners().resize(3);
+    msg.inners()[2].values().assign(100, 42);
+    writer.write(msg);
+
+    dds::sub::LoanedSamples<Pmr::Msg> samples = reader.take();
+    ASSERT_EQ(samples.length(), 1u);
+    const Pmr::Msg& data = samples.begin()->data();
+    ASSERT_EQ(data, msg);
+    ASSERT_NE(data.text().get_allocator().resource(), std::pmr::get_default_resource());
+    ASSERT_EQ(data.inners()[2].values().get_allocator().resource(),
+              data.text().get_allocator().resource());
+}
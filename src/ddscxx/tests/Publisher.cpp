@@ -11,6 +11,9 @@
  */
 #include "dds/dds.hpp"
 #include <gtest/gtest.h>
+#include <chrono>
+#include <future>
+#include <thread>
 #include "HelloWorldData.hpp"
 #include "Space.hpp"
 
@@ -111,10 +114,119 @@ TEST_F(Publisher, wait_for_acknowledgments)
 {
     this->CreatePublisher();
 
-    /* TODO: Implement. */
-    ASSERT_THROW({
+    /* Without writers, there is nothing to wait for. */
+    ASSERT_NO_THROW({
+        this->publisher.wait_for_acknowledgments(dds::core::Duration::from_secs(2));
+    });
+
+    /* Neither is there for a writer without readers. */
+    dds::topic::Topic<Space::Type1> topic(this->participant, "Publisher_wait_for_acknowledgments");
+    dds::pub::DataWriter<Space::Type1> writer(this->publisher, topic);
+    writer.write(Space::Type1(1, 2, 3));
+    ASSERT_NO_THROW({
         this->publisher.wait_for_acknowledgments(dds::core::Duration::from_secs(2));
-    }, dds::core::UnsupportedError);
+    });
+
+    std::promise<bool> acked;
+    this->publisher->wait_for_acknowledgments_async(dds::core::Duration::from_secs(2),
+        [&acked](bool result) { acked.set_value(result); });
+    ASSERT_TRUE(acked.get_future().get());
+}
+
+TEST_F(Publisher, suspend_publications)
+{
+    this->CreatePublisher();
+
+    dds::topic::Topic<Space::Type1> topic(this->participant, "Publisher_suspend_publications");
+    dds::sub::Subscriber subscriber(this->participant);
+    dds::sub::qos::DataReaderQos rqos = subscriber.default_datareader_qos();
+    rqos << dds::core::policy::Reliability::Reliable()
+         << dds::core::policy::History::KeepAll();
+    dds::sub::DataReader<Space::Type1> reader(subscriber, topic, rqos);
+    dds::pub::qos::DataWriterQos wqos = this->publisher.default_datawriter_qos();
+    wqos << dds::core::policy::Reliability::Reliable()
+         << dds::core::policy::History::KeepAll();
+    dds::pub::DataWriter<Space::Type1> writer(this->publisher, topic, wqos);
+    for (int n = 0; n < 500 && writer.publication_matched_status().current_count() == 0; n++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    {
+        dds::pub::SuspendedPublication outer(this->publisher);
+        for (int32_t i = 0; i < 10; i++) {
+            writer << Space::Type1(1, i, i);
+        }
+        writer.dispose_instance(Space::Type1(1, 0, 0));
+
+        /* Only the outermost suspension sends. */
+        dds::pub::SuspendedPublication inner(this->publisher);
+        inner.resume();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        ASSERT_EQ(reader.read().length(), 0u);
+    }
+
+    /* Then everything arrives, in the order in which it was written. */
+    std::vector<int32_t> received;
+    dds::sub::status::InstanceState state;
+    for (int n = 0; n < 500 && (received.size() < 10 ||
+                                state != dds::sub::status::InstanceState::not_alive_disposed()); n++) {
+        dds::sub::LoanedSamples<Space::Type1> samples = reader.take();
+        for (dds::sub::LoanedSamples<Space::Type1>::const_iterator it = samples.begin(); it != samples.end(); ++it) {
+            if (it->info().valid()) {
+                received.push_back(it->data().long_2());
+            }
+            state = it->info().state().instance_state();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(received.size(), 10u);
+    for (int32_t i = 0; i < 10; i++) {
+        ASSERT_EQ(received[static_cast<size_t>(i)], i);
+    }
+    ASSERT_EQ(state, dds::sub::status::InstanceState::not_alive_disposed());
+}
+
+TEST_F(Publisher, suspended_capacity)
+{
+    this->CreatePublisher();
+
+    dds::topic::Topic<Space::Type1> topic(this->participant, "Publisher_suspended_capacity");
+    dds::pub::DataWriter<Space::Type1> writer(this->publisher, topic);
+
+    ASSERT_THROW({
+        this->publisher->suspended_capacity(0);
+    }, dds::core::InvalidArgumentError);
+    this->publisher->suspended_capacity(2);
+    ASSERT_EQ(this->publisher->suspended_capacity(), 2u);
+
+    dds::pub::SuspendedPublication suspended(this->publisher);
+    writer << Space::Type1(1, 0, 0);
+    writer << Space::Type1(2, 0, 0);
+    ASSERT_THROW({
+        writer << Space::Type1(3, 0, 0);
+    }, dds::core::OutOfResourcesError);
+    ASSERT_THROW({
+        writer.dispose_instance(Space::Type1(1, 0, 0));
+    }, dds::core::OutOfResourcesError);
+
+    /* Resuming empties the backlog. */
+    suspended.resume();
+    ASSERT_NO_THROW(writer << Space::Type1(3, 0, 0));
+}
+
+TEST_F(Publisher, resume_publications)
+{
+    this->CreatePublisher();
+
+    dds::pub::SuspendedPublication suspended(this->publisher);
+    suspended.resume();
+    ASSERT_NO_THROW(suspended.resume());
+
+    /* Not preceded by a suspend. */
+    ASSERT_THROW({
+        this->publisher->resume_publications();
+    }, dds::core::PreconditionNotMetError);
 }
 
 TEST_F(Publisher, participant)
@@ -572,3 +572,47 @@ TEST(Qos, policy_name)
     ASSERT_EQ(dds::core::policy::policy_name<DurabilityService>::name(),   "DurabilityService");
 #endif  // OMG_DDS_PERSISTENCE_SUPPORT
 }
+
+TEST(Qos, ddsc_qos_cache)
+{
+    DataReaderQos drQos;
+    drQos << nonDefaultReliability;
+
+    /* The translation is made once and shared by copies of the QoS. */
+    org::eclipse::cyclonedds::core::DdscQosCache::qos_ref first = drQos->cached_ddsc_qos();
+    ASSERT_TRUE(first);
+    ASSERT_EQ(drQos->cached_ddsc_qos(), first);
+    DataReaderQos drQosCopy = drQos;
+    ASSERT_EQ(drQosCopy->cached_ddsc_qos(), first);
+
+    /* The cached translation equals a fresh one. */
+    dds_qos_t *fresh = drQos->ddsc_qos();
+    ASSERT_TRUE(dds_qos_equal(fresh, first.get()));
+    dds_delete_qos(fresh);
+
+    /* Modifying a copy only invalidates the cache of that copy. */
+    drQosCopy << nonDefaultHistory;
+    org::eclipse::cyclonedds::core::DdscQosCache::qos_ref second = drQosCopy->cached_ddsc_qos();
+    ASSERT_NE(second, first);
+    ASSERT_FALSE(dds_qos_equal(second.get(), first.get()));
+    ASSERT_EQ(drQos->cached_ddsc_qos(), first);
+
+    /* Also when modified through the policy accessor, even when the
+     * reference is used after the QoS was translated. */
+    Reliability& reliability = drQos.policy<Reliability>();
+    ASSERT_NE(drQos->cached_ddsc_qos(), first);
+    reliability.kind(dds::core::policy::ReliabilityKind::BEST_EFFORT);
+    fresh = drQos->ddsc_qos();
+    ASSERT_TRUE(dds_qos_equal(fresh, drQos->cached_ddsc_qos().get()));
+    dds_delete_qos(fresh);
+    reliability.kind(dds::core::policy::ReliabilityKind::RELIABLE);
+    fresh = drQos->ddsc_qos();
+    ASSERT_TRUE(dds_qos_equal(fresh, drQos->cached_ddsc_qos().get()));
+    dds_delete_qos(fresh);
+
+    /* Copies of it can share a translation again. */
+    DataReaderQos drQosCopy2 = drQos;
+    ASSERT_EQ(drQosCopy2->cached_ddsc_qos(), drQosCopy2->cached_ddsc_qos());
+    reliability.kind(dds::core::policy::ReliabilityKind::BEST_EFFORT);
+    ASSERT_EQ(drQosCopy2.policy<Reliability>().kind(), dds::core::policy::ReliabilityKind::RELIABLE);
+}
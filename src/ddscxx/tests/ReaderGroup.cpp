@@ -0,0 +1,111 @@
+/*
+ * Copyright(c) 2021 ADLINK Technology Limited and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+#include <gtest/gtest.h>
+
+#include "dds/dds.hpp"
+#include "org/eclipse/cyclonedds/sub/ReaderGroup.hpp"
+
+#include "Util.hpp"
+#include "Space.hpp"
+#include "HelloWorldData.hpp"
+
+using org::eclipse::cyclonedds::sub::ReaderGroup;
+
+class ReaderGroupTest : public ::testing::Test
+{
+public:
+    dds::domain::DomainParticipant participant;
+    dds::sub::Subscriber subscriber;
+    dds::pub::Publisher publisher;
+
+    ReaderGroupTest() :
+        participant(dds::core::null),
+        subscriber(dds::core::null),
+        publisher(dds::core::null)
+    {
+    }
+
+    void SetUp()
+    {
+        this->participant = dds::domain::DomainParticipant(org::eclipse::cyclonedds::domain::default_id());
+        this->subscriber = dds::sub::Subscriber(this->participant);
+        this->publisher = dds::pub::Publisher(this->participant);
+    }
+
+    void TearDown()
+    {
+        this->publisher = dds::core::null;
+        this->subscriber = dds::core::null;
+        this->participant = dds::core::null;
+    }
+
+    template <typename T>
+    dds::topic::Topic<T> CreateTopic(const char *prefix)
+    {
+        char name[64];
+        create_unique_topic_name(prefix, name, sizeof(name));
+        return dds::topic::Topic<T>(this->participant, name);
+    }
+};
+
+TEST_F(ReaderGroupTest, take)
+{
+    dds::topic::Topic<Space::Type1> t1 = this->CreateTopic<Space::Type1>("ddscxx_reader_group_1");
+    dds::topic::Topic<HelloWorldData::Msg> t2 = this->CreateTopic<HelloWorldData::Msg>("ddscxx_reader_group_2");
+    dds::topic::Topic<Space::Type1> t3 = this->CreateTopic<Space::Type1>("ddscxx_reader_group_3");
+
+    dds::sub::DataReader<Space::Type1> r1(this->subscriber, t1);
+    dds::sub::DataReader<HelloWorldData::Msg> r2(this->subscriber, t2);
+    dds::sub::DataReader<Space::Type1> r3(this->subscriber, t3);
+    dds::pub::DataWriter<Space::Type1> w1(this->publisher, t1);
+    dds::pub::DataWriter<HelloWorldData::Msg> w2(this->publisher, t2);
+
+    ReaderGroup group;
+    ReaderGroup::tag_type tag1 = group.add(r1);
+    ReaderGroup::tag_type tag2 = group.add(r2, 2);
+    (void) group.add(r3);
+    ASSERT_EQ(group.size(), 3u);
+
+    ReaderGroup::result_type result;
+    ASSERT_EQ(group.take(result), 0u);
+    ASSERT_TRUE(result.empty());
+
+    w1 << Space::Type1(1, 2, 3);
+    for (int32_t i = 0; i < 3; i++) {
+        w2 << HelloWorldData::Msg(i, "reader group");
+    }
+
+    /* The pool of the second reader only holds two samples. */
+    ASSERT_EQ(group.take(result), 2u);
+    for (ReaderGroup::result_type::const_iterator it = result.begin(); it != result.end(); ++it) {
+        if (it->reader == tag1) {
+            ASSERT_EQ(it->length, 1u);
+            ASSERT_EQ(group.samples<Space::Type1>(tag1)[0].data(), Space::Type1(1, 2, 3));
+        } else {
+            ASSERT_EQ(it->reader, tag2);
+            ASSERT_EQ(it->length, 2u);
+            ASSERT_EQ(group.samples<HelloWorldData::Msg>(tag2)[1].data().userID(), 1);
+        }
+    }
+
+    /* The rest follows with the next take. */
+    ASSERT_EQ(group.take(result), 1u);
+    ASSERT_EQ(result[0].reader, tag2);
+    ASSERT_EQ(result[0].length, 1u);
+    ASSERT_EQ(group.samples<HelloWorldData::Msg>(tag2)[0].data().userID(), 2);
+
+    ASSERT_EQ(group.take(result), 0u);
+
+    /* Samples are only handed out with their own type. */
+    ASSERT_THROW(group.samples<Space::Type1>(tag2), dds::core::InvalidArgumentError);
+    ASSERT_THROW(group.samples<Space::Type1>(group.size()), dds::core::InvalidArgumentError);
+}
@@ -13,6 +13,7 @@
 
 #include "dds/dds.hpp"
 #include "Serialization.hpp"
+#include "OutOfLine.hpp"
 #include <org/eclipse/cyclonedds/topic/datatopic.hpp>
 
 using namespace org::eclipse::cyclonedds::core::cdr;
@@ -76,22 +77,25 @@ private:
 
     template<typename T>
     void validate_impl(const T &msg, const std::vector<uint8_t> &exp, bool swap) {
-        basic_cdr_stream str;
+        if (swap) {
+          swapped_basic_cdr_stream str;
+          validate_stream(str, msg, exp);
+        } else {
+          basic_cdr_stream str;
+          validate_stream(str, msg, exp);
+        }
+    }
 
-        if (swap)
-          move_swapped(str, msg);
-        else
-          move(str, msg);
+    template<typename S, typename T>
+    void validate_stream(S &str, const T &msg, const std::vector<uint8_t> &exp) {
+        move(str, msg);
 
         size_t sz = str.position();
         ASSERT_EQ(sz, exp.size());
         std::vector<uint8_t> buffer(sz, 0x0);
         str.set_buffer(buffer.data());
 
-        if (swap)
-          write_swapped(str, msg);
-        else
-          write(str, msg);
+        write(str, msg);
 
         ASSERT_EQ(buffer, exp);
     }
@@ -107,14 +111,17 @@ TEST_F(Serdata, alignment)
 {
     Endianness::Msg msg({16,25,36},65535);
 
-    basic_cdr_stream str;
     std::vector<unsigned char> vec(8,0x0);
-    str.set_buffer(vec.data());
 
-    if (native_endianness() == endianness::little_endian)
+    if (native_endianness() == endianness::little_endian) {
+      basic_cdr_stream str;
+      str.set_buffer(vec.data());
       write(str,msg);
-    else
-      write_swapped(str,msg);
+    } else {
+      swapped_basic_cdr_stream str;
+      str.set_buffer(vec.data());
+      write(str,msg);
+    }
 
     ASSERT_EQ(vec, std::vector<unsigned char>({16,25,36,0,255,255,0,0}));
 }
@@ -246,3 +253,231 @@ TEST_F(Serdata, serialization_unions)
 
     validate(Ustr, le, be);
 }
+
+template<typename T>
+static void check_size_traits()
+{
+    using traits = org::eclipse::cyclonedds::topic::TopicTraits<T>;
+    T msg;
+    basic_cdr_stream str;
+
+    max(str, msg);
+    ASSERT_EQ(traits::getMaxSerializedSize(), str.position());
+    if (traits::isFixedSize()) {
+        str.reset_position();
+        move(str, msg);
+        ASSERT_EQ(traits::getMaxSerializedSize(), str.position());
+    }
+
+    str.reset_position();
+    key_max(str, msg);
+    ASSERT_EQ(traits::getKeyMaxSize(), str.position());
+    ASSERT_EQ(traits::isKeySimple(), str.position() <= 16);
+}
+
+/*
+ * Checking that the size traits generated by idlcxx match the sizes calculated at runtime.
+ */
+TEST_F(Serdata, size_traits)
+{
+    using org::eclipse::cyclonedds::topic::TopicTraits;
+
+    static_assert(TopicTraits<Endianness::Msg>::isFixedSize(), "fixed size type");
+    static_assert(TopicTraits<Endianness::Msg>::getMaxSerializedSize() == 8, "chars, padding and unsigned long");
+    static_assert(TopicTraits<Endianness::Enums>::isFixedSize(), "fixed size type");
+    static_assert(TopicTraits<Endianness::Enums>::getMaxSerializedSize() == 20, "five enums");
+    static_assert(!TopicTraits<Bounded::Msg>::isFixedSize(), "bounded members");
+    static_assert(!TopicTraits<UnBounded::Msg>::isFixedSize(), "unbounded members");
+    static_assert(TopicTraits<UnBounded::Msg>::getMaxSerializedSize() == SIZE_MAX, "unbounded members");
+    static_assert(TopicTraits<Sizes::SimpleKey>::getKeyMaxSize() == 5, "long and char");
+    static_assert(TopicTraits<Sizes::SimpleKey>::isKeySimple(), "key fits in the keyhash");
+    static_assert(!TopicTraits<Sizes::ComplexKey>::isKeySimple(), "key is MD5 hashed");
+
+    check_size_traits<Endianness::Msg>();
+    check_size_traits<Endianness::Enums>();
+    check_size_traits<Endianness::UnionStr>();
+    check_size_traits<Bounded::Msg>();
+    check_size_traits<UnBounded::Msg>();
+    check_size_traits<Sizes::SimpleKey>();
+    check_size_traits<Sizes::ComplexKey>();
+}
+
+/*
+ * Checking that a key that fits in the keyhash is copied into it, and a larger one is hashed.
+ */
+TEST_F(Serdata, size_traits_keyhash)
+{
+    big_endian_basic_cdr_stream str;
+    ddsi_keyhash_t hash;
+
+    Sizes::SimpleKey simple(0x01020304, 'a', 1.0, "name");
+    ASSERT_FALSE(to_key(str, simple, hash));
+    /* Keys are serialized in big-endian byte order, whatever the endianness of the node. */
+    const unsigned char big_endian[] = { 0x01, 0x02, 0x03, 0x04, 'a' };
+    ASSERT_EQ(memcmp(hash.value, big_endian, sizeof(big_endian)), 0);
+    std::vector<unsigned char> buffer;
+    key_to_buffer(str, simple, buffer);
+    ASSERT_EQ(buffer.size(), 16u);
+    ASSERT_EQ(memcmp(buffer.data(), hash.value, 16), 0);
+
+    Sizes::ComplexKey complex({1, 2}, "name");
+    ASSERT_TRUE(to_key(str, complex, hash));
+}
+
+/*
+ * Checking that a key serdata can be created from the keyhash of a key that fits in it.
+ */
+TEST_F(Serdata, from_keyhash)
+{
+    using org::eclipse::cyclonedds::topic::TopicTraits;
+    big_endian_basic_cdr_stream str;
+    ddsi_keyhash_t hash;
+
+    ddsi_sertype *st = TopicTraits<Sizes::SimpleKey>::getSerType();
+    Sizes::SimpleKey simple(0x01020304, 'a', 1.0, "name");
+    ASSERT_FALSE(to_key(str, simple, hash));
+
+    auto from_keyhash = static_cast<ddscxx_serdata<Sizes::SimpleKey>*>(
+        serdata_from_keyhash<Sizes::SimpleKey>(st, &hash));
+    ASSERT_NE(from_keyhash, nullptr);
+    auto from_sample = static_cast<ddscxx_serdata<Sizes::SimpleKey>*>(
+        serdata_from_sample<Sizes::SimpleKey>(st, SDK_KEY, &simple));
+    ASSERT_NE(from_sample, nullptr);
+
+    ASSERT_TRUE(serdata_eqkey<Sizes::SimpleKey>(from_keyhash, from_sample));
+    ASSERT_EQ(from_keyhash->hash, from_sample->hash);
+    ASSERT_EQ(from_keyhash->size(), from_sample->size());
+    ASSERT_EQ(memcmp(from_keyhash->data(), from_sample->data(), from_sample->size()), 0);
+    ASSERT_EQ(from_keyhash->getT()->id(), simple.id());
+    ASSERT_EQ(from_keyhash->getT()->c(), simple.c());
+
+    delete from_keyhash;
+    delete from_sample;
+    ddsrt_atomic_st32(&st->flags_refc, 0);
+    ddsi_sertype_fini(st);
+    delete st;
+
+    st = TopicTraits<Sizes::ComplexKey>::getSerType();
+    Sizes::ComplexKey complex({1, 2}, "name");
+    ASSERT_TRUE(to_key(str, complex, hash));
+    ASSERT_EQ(serdata_from_keyhash<Sizes::ComplexKey>(st, &hash), nullptr);
+
+    ddsrt_atomic_st32(&st->flags_refc, 0);
+    ddsi_sertype_fini(st);
+    delete st;
+}
+
+/*
+ * Checking that the key of received data is read without deserializing the other fields.
+ */
+TEST_F(Serdata, key_from_ser)
+{
+    using org::eclipse::cyclonedds::topic::TopicTraits;
+    basic_cdr_stream str;
+
+    Sizes::SimpleKey simple(0x01020304, 'a', 1.0, "name");
+    move(str, simple);
+    std::vector<unsigned char> buffer(4 + str.position(), 0x0);
+    buffer[1] = (native_endianness() == endianness::little_endian ? 0x01 : 0x00);
+    str.set_buffer(buffer.data() + 4);
+    write(str, simple);
+
+    Sizes::SimpleKey key;
+    ASSERT_TRUE(key_from_buffer(buffer.data(), key, SDK_DATA));
+    ASSERT_EQ(key.id(), simple.id());
+    ASSERT_EQ(key.c(), simple.c());
+    ASSERT_EQ(key.name(), "");
+
+    ddsi_sertype *st = TopicTraits<Sizes::SimpleKey>::getSerType();
+    ddsrt_iovec_t iov;
+    iov.iov_base = buffer.data();
+    iov.iov_len = static_cast<ddsrt_iov_len_t>(buffer.size());
+    auto from_ser = static_cast<ddscxx_serdata<Sizes::SimpleKey>*>(
+        serdata_from_ser_iov<Sizes::SimpleKey>(st, SDK_DATA, 1, &iov, buffer.size()));
+    ASSERT_NE(from_ser, nullptr);
+    auto from_sample = static_cast<ddscxx_serdata<Sizes::SimpleKey>*>(
+        serdata_from_sample<Sizes::SimpleKey>(st, SDK_DATA, &simple));
+    ASSERT_NE(from_sample, nullptr);
+
+    ASSERT_TRUE(serdata_eqkey<Sizes::SimpleKey>(from_ser, from_sample));
+    ASSERT_EQ(from_ser->hash, from_sample->hash);
+
+    auto untyped = serdata_to_untyped<Sizes::SimpleKey>(from_ser);
+    ASSERT_NE(untyped, nullptr);
+    ASSERT_EQ(from_ser->cachedT(), nullptr);
+    ASSERT_TRUE(serdata_eqkey<Sizes::SimpleKey>(untyped, from_sample));
+    delete static_cast<ddscxx_serdata<Sizes::SimpleKey>*>(untyped);
+
+    ASSERT_EQ(*from_ser->getT(), simple);
+
+    /* data that is too short to be read is rejected on arrival */
+    iov.iov_len = 2;
+    ASSERT_EQ(serdata_from_ser_iov<Sizes::SimpleKey>(st, SDK_DATA, 1, &iov, 2), nullptr);
+
+    delete from_ser;
+    delete from_sample;
+    ddsrt_atomic_st32(&st->flags_refc, 0);
+    ddsi_sertype_fini(st);
+    delete st;
+}
+
+/*
+ * Checking that sertypes of the same type are equal and hash the same, based on the type hash.
+ */
+TEST_F(Serdata, sertype_hash)
+{
+    using org::eclipse::cyclonedds::topic::TopicTraits;
+
+    ASSERT_EQ(TopicTraits<Sizes::SimpleKey>::getTypeHash().size(), 8u);
+    ASSERT_EQ(TopicTraits<Sizes::SimpleKey>::getTypeHash(), TopicTraits<Sizes::SimpleKey>::getTypeHash());
+    ASSERT_NE(TopicTraits<Sizes::SimpleKey>::getTypeHash(), TopicTraits<Sizes::ComplexKey>::getTypeHash());
+    ASSERT_NE(TopicTraits<Bounded::Msg>::getTypeHash(), TopicTraits<UnBounded::Msg>::getTypeHash());
+
+    ddsi_sertype *st = TopicTraits<Endianness::Msg>::getSerType();
+    ASSERT_TRUE(sertype_equal<Endianness::Msg>(m_st, st));
+    ASSERT_EQ(sertype_hash<Endianness::Msg>(m_st), sertype_hash<Endianness::Msg>(st));
+    ASSERT_EQ(ddsi_sertype_hash(m_st), ddsi_sertype_hash(st));
+    ASSERT_TRUE(ddsi_sertype_equal(m_st, st));
+
+    ddsrt_atomic_st32(&st->flags_refc, 0);
+    ddsi_sertype_fini(st);
+    delete st;
+}
+
+template<typename S, typename T>
+static void round_trip(const T &msg, T &out)
+{
+    S str;
+    move(str, msg);
+    std::vector<unsigned char> buffer(str.position(), 0x0);
+
+    str.reset_position();
+    str.set_buffer(buffer.data());
+    write(str, msg);
+    ASSERT_EQ(str.position(), buffer.size());
+
+    str.reset_position();
+    read(str, out);
+    ASSERT_FALSE(str.abort_status());
+}
+
+/*
+ * Checking that streamers generated with "-f out-of-line-streamers" are instantiated
+ * for both the native and the byte swapped stream.
+ */
+TEST(OutOfLine, streamers)
+{
+    OutOfLine::Choice choice;
+    choice.str("choice");
+    OutOfLine::Msg msg;
+    msg.id(123);
+    msg.values({1, 2, 3});
+    msg.choice(choice);
+    msg.name("name");
+
+    OutOfLine::Msg native, swapped;
+    round_trip<basic_cdr_stream>(msg, native);
+    round_trip<swapped_basic_cdr_stream>(msg, swapped);
+    ASSERT_EQ(native, msg);
+    ASSERT_EQ(swapped, msg);
+}
@@ -230,7 +230,11 @@ TEST_F(Subscriber, use_after_deletion)
 TEST_F(Subscriber, builtin)
 {
     this->CreateSubscriber();
-    ASSERT_THROW({
-        dds::sub::builtin_subscriber(this->participant);
-    }, dds::core::UnsupportedError);
+    dds::sub::Subscriber builtin = dds::sub::builtin_subscriber(this->participant);
+    ASSERT_NE(builtin, dds::core::null);
+    ASSERT_EQ(builtin.participant(), this->participant);
+
+    /* The same builtin subscriber is returned as long as it is alive. */
+    dds::sub::Subscriber again = dds::sub::builtin_subscriber(this->participant);
+    ASSERT_EQ(builtin, again);
 }
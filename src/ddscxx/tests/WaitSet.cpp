@@ -16,6 +16,10 @@
 #include "dds/ddsrt/threads.h"
 #include "dds/ddsrt/sync.h"
 
+#ifndef _WIN32
+#include <poll.h>
+#endif
+
 #include "Util.hpp"
 #include "Space.hpp"
 
@@ -448,6 +452,29 @@ TEST_F(WaitSet, wait_timeout)
     waitSet -= readerStatus;
 }
 
+/**
+ * Test timeouts being returned rather than thrown
+ */
+TEST_F(WaitSet, try_wait)
+{
+    waitSet = dds::core::cond::WaitSet();
+    waitSet += readerStatus;
+
+    dds::core::Duration waitTimeout = dds::core::Duration::from_millisecs(100);
+    dds::core::cond::WaitSet::ConditionSeq conditionList;
+    ASSERT_EQ(waitSet.delegate()->try_wait(conditionList, waitTimeout), DDS_RETCODE_TIMEOUT);
+    ASSERT_EQ(conditionList.size(), 0);
+    ASSERT_EQ(waitSet.delegate()->try_dispatch(waitTimeout), DDS_RETCODE_TIMEOUT);
+
+    writer << Space::Type1(1, 2, 3);
+    ASSERT_EQ(waitSet.delegate()->try_wait(conditionList, dds::core::Duration::from_secs(5)), DDS_RETCODE_OK);
+    ASSERT_EQ(conditionList.size(), 1);
+    ASSERT_EQ(conditionList[0], readerStatus);
+
+    reader.take();
+    waitSet -= readerStatus;
+}
+
 /**
  * Test waiting for StatusCondition
  */
@@ -928,4 +955,95 @@ TEST_F(WaitSet, status_condition_trigger)
 
   EXPECT_EQ(dr.requested_incompatible_qos_status().total_count(), 1);
   EXPECT_EQ(dw.offered_incompatible_qos_status().total_count(), 1);
-}
\ No newline at end of file
+}
+
+#ifndef _WIN32
+static bool fd_readable(int fd, int timeout_ms)
+{
+    struct pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    return poll(&pfd, 1, timeout_ms) == 1;
+}
+
+/**
+ * Test the readiness file descriptor with a StatusCondition
+ */
+TEST_F(WaitSet, notifier_fd_reader_status)
+{
+    dds::core::cond::WaitSet::ConditionSeq triggered;
+
+    waitSet = dds::core::cond::WaitSet();
+    waitSet += readerStatus;
+
+    int fd = waitSet.delegate()->notifier_fd();
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(waitSet.delegate()->notifier_fd(), fd);
+    ASSERT_FALSE(fd_readable(fd, 100));
+
+    // Nothing triggered yet
+    waitSet.delegate()->poll_triggered(triggered);
+    ASSERT_EQ(triggered.size(), 0u);
+
+    // Writing makes the descriptor readable
+    Space::Type1 testData(1, 2, 3);
+    writer << testData;
+    ASSERT_TRUE(fd_readable(fd, 5000));
+
+    waitSet.delegate()->poll_triggered(triggered);
+    ASSERT_EQ(triggered.size(), 1u);
+    ASSERT_EQ(triggered[0], readerStatus);
+    reader.take();
+
+    // Rearming while the data was still there may cause one more wakeup
+    int wakeups = 0;
+    while (fd_readable(fd, 100) && wakeups++ < 3) {
+        waitSet.delegate()->poll_triggered(triggered);
+        ASSERT_EQ(triggered.size(), 0u);
+    }
+    ASSERT_LT(wakeups, 3);
+
+    // And it keeps working
+    writer << testData;
+    ASSERT_TRUE(fd_readable(fd, 5000));
+    waitSet.delegate()->poll_triggered(triggered);
+    ASSERT_EQ(triggered.size(), 1u);
+    reader.take();
+
+    waitSet -= readerStatus;
+}
+
+/**
+ * Test the readiness file descriptor with a GuardCondition that is attached
+ * after the descriptor was created
+ */
+TEST_F(WaitSet, notifier_fd_guard)
+{
+    dds::core::cond::WaitSet::ConditionSeq triggered;
+
+    waitSet = dds::core::cond::WaitSet();
+    int fd = waitSet.delegate()->notifier_fd();
+    ASSERT_GE(fd, 0);
+
+    waitSet += guard;
+    ASSERT_FALSE(fd_readable(fd, 100));
+
+    guard.trigger_value(true);
+    ASSERT_TRUE(fd_readable(fd, 5000));
+    waitSet.delegate()->poll_triggered(triggered);
+    ASSERT_EQ(triggered.size(), 1u);
+    ASSERT_EQ(triggered[0], guard);
+
+    // Still triggered: readable again
+    ASSERT_TRUE(fd_readable(fd, 5000));
+
+    // Detached conditions no longer count
+    waitSet -= guard;
+    waitSet.delegate()->poll_triggered(triggered);
+    ASSERT_EQ(triggered.size(), 0u);
+    ASSERT_FALSE(fd_readable(fd, 100));
+
+    guard.trigger_value(false);
+}
+#endif
@@ -49,20 +49,39 @@ function(IDLCXX_GENERATE)
     list(APPEND _files "${_path}")
   endforeach()
 
+  # out-of-line streamers are defined in a generated source file per IDL file
+  if("out-of-line-streamers" IN_LIST IDLCXX_FEATURES)
+    set(_out_of_line TRUE)
+  endif()
+
   foreach(_file ${_files})
     get_filename_component(_name ${_file} NAME_WE)
     set(_header "${_dir}/${_name}.hpp")
     list(APPEND _headers "${_header}")
+    set(_outputs "${_header}")
+    if(_out_of_line)
+      set(_source "${_dir}/${_name}.cpp")
+      list(APPEND _sources "${_source}")
+      list(APPEND _outputs "${_source}")
+    endif()
     add_custom_command(
-      OUTPUT   "${_header}"
+      OUTPUT   ${_outputs}
       COMMAND  CycloneDDS::idlc
       ARGS     -l $<TARGET_FILE:CycloneDDS-CXX::idlcxx> ${IDLCXX_ARGS} ${_file}
       DEPENDS  ${_files} CycloneDDS::idlc CycloneDDS-CXX::idlcxx)
   endforeach()
 
-  add_custom_target("${_target}_generate" DEPENDS ${_headers})
-  add_library(${_target} INTERFACE)
-  target_sources(${_target} INTERFACE ${_headers})
-  target_include_directories(${_target} INTERFACE "${_dir}")
+  add_custom_target("${_target}_generate" DEPENDS ${_headers} ${_sources})
+  if(_out_of_line)
+    add_library(${_target} STATIC ${_sources} ${_headers})
+    set_target_properties(
+      ${_target} PROPERTIES CXX_STANDARD 17 POSITION_INDEPENDENT_CODE ON)
+    target_link_libraries(${_target} PUBLIC CycloneDDS-CXX::ddscxx)
+    target_include_directories(${_target} PUBLIC "${_dir}")
+  else()
+    add_library(${_target} INTERFACE)
+    target_sources(${_target} INTERFACE ${_headers})
+    target_include_directories(${_target} INTERFACE "${_dir}")
+  endif()
   add_dependencies(${_target} "${_target}_generate")
 endfunction()
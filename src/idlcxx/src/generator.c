@@ -179,6 +179,22 @@ static int get_cpp11_base_type(
   return idl_snprintf(str, size, "%s", type);
 }
 
+/* bounded sequences and strings that map to the containers with inline
+   storage, see the inline-max-elements option. the maximum counts elements
+   (characters for strings), not bytes */
+bool is_inline_bounded(const struct generator *gen, const void *node)
+{
+  uint32_t maximum;
+
+  if (idl_is_sequence(node))
+    maximum = ((const idl_sequence_t *)node)->maximum;
+  else if (idl_is_string(node))
+    maximum = ((const idl_string_t *)node)->maximum;
+  else
+    return false;
+  return maximum != 0 && maximum <= gen->inline_max_elements;
+}
+
 static int get_cpp11_templ_type(
   char *str, size_t size, const void *node, void *user_data)
 {
@@ -193,7 +209,9 @@ static int get_cpp11_templ_type(
       char buf[128], *type = buf;
       const idl_sequence_t *sequence = node;
 
-      if (sequence->maximum)
+      if (is_inline_bounded(gen, sequence))
+        fmt = "dds::core::bounded_sequence<%1$s, %2$" PRIu32 ">";
+      else if (sequence->maximum)
         fmt = gen->bounded_sequence_format;
       else
         fmt = gen->sequence_format;
@@ -211,7 +229,9 @@ static int get_cpp11_templ_type(
     case IDL_STRING: {
       const idl_string_t *string = node;
 
-      if (string->maximum)
+      if (is_inline_bounded(gen, string))
+        fmt = "dds::core::bounded_string<%1$" PRIu32 ">";
+      else if (string->maximum)
         fmt = gen->bounded_string_format;
       else
         fmt = gen->string_format;
@@ -528,6 +548,24 @@ static idl_retcode_t print_guard_endif(FILE *fh, const char *guard)
   return IDL_RETCODE_OK;
 }
 
+static idl_retcode_t print_source_include(const struct generator *gen)
+{
+  static const char fmt[] =
+    "#include \"%s\"\n\n";
+  const char *file = gen->header.path;
+
+  for (const char *ptr = file; *ptr; ptr++) {
+    if (*ptr == '/')
+      file = ptr + 1;
+  }
+
+  if (print_header(gen->source.handle, gen->path, gen->source.path))
+    return IDL_RETCODE_NO_MEMORY;
+  if (idl_fprintf(gen->source.handle, fmt, file) < 0)
+    return IDL_RETCODE_NO_MEMORY;
+  return IDL_RETCODE_OK;
+}
+
 static idl_retcode_t
 register_union(
   const idl_pstate_t *pstate,
@@ -589,13 +627,17 @@ register_types(
     return IDL_VISIT_DONT_RECURSE;
 
   if (idl_is_sequence(type_spec)) {
-    if (idl_is_bounded(type_spec))
+    if (is_inline_bounded(gen, type_spec))
+      gen->uses_inline_sequence = true;
+    else if (idl_is_bounded(type_spec))
       gen->uses_bounded_sequence = true;
     else
       gen->uses_sequence = true;
     return IDL_VISIT_TYPE_SPEC;
   } else if (idl_is_string(type_spec)) {
-    if (idl_is_bounded(type_spec))
+    if (is_inline_bounded(gen, type_spec))
+      gen->uses_inline_string = true;
+    else if (idl_is_bounded(type_spec))
       gen->uses_bounded_string = true;
     else
       gen->uses_string = true;
@@ -652,8 +694,13 @@ generate_includes(const idl_pstate_t *pstate, struct generator *generator)
   }
 
   { int len = 0;
-    const char *incs[7];
+    const char *incs[11];
 
+    /* std::move and std::swap, used by the generated types */
+    incs[len++] = "<utility>";
+    /* std::pmr::polymorphic_allocator, used by allocator-aware types */
+    if (generator->pmr)
+      incs[len++] = "<memory_resource>";
     if (generator->uses_integers)
       incs[len++] = "<cstdint>";
     if (generator->uses_array)
@@ -666,6 +713,10 @@ generate_includes(const idl_pstate_t *pstate, struct generator *generator)
       incs[len++] = generator->string_include;
     if (generator->uses_bounded_string)
       incs[len++] = generator->bounded_string_include;
+    if (generator->uses_inline_sequence)
+      incs[len++] = "\"dds/core/bounded_sequence.hpp\"";
+    if (generator->uses_inline_string)
+      incs[len++] = "\"dds/core/bounded_string.hpp\"";
     if (generator->uses_union)
       incs[len++] = generator->union_include;
 
@@ -700,6 +751,8 @@ idl_retcode_t generate_nosetup(const idl_pstate_t *pstate, struct generator *gen
     goto err_print;
   if ((ret = print_guard_if(gen->header.handle, guard)))
     goto err_print;
+  if (gen->source.handle && (ret = print_source_include(gen)))
+    goto err_print;
   if ((ret = generate_includes(pstate, gen)))
     goto err_print;
   if ((ret = generate_types(pstate, gen)))
@@ -717,19 +770,27 @@ err_print:
   return ret;
 }
 
-const char *seq_tmpl = "std::vector<{TYPE}>";
+static const char def_seq_tmpl[] = "std::vector<{TYPE}>";
+static const char def_bnd_seq_tmpl[] = "std::vector<{TYPE}>";
+static const char def_str_tmpl[] = "std::string";
+static const char def_bnd_str_tmpl[] = "std::string";
+
+const char *seq_tmpl = def_seq_tmpl;
 const char *seq_inc = "<vector>";
 const char *arr_tmpl = "std::array<{TYPE}, {DIMENSION}>";
 const char *arr_inc = "<array>";
-const char *bnd_seq_tmpl = "std::vector<{TYPE}>";
+const char *bnd_seq_tmpl = def_bnd_seq_tmpl;
 const char *bnd_seq_inc = "<vector>";
-const char *str_tmpl = "std::string";
+const char *str_tmpl = def_str_tmpl;
 const char *str_inc = "<string>";
-const char *bnd_str_tmpl = "std::string";
+const char *bnd_str_tmpl = def_bnd_str_tmpl;
 const char *bnd_str_inc = "<string>";
 const char *uni_tmpl = "std::variant";
 const char *uni_get_tmpl = "std::get";
 const char *uni_inc = "<variant>";
+int pmr = 0;
+int out_of_line = 0;
+const char *inline_max_elements = "0";
 
 static const char *arr_toks[] = { "TYPE", "DIMENSION", NULL };
 static const char *arr_flags[] = { "s", PRIu32, NULL };
@@ -749,12 +810,20 @@ idl_retcode_t generate(const idl_pstate_t *pstate)
   char *dir = NULL, *basename = NULL, *empty = "";
   const char *sep, *ext, *file, *path;
   struct generator gen;
+  unsigned long long bound;
+  char *end = NULL;
 
   assert(pstate->paths);
   assert(pstate->paths->name);
   path = pstate->sources->path->name;
   assert(path);
 
+  bound = strtoull(inline_max_elements, &end, 10);
+  if (end == inline_max_elements || *end != '\0' || bound > UINT32_MAX) {
+    fprintf(stderr, "Invalid value for inline-max-elements: %s\n", inline_max_elements);
+    return IDL_RETCODE_BAD_PARAMETER;
+  }
+
   /* use relative directory if user provided a relative path, use current
      word directory otherwise */
   sep = ext = NULL;
@@ -781,6 +850,7 @@ idl_retcode_t generate(const idl_pstate_t *pstate)
 
   memset(&gen, 0, sizeof(gen));
   gen.path = file;
+  gen.inline_max_elements = (uint32_t)bound;
 
   sep = dir[0] == '\0' ? "" : "/";
   if (idl_asprintf(&gen.header.path, "%s%s%s.hpp", dir, sep, basename) < 0)
@@ -788,6 +858,30 @@ idl_retcode_t generate(const idl_pstate_t *pstate)
   if (!(gen.header.handle = idl_fopen(gen.header.path, "wb")))
     goto err_hdr_fh;
 
+  /* streaming functions are defined and instantiated in a separate source
+     file, the header only declares them */
+  gen.out_of_line = out_of_line != 0;
+  if (gen.out_of_line) {
+    if (idl_asprintf(&gen.source.path, "%s%s%s.cpp", dir, sep, basename) < 0)
+      goto err_src;
+    if (!(gen.source.handle = idl_fopen(gen.source.path, "wb")))
+      goto err_src_fh;
+  }
+
+  /* allocator-aware types use the std::pmr containers, unless the user
+     explicitly configured a template of their own */
+  gen.pmr = pmr != 0;
+  if (gen.pmr) {
+    if (seq_tmpl == def_seq_tmpl)
+      seq_tmpl = "std::pmr::vector<{TYPE}>";
+    if (bnd_seq_tmpl == def_bnd_seq_tmpl)
+      bnd_seq_tmpl = "std::pmr::vector<{TYPE}>";
+    if (str_tmpl == def_str_tmpl)
+      str_tmpl = "std::pmr::string";
+    if (bnd_str_tmpl == def_bnd_str_tmpl)
+      bnd_str_tmpl = "std::pmr::string";
+  }
+
   /* generate format strings from templates */
   if (makefmtp(&gen.array_format, arr_tmpl, arr_toks, arr_flags) < 0)
     goto err_arr;
@@ -827,6 +921,12 @@ err_bnd_seq:
 err_seq:
   free(gen.array_format);
 err_arr:
+  if (gen.source.handle)
+    fclose(gen.source.handle);
+err_src_fh:
+  if (gen.source.path)
+    free(gen.source.path);
+err_src:
   fclose(gen.header.handle);
 err_hdr_fh:
   free(gen.header.path);
@@ -915,6 +1015,36 @@ static const idlc_option_t *opts[] = {
     'f', "union-include", "<header>",
     "Header to include if template for union-template is used."
   },
+  &(idlc_option_t) {
+    IDLC_STRING, { .string = &inline_max_elements },
+    'f', "inline-max-elements", "<count>",
+    "Map bounded sequences and strings with a bound of at most <count> "
+    "elements to dds::core::bounded_sequence and dds::core::bounded_string, "
+    "which store their elements inline instead of on the heap. The bound "
+    "counts elements, or characters for strings, not bytes: the inline "
+    "storage of a sequence<T, N> is N * sizeof(T), whether it is used or not. "
+    "Types that only use such containers are self-contained. Takes "
+    "precedence over the bounded-sequence-template and "
+    "bounded-string-template options. (default: 0, i.e. disabled)"
+  },
+  &(idlc_option_t) {
+    IDLC_FLAG, { .flag = &pmr },
+    'f', "pmr", "",
+    "Generate allocator-aware types. Strings and sequences default to "
+    "std::pmr::string and std::pmr::vector, and structs get an allocator_type "
+    "and allocator-extended constructors, so that received samples are "
+    "allocated from a per-sample arena. All IDL files a type depends on must "
+    "be generated with this option too."
+  },
+  &(idlc_option_t) {
+    IDLC_FLAG, { .flag = &out_of_line },
+    'f', "out-of-line-streamers", "",
+    "Define the streaming functions in a separate source file, explicitly "
+    "instantiated for the native and byte swapped CDR streams, and only "
+    "declare them in the header. The generated source file must be compiled "
+    "and linked into the application. All IDL files a type depends on must "
+    "be generated with this option too."
+  },
   NULL
 };
 
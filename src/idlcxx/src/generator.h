@@ -12,6 +12,8 @@
 #ifndef GENERATOR_H
 #define GENERATOR_H
 
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 
 struct generator {
@@ -29,12 +31,17 @@ struct generator {
   char *union_format;
   char *union_getter_format;
   const char *union_include;
+  bool pmr;
+  bool out_of_line;
+  uint32_t inline_max_elements;
   bool uses_integers;
   bool uses_array;
   bool uses_sequence;
   bool uses_bounded_sequence;
   bool uses_string;
   bool uses_bounded_string;
+  bool uses_inline_sequence;
+  bool uses_inline_string;
   bool uses_union;
 #if 0
   bool uses_optional;
@@ -43,10 +50,19 @@ struct generator {
     FILE *handle;
     char *path;
   } header;
+  /* only used for out-of-line streamers */
+  struct {
+    FILE *handle;
+    char *path;
+  } source;
 };
 
 const char *get_cpp11_name(const void *);
 
+bool is_inline_bounded(const struct generator *gen, const void *node);
+
+const idl_declarator_t *resolve_member(const idl_struct_t *type_spec, const char *member_name);
+
 int get_cpp11_type(
   char *str, size_t size, const void *node, void *user_data);
 
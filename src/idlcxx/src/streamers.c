@@ -124,10 +124,12 @@ struct streams {
   idl_buffer_t key_read;
   idl_buffer_t key_move;
   idl_buffer_t key_max;
+  idl_buffer_t key_extract;
+  idl_buffer_t declarations;
+  idl_buffer_t instantiations;
   size_t keys;
   bool key_max_sz_unlimited;
   bool max_sz_unlimited;
-  bool swapped;
 };
 
 static void setup_streams(struct streams* str, struct generator* gen)
@@ -155,6 +157,12 @@ static void cleanup_streams(struct streams* str)
     free(str->key_move.data);
   if (str->key_max.data)
     free(str->key_max.data);
+  if (str->key_extract.data)
+    free(str->key_extract.data);
+  if (str->declarations.data)
+    free(str->declarations.data);
+  if (str->instantiations.data)
+    free(str->instantiations.data);
 }
 
 static idl_retcode_t flush_stream(idl_buffer_t* str, FILE* f)
@@ -171,21 +179,30 @@ static idl_retcode_t flush_stream(idl_buffer_t* str, FILE* f)
 
 static idl_retcode_t flush(struct generator* gen, struct streams* streams)
 {
-  if (IDL_RETCODE_OK != flush_stream(&streams->write, gen->header.handle))
+  /* out-of-line streamers are defined in the source file */
+  FILE *defs = gen->out_of_line ? gen->source.handle : gen->header.handle;
+
+  if (IDL_RETCODE_OK != flush_stream(&streams->declarations, gen->header.handle))
+    return IDL_RETCODE_NO_MEMORY;
+  if (IDL_RETCODE_OK != flush_stream(&streams->write, defs))
+    return IDL_RETCODE_NO_MEMORY;
+  if (IDL_RETCODE_OK != flush_stream(&streams->read, defs))
     return IDL_RETCODE_NO_MEMORY;
-  if (IDL_RETCODE_OK != flush_stream(&streams->read, gen->header.handle))
+  if (IDL_RETCODE_OK != flush_stream(&streams->move, defs))
     return IDL_RETCODE_NO_MEMORY;
-  if (IDL_RETCODE_OK != flush_stream(&streams->move, gen->header.handle))
+  if (IDL_RETCODE_OK != flush_stream(&streams->max, defs))
     return IDL_RETCODE_NO_MEMORY;
-  if (IDL_RETCODE_OK != flush_stream(&streams->max, gen->header.handle))
+  if (IDL_RETCODE_OK != flush_stream(&streams->key_write, defs))
     return IDL_RETCODE_NO_MEMORY;
-  if (IDL_RETCODE_OK != flush_stream(&streams->key_write, gen->header.handle))
+  if (IDL_RETCODE_OK != flush_stream(&streams->key_read, defs))
     return IDL_RETCODE_NO_MEMORY;
-  if (IDL_RETCODE_OK != flush_stream(&streams->key_read, gen->header.handle))
+  if (IDL_RETCODE_OK != flush_stream(&streams->key_move, defs))
     return IDL_RETCODE_NO_MEMORY;
-  if (IDL_RETCODE_OK != flush_stream(&streams->key_move, gen->header.handle))
+  if (IDL_RETCODE_OK != flush_stream(&streams->key_max, defs))
     return IDL_RETCODE_NO_MEMORY;
-  if (IDL_RETCODE_OK != flush_stream(&streams->key_max, gen->header.handle))
+  if (IDL_RETCODE_OK != flush_stream(&streams->key_extract, defs))
+    return IDL_RETCODE_NO_MEMORY;
+  if (IDL_RETCODE_OK != flush_stream(&streams->instantiations, defs))
     return IDL_RETCODE_NO_MEMORY;
 
   streams->max_sz_unlimited = false;
@@ -205,8 +222,6 @@ write_string_streaming_functions(
   uint32_t maximum = ((const idl_string_t*)type_spec)->maximum;
 
   const char* fmt = "  %2$s_string(streamer, %1$s, %3$u);\n";
-  if (streams->swapped)
-    fmt = "  %2$s_string_swapped(streamer, %1$s, %3$u);\n";
 
   if ((loc.type & NORMAL_INSTANCE) &&
       (putf(&streams->write, fmt, accessor, "write", maximum)
@@ -245,8 +260,6 @@ write_typedef_streaming_functions(
   instance_location_t loc)
 {
   const char* fmt = "  %2$s_%3$s(streamer, %1$s);\n";
-  if (streams->swapped)
-    fmt = "  %2$s_%3$s_swapped(streamer, %1$s);\n";
 
   char* name = NULL;
   if (IDL_PRINTA(&name, get_cpp11_name_typedef, type_spec, streams->generator) < 0)
@@ -282,8 +295,6 @@ write_basic_type_streaming_functions(
   instance_location_t loc)
 {
   const char* fmt = "  %2$s(streamer, %1$s);\n";
-  if (streams->swapped)
-    fmt = "  %2$s_swapped(streamer, %1$s);\n";
 
   const char* read_fmt = fmt;
   if ((idl_type(type_spec) == IDL_BOOL) &&
@@ -333,8 +344,6 @@ write_constructed_type_streaming_functions(
   instance_location_t loc)
 {
   const char* fmt = "  %2$s(streamer, %1$s);\n";
-  if (streams->swapped)
-    fmt = "  %2$s_swapped(streamer, %1$s);\n";
 
   if ((loc.type & NORMAL_INSTANCE) &&
       (putf(&streams->write, fmt, accessor, "write")
@@ -352,8 +361,6 @@ write_constructed_type_streaming_functions(
       !idl_is_keyless(type_spec, pstate->flags & IDL_FLAG_KEYLIST))
   {
     fmt = "  key_%2$s(streamer, %1$s);\n";
-    if (streams->swapped)
-      fmt = "  key_%2$s_swapped(streamer, %1$s);\n";
   }
 
   if (putf(&streams->key_write, fmt, accessor, "write")
@@ -395,11 +402,6 @@ insert_sequence_primitives_copy(
 {
   const char *fmt = "  %1$s_many(streamer, %2$s.data(), se_%3$u);\n";
   const char *mfmt = "  %1$s_many(streamer, %2$s.data(), %3$u);\n";
-  if (streams->swapped)
-  {
-    fmt = "  %1$s_many_swapped(streamer, %2$s.data(), se_%3$u);\n";
-    mfmt = "  %1$s_many_swapped(streamer, %2$s.data(), %3$u);\n";
-  }
 
   if ((loc.type & NORMAL_INSTANCE) &&
       (putf(&streams->write, fmt, "write", accessor, depth)
@@ -444,6 +446,9 @@ unroll_sequence(const idl_pstate_t* pstate,
   instance_location_t loc)
 {
   uint32_t maximum = seq->maximum;
+  bool primitives = !idl_is_sequence(seq->type_spec)
+                 && idl_is_base_type(seq->type_spec)
+                 && !(idl_type(seq->type_spec) == IDL_BOOL);
 
   if (maximum == 0) {
     if (loc.type & NORMAL_INSTANCE)
@@ -466,42 +471,21 @@ unroll_sequence(const idl_pstate_t* pstate,
                                "  read(streamer, se_%1$u);\n"\
                                "  if (se_%1$u > %3$u &&\n"
                                "      streamer.status(serialization_status::read_bound_exceeded))\n"
-                               "        return;\n"\
-                               "  %2$s.resize(se_%1$u);\n"
+                               "        return;\n"
                              : "  {\n"\
                                "  uint32_t se_%1$u = 0;\n"\
-                               "  read(streamer, se_%1$u);\n"\
-                               "  %2$s.resize(se_%1$u);\n";
+                               "  read(streamer, se_%1$u);\n";
+  /* a sequence of primitives that is skipped over need not be sized, as it
+     is never copied into (see key_extract_stream) */
+  const char* resizefmt = primitives ? "  if (!skipping(streamer))\n"
+                                       "    %2$s.resize(se_%1$u);\n"
+                                     : "  %2$s.resize(se_%1$u);\n";
   const char* mfmt = "  {\n"\
                      "  max(streamer, uint32_t(0));\n";
-  if (streams->swapped)
-  {
-    wfmt = maximum ?  "  {\n"\
-                      "  uint32_t se_%1$u = uint32_t(%2$s.size());\n"\
-                      "  if (se_%1$u > %4$u &&\n"
-                      "      streamer.status(serialization_status::%3$s_bound_exceeded))\n"
-                      "        return;\n"\
-                      "  %3$s_swapped(streamer, se_%1$u);\n"
-                    : "  {\n"\
-                      "  uint32_t se_%1$u = uint32_t(%2$s.size());\n"\
-                      "  %3$s_swapped(streamer, se_%1$u);\n";
-    rfmt = maximum ?  "  {\n"\
-                      "  uint32_t se_%1$u = 0;\n"\
-                      "  read_swapped(streamer, se_%1$u);\n"\
-                      "  if (se_%1$u > %3$u &&\n"
-                      "      streamer.status(serialization_status::read_bound_exceeded))\n"
-                      "        return;\n"\
-                      "  %2$s.resize(se_%1$u);\n"
-                    : "  {\n"\
-                      "  uint32_t se_%1$u = 0;\n"\
-                      "  read_swapped(streamer, se_%1$u);\n"\
-                      "  %2$s.resize(se_%1$u);\n";
-    mfmt = "  {\n"\
-           "  max_swapped(streamer, uint32_t(0));\n";
-  }
 
   if ((loc.type & NORMAL_INSTANCE) &&
       (putf(&streams->read, rfmt, depth, read_accessor, maximum)
+    || putf(&streams->read, resizefmt, depth, read_accessor)
     || putf(&streams->write, wfmt, depth, accessor, "write", maximum)
     || putf(&streams->move, wfmt, depth, accessor, "move", maximum)
     || putf(&streams->max, mfmt)))
@@ -509,14 +493,13 @@ unroll_sequence(const idl_pstate_t* pstate,
 
   if ((loc.type & KEY_INSTANCE) &&
       (putf(&streams->key_read, rfmt, depth, read_accessor, maximum)
+    || putf(&streams->key_read, resizefmt, depth, read_accessor)
     || putf(&streams->key_write, wfmt, depth, accessor, "write", maximum)
     || putf(&streams->key_move, wfmt, depth, accessor, "move", maximum)
     || putf(&streams->key_max, mfmt)))
     return IDL_RETCODE_NO_MEMORY;
 
-  if (!idl_is_sequence(seq->type_spec)
-   && idl_is_base_type(seq->type_spec)
-   && !(idl_type(seq->type_spec) == IDL_BOOL))
+  if (primitives)
     return insert_sequence_primitives_copy(streams, accessor, read_accessor, loc, depth, maximum);
 
   mfmt = "  for (uint32_t i_%1$u = 0; i_%1$u < %2$u; i_%1$u++) {\n";
@@ -631,8 +614,6 @@ insert_array_primitives_copy(
     return IDL_RETCODE_NO_MEMORY;
 
   const char *fmt = "  %1$s_many(streamer, %2$s.data(), %3$u);\n";
-  if (streams->swapped)
-    fmt = "  %1$s_many_swapped(streamer, %2$s.data(), %3$u);\n";
 
   if ((loc.type & NORMAL_INSTANCE) &&
       (putf(&streams->write, fmt, "write", accessor, a_size)
@@ -701,6 +682,29 @@ process_instance(
     return write_streaming_functions(pstate, streams, type_spec, accessor, read_accessor, loc);
 }
 
+/* whether (part of) the key is in the member, with a keylist this is the case
+   if the first field name of a key is that of the member */
+static bool
+is_key_member(
+  const idl_pstate_t* pstate,
+  const idl_member_t* member,
+  const idl_declarator_t* declarator)
+{
+  const idl_struct_t *_struct = (const idl_struct_t *)((const idl_node_t *)member)->parent;
+  const idl_key_t *key = NULL;
+
+  if (!(pstate->flags & IDL_FLAG_KEYLIST))
+    return member->key.value;
+  if (!_struct->keylist)
+    return false;
+
+  IDL_FOREACH(key, _struct->keylist->keys) {
+    if (!idl_strcasecmp(key->field_name->names[0]->identifier, declarator->name->identifier))
+      return true;
+  }
+  return false;
+}
+
 static idl_retcode_t
 process_member(
   const idl_pstate_t* pstate,
@@ -709,21 +713,35 @@ process_member(
   const void* node,
   void* user_data)
 {
+  struct streams *streams = user_data;
+  const idl_member_t *member = (const idl_member_t *)node;
   const idl_declarator_t *declarator;
   const idl_type_spec_t *type_spec;
   instance_location_t loc = { .parent = "instance", .type = NORMAL_INSTANCE };
+  const char *skipfmt = "  streamer.skipping(%s);\n";
 
   (void)revisit;
   (void)path;
 
-  type_spec = ((const idl_member_t *)node)->type_spec;
+  type_spec = member->type_spec;
   /* only use the @key annotations when you do not use the keylist */
   if (!(pstate->flags & IDL_FLAG_KEYLIST) &&
-      ((const idl_member_t *)node)->key.value)
+      member->key.value)
     loc.type |= KEY_INSTANCE;
 
-  IDL_FOREACH(declarator, ((const idl_member_t *)node)->declarators) {
-    if (process_instance(pstate, user_data, declarator, type_spec, loc))
+  IDL_FOREACH(declarator, member->declarators) {
+    bool key = is_key_member(pstate, member, declarator);
+    size_t start = streams->read.used;
+
+    if (process_instance(pstate, streams, declarator, type_spec, loc))
+      return IDL_RETCODE_NO_MEMORY;
+
+    /* key_extract reads a member like read does, but the strings and
+       sequences of primitives of the members that are not part of the key
+       are skipped over instead of copied */
+    if ((!key && putf(&streams->key_extract, skipfmt, "true"))
+     || putf(&streams->key_extract, "%s", streams->read.data + start)
+     || (!key && putf(&streams->key_extract, skipfmt, "false")))
       return IDL_RETCODE_NO_MEMORY;
   }
 
@@ -830,11 +848,6 @@ process_inherit_spec(
   char *type = NULL;
   const char *fmt = "  %2$s(streamer,dynamic_cast<%1$s&>(instance));\n";
   const char *constfmt = "  %2$s(streamer,dynamic_cast<const %1$s&>(instance));\n";
-  if (streams->swapped)
-  {
-    fmt = "  %2$s(streamer,dynamic_cast<%1$s&>(instance));\n";
-    constfmt = "  %2$s(streamer,dynamic_cast<const %1$s&>(instance));\n";
-  }
 
   (void)pstate;
   (void)revisit;
@@ -852,13 +865,14 @@ process_inherit_spec(
   if (putf(&streams->key_write, constfmt, type, "key_write")
    || putf(&streams->key_read, fmt, type, "key_read")
    || putf(&streams->key_move, constfmt, type, "key_move")
-   || putf(&streams->key_max, constfmt, type, "key_max"))
+   || putf(&streams->key_max, constfmt, type, "key_max")
+   || putf(&streams->key_extract, fmt, type, "key_extract"))
     return IDL_RETCODE_NO_MEMORY;
 
   return IDL_RETCODE_OK;
 }
 
-static const idl_declarator_t*
+const idl_declarator_t*
 resolve_member(const idl_struct_t *type_spec, const char *member_name)
 {
   type_spec = idl_unalias(type_spec, 0u);
@@ -946,6 +960,55 @@ process_keylist(
   return ret;
 }
 
+/* declares the streaming functions of a type in the header and explicitly
+   instantiates them for both CDR streams, used for out-of-line streamers,
+   read and key_extract are also instantiated for the key extraction streams */
+static idl_retcode_t
+print_out_of_line(struct streams *streams, const char *typedef_name, const char *fullname)
+{
+  enum { CDR = 0x1, EXTRACT = 0x2 };
+  static const struct { const char *name; const char *qualifier; int streams; } funcs[] = {
+    { "write", "const ", CDR }, { "read", "", CDR | EXTRACT }, { "move", "const ", CDR }, { "max", "const ", CDR },
+    { "key_write", "const ", CDR }, { "key_read", "", CDR }, { "key_move", "const ", CDR }, { "key_max", "const ", CDR },
+    { "key_extract", "", EXTRACT }
+  };
+  static const struct { const char *name; int kind; } streamers[] = {
+    { "basic_cdr_stream", CDR }, { "swapped_basic_cdr_stream", CDR },
+    { "key_extract_stream", EXTRACT }, { "swapped_key_extract_stream", EXTRACT }
+  };
+  const char *declfmt =
+    "template<typename T>\n"
+    "void %1$s%2$s%3$s(T& streamer, %4$s%5$s& instance);\n";
+  const char *instfmt =
+    "template void %1$s%2$s%3$s<%6$s>(%6$s& streamer, %4$s%5$s& instance);\n";
+  const char *sep = typedef_name ? "_" : "";
+
+  if (!streams->generator->out_of_line)
+    return IDL_RETCODE_OK;
+  if (!typedef_name)
+    typedef_name = "";
+
+  for (size_t i = 0; i < sizeof(funcs)/sizeof(funcs[0]); i++) {
+    /* key_extract only exists for structs and unions */
+    if (*sep && funcs[i].streams == EXTRACT)
+      continue;
+    if (putf(&streams->declarations, declfmt, funcs[i].name, sep, typedef_name, funcs[i].qualifier, fullname))
+      return IDL_RETCODE_NO_MEMORY;
+    for (size_t j = 0; j < sizeof(streamers)/sizeof(streamers[0]); j++) {
+      if (!(funcs[i].streams & streamers[j].kind))
+        continue;
+      if (putf(&streams->instantiations, instfmt, funcs[i].name, sep, typedef_name, funcs[i].qualifier, fullname, streamers[j].name))
+        return IDL_RETCODE_NO_MEMORY;
+    }
+  }
+
+  if (putf(&streams->declarations, "\n")
+   || putf(&streams->instantiations, "\n"))
+    return IDL_RETCODE_NO_MEMORY;
+
+  return IDL_RETCODE_OK;
+}
+
 static idl_retcode_t
 print_constructed_type_open(struct streams *streams, const idl_node_t *node)
 {
@@ -958,15 +1021,6 @@ print_constructed_type_open(struct streams *streams, const idl_node_t *node)
   const char *constfmt =
     "template<typename T>\n"
     "void %2$s(T& streamer, const %1$s& instance)\n{\n";
-  if (streams->swapped)
-  {
-    fmt =
-      "template<typename T>\n"
-      "void %2$s_swapped(T& streamer, %1$s& instance)\n{\n";
-    constfmt =
-      "template<typename T>\n"
-      "void %2$s_swapped(T& streamer, const %1$s& instance)\n{\n";
-  }
 
   if (putf(&streams->write, constfmt, name, "write")
    || putf(&streams->read, fmt, name, "read")
@@ -975,7 +1029,9 @@ print_constructed_type_open(struct streams *streams, const idl_node_t *node)
    || putf(&streams->key_write, constfmt, name, "key_write")
    || putf(&streams->key_read, fmt, name, "key_read")
    || putf(&streams->key_move, constfmt, name, "key_move")
-   || putf(&streams->key_max, constfmt, name, "key_max"))
+   || putf(&streams->key_max, constfmt, name, "key_max")
+   || putf(&streams->key_extract, fmt, name, "key_extract")
+   || print_out_of_line(streams, NULL, name))
     return IDL_RETCODE_NO_MEMORY;
 
   return IDL_RETCODE_OK;
@@ -986,8 +1042,6 @@ print_constructed_type_close(struct streams *streams, const idl_node_t *node)
 {
   const char *close_key;
 
-  (void)node;
-
   if (streams->keys)
     close_key =
       "}\n\n";
@@ -1009,6 +1063,10 @@ print_constructed_type_close(struct streams *streams, const idl_node_t *node)
    || putf(&streams->key_max, close_key))
     return IDL_RETCODE_NO_MEMORY;
 
+  /* typedefs have no key_extract function */
+  if (!idl_is_declarator(node) && putf(&streams->key_extract, close_key))
+    return IDL_RETCODE_NO_MEMORY;
+
   streams->keys = 0;
   return IDL_RETCODE_OK;
 }
@@ -1030,14 +1088,6 @@ process_struct(
     "  streamer.position(SIZE_MAX);\n"
     "}\n\n";
 
-  if (streams->swapped)
-    fmt =
-      "template<typename T>\n"
-      "void %1$smax_swapped(T& streamer, const %2$s& instance) {\n"
-      "  (void)instance;\n"
-      "  streamer.position(SIZE_MAX);\n"
-      "}\n\n";
-
   char *fullname = NULL;
   if (IDL_PRINTA(&fullname, get_cpp11_fully_scoped_name, node, streams->generator) < 0)
     return IDL_RETCODE_NO_MEMORY;
@@ -1099,25 +1149,6 @@ process_switch_type_spec(
   const char *key_maxfmt =
     "  max(streamer, instance._d());\n";
 
-  if (streams->swapped)
-  {
-    writefmt =
-      "  auto d = instance._d();\n"
-      "  write_swapped(streamer, d);\n";
-    readfmt =
-      "  auto d = instance._d();\n"
-      "  read_swapped(streamer, d);\n";
-    movefmt =
-      "  auto d = instance._d();\n"
-      "  move_swapped(streamer, d);\n";
-    maxfmt =
-      "  max_swapped(streamer, instance._d());\n"
-      "  size_t union_max = streamer.position();\n"
-      "  size_t alignment_max = streamer.alignment();\n";
-    key_maxfmt =
-      "  max_swapped(streamer, instance._d());\n";
-  }
-
   const idl_switch_type_spec_t *switch_type_spec = node;
 
   (void)pstate;
@@ -1165,15 +1196,6 @@ process_union(
     "  (void)instance;\n"
     "  streamer.position(SIZE_MAX);\n"
     "}\n\n";
-  if (streams->swapped)
-  {
-    ffmt =
-      "template<typename T>\n"
-      "void max_swapped(T& streamer, const %1$s& instance) {\n"
-      "  (void)instance;\n"
-      "  streamer.position(SIZE_MAX);\n"
-      "}\n\n";
-  }
 
   char *fullname = NULL;
   if (IDL_PRINTA(&fullname, get_cpp11_fully_scoped_name, node, streams->generator) < 0)
@@ -1208,7 +1230,9 @@ process_union(
 
     return flush(streams->generator, streams);
   } else {
-    if (print_constructed_type_open(user_data, node))
+    /* a union is read in its entirety to get to its key (the discriminator) */
+    if (print_constructed_type_open(user_data, node)
+     || putf(&streams->key_extract, "  read(streamer, instance);\n"))
       return IDL_RETCODE_NO_MEMORY;
     return IDL_VISIT_REVISIT;
   }
@@ -1258,24 +1282,15 @@ process_typedef_decl(
 
   static const char* fmt =
     "template<typename T>\n"
-    "inline void %1$s_%2$s(T& streamer, %3$s& instance)\n{\n";
+    "void %1$s_%2$s(T& streamer, %3$s& instance)\n{\n";
   static const char* constfmt =
     "template<typename T>\n"
-    "inline void %1$s_%2$s(T& streamer, const %3$s& instance)\n{\n";
+    "void %1$s_%2$s(T& streamer, const %3$s& instance)\n{\n";
   static const char* closefmt =
     "  (void)instance;\n"
     "  streamer.position(SIZE_MAX);\n"
     "}\n\n";
-  if (streams->swapped)
-  {
-      fmt =
-        "template<typename T>\n"
-        "inline void %1$s_%2$s_swapped(T& streamer, %3$s& instance)\n{\n";
-      constfmt =
-        "template<typename T>\n"
-        "inline void %1$s_%2$s_swapped(T& streamer, const %3$s& instance)\n{\n";
 
-  }
   char* name = NULL;
   if (IDL_PRINTA(&name, get_cpp11_name_typedef, declarator, streams->generator) < 0)
     return IDL_RETCODE_NO_MEMORY;
@@ -1291,14 +1306,15 @@ process_typedef_decl(
    || putf(&streams->key_write, constfmt, "key_write", name, fullname)
    || putf(&streams->key_read, fmt, "key_read", name, fullname)
    || putf(&streams->key_move, constfmt, "key_move", name, fullname)
-   || putf(&streams->key_max, constfmt, "key_max", name, fullname))
+   || putf(&streams->key_max, constfmt, "key_max", name, fullname)
+   || print_out_of_line(streams, name, fullname))
     return IDL_RETCODE_NO_MEMORY;
 
   idl_retcode_t ret = process_instance(pstate, streams, declarator, type_spec, loc);
   if (ret != IDL_RETCODE_OK)
     return ret;
 
-  if (print_constructed_type_close(streams, type_spec))
+  if (print_constructed_type_close(streams, (const idl_node_t *)declarator))
     return IDL_RETCODE_NO_MEMORY;
 
   if (streams->max_sz_unlimited) {
@@ -1348,6 +1364,18 @@ generate_streamers(const idl_pstate_t* pstate, struct generator *gen)
   struct streams streams;
   idl_visitor_t visitor;
   const char *sources[] = { NULL, NULL };
+  static const char *nsopen =
+    "namespace org{\n"
+    "namespace eclipse{\n"
+    "namespace cyclonedds{\n"
+    "namespace core{\n"
+    "namespace cdr{\n\n";
+  static const char *nsclose =
+    "} //namespace cdr\n"
+    "} //namespace core\n"
+    "} //namespace cyclonedds\n"
+    "} //namespace eclipse\n"
+    "} //namespace org\n\n";
 
   setup_streams(&streams, gen);
 
@@ -1357,12 +1385,8 @@ generate_streamers(const idl_pstate_t* pstate, struct generator *gen)
   sources[0] = pstate->sources->path->name;
   visitor.sources = sources;
 
-  if (idl_fprintf(gen->header.handle,
-                  "namespace org{\n"
-                  "namespace eclipse{\n"
-                  "namespace cyclonedds{\n"
-                  "namespace core{\n"
-                  "namespace cdr{\n\n") < 0)
+  if (fputs(nsopen, gen->header.handle) < 0
+   || (gen->out_of_line && fputs(nsopen, gen->source.handle) < 0))
     return IDL_RETCODE_NO_MEMORY;
 
   visitor.visit = IDL_STRUCT | IDL_UNION | IDL_MEMBER | IDL_CASE | IDL_CASE_LABEL | IDL_SWITCH_TYPE_SPEC | IDL_INHERIT_SPEC | IDL_TYPEDEF;
@@ -1380,18 +1404,8 @@ generate_streamers(const idl_pstate_t* pstate, struct generator *gen)
       (ret = flush(gen, &streams)) != IDL_RETCODE_OK)
     return ret;
 
-  streams.swapped = true;
-
-  if ((ret = idl_visit(pstate, pstate->root, &visitor, &streams)) != IDL_RETCODE_OK ||
-      (ret = flush(gen, &streams)) != IDL_RETCODE_OK)
-    return ret;
-
-  if (idl_fprintf(gen->header.handle,
-                  "} //namespace cdr\n"
-                  "} //namespace core\n"
-                  "} //namespace cyclonedds\n"
-                  "} //namespace eclipse\n"
-                  "} //namespace org\n\n") < 0)
+  if (fputs(nsclose, gen->header.handle) < 0
+   || (gen->out_of_line && fputs(nsclose, gen->source.handle) < 0))
     return IDL_RETCODE_NO_MEMORY;
 
   cleanup_streams(&streams);
@@ -9,6 +9,8 @@
  *
  * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
  */
+#include <assert.h>
+#include <inttypes.h>
 #include <string.h>
 
 #include "idl/stream.h"
@@ -17,51 +19,424 @@
 
 #include "generator.h"
 
-static bool sc_type_spec(const idl_type_spec_t *type_spec);
+static bool sc_type_spec(const struct generator *gen, const idl_type_spec_t *type_spec);
 
-static bool sc_union(const idl_union_t *_union)
+static bool sc_union(const struct generator *gen, const idl_union_t *_union)
 {
-  if (!sc_type_spec(_union->switch_type_spec->type_spec))
+  if (!sc_type_spec(gen, _union->switch_type_spec->type_spec))
     return false;
 
   const idl_case_t *_case = NULL;
   IDL_FOREACH(_case, _union->cases) {
-    if (!sc_type_spec(_case->type_spec))
+    if (!sc_type_spec(gen, _case->type_spec))
       return false;
   }
 
   return true;
 }
 
-static bool sc_struct(const idl_struct_t *str)
+static bool sc_struct(const struct generator *gen, const idl_struct_t *str)
 {
   const idl_member_t *mem = NULL;
   IDL_FOREACH(mem, str->members) {
-    if (!sc_type_spec(mem->type_spec))
+    if (!sc_type_spec(gen, mem->type_spec))
       return false;
   }
 
   if (str->inherit_spec)
-    return sc_type_spec(str->inherit_spec->base);
+    return sc_type_spec(gen, str->inherit_spec->base);
 
   return true;
 }
 
-static bool sc_type_spec(const idl_type_spec_t *type_spec)
+static bool sc_type_spec(const struct generator *gen, const idl_type_spec_t *type_spec)
 {
-  if (idl_is_sequence(type_spec)
+  if (is_inline_bounded(gen, type_spec)) {
+    /* the elements are stored in the sample itself */
+    return !idl_is_sequence(type_spec) ||
+           sc_type_spec(gen, ((const idl_sequence_t*)type_spec)->type_spec);
+  } else if (idl_is_sequence(type_spec)
    || idl_is_string(type_spec)) {
     return false;
   } else if (idl_is_typedef(type_spec)) {
-    return sc_type_spec(((const idl_typedef_t*)type_spec)->type_spec);
+    return sc_type_spec(gen, ((const idl_typedef_t*)type_spec)->type_spec);
   } else if (idl_is_union(type_spec)) {
-    return sc_union(type_spec);
+    return sc_union(gen, type_spec);
   } else if (idl_is_struct(type_spec)) {
-    return sc_struct(type_spec);
+    return sc_struct(gen, type_spec);
   }
   return true;
 }
 
+/* (maximum) serialized sizes, calculated the same way as the generated max
+   and key_max functions do it: basic CDR with a maximum alignment of 8 bytes,
+   where SIZE_MAX denotes a size that is unbounded */
+#define CDR_MAX_ALIGN (8u)
+
+struct cdr_size {
+  const idl_pstate_t *pstate;
+  bool fixed;
+};
+
+static size_t cdr_add(size_t pos, size_t incr)
+{
+  if (pos == SIZE_MAX || incr >= SIZE_MAX - pos)
+    return SIZE_MAX;
+  return pos + incr;
+}
+
+static size_t cdr_primitive(size_t pos, size_t size)
+{
+  size_t align = size < CDR_MAX_ALIGN ? size : CDR_MAX_ALIGN;
+  if (pos == SIZE_MAX)
+    return SIZE_MAX;
+  return cdr_add(pos, (align - pos % align) % align + size);
+}
+
+static size_t cdr_base_type_size(const idl_type_spec_t *type_spec)
+{
+  switch (idl_type(type_spec)) {
+    case IDL_BOOL:
+    case IDL_CHAR:
+    case IDL_INT8:
+    case IDL_UINT8:
+    case IDL_OCTET:   return 1;
+    case IDL_SHORT:
+    case IDL_INT16:
+    case IDL_USHORT:
+    case IDL_UINT16:  return 2;
+    case IDL_LONG:
+    case IDL_INT32:
+    case IDL_ULONG:
+    case IDL_UINT32:
+    case IDL_FLOAT:   return 4;
+    case IDL_LLONG:
+    case IDL_INT64:
+    case IDL_ULLONG:
+    case IDL_UINT64:
+    case IDL_DOUBLE:  return 8;
+    default:
+      /* the size of long double and wchar is platform dependent */
+      return 0;
+  }
+}
+
+static size_t cdr_type_spec(struct cdr_size *cs, const idl_type_spec_t *type_spec, bool key, size_t pos);
+
+/* the position after count consecutive instances of a type, as the padding
+   only depends on the position modulo the maximum alignment, this repeats
+   with a period of at most CDR_MAX_ALIGN instances */
+static size_t cdr_repeat(
+  struct cdr_size *cs, const idl_type_spec_t *type_spec, bool key, uint64_t count, size_t pos)
+{
+  uint64_t index[CDR_MAX_ALIGN];
+  size_t start[CDR_MAX_ALIGN];
+  bool skipped = false;
+
+  for (size_t i = 0; i < CDR_MAX_ALIGN; i++)
+    index[i] = UINT64_MAX;
+
+  for (uint64_t i = 0; i < count && pos != SIZE_MAX; i++) {
+    size_t mod = pos % CDR_MAX_ALIGN;
+    if (!skipped && index[mod] != UINT64_MAX) {
+      uint64_t period = i - index[mod], times = (count - i) / period;
+      size_t incr = pos - start[mod];
+      if (incr && times > (SIZE_MAX - pos) / incr)
+        return SIZE_MAX;
+      pos += (size_t)times * incr;
+      i += times * period;
+      skipped = true;
+      if (i >= count)
+        break;
+    }
+    index[mod] = i;
+    start[mod] = pos;
+    pos = cdr_type_spec(cs, type_spec, key, pos);
+  }
+
+  return pos;
+}
+
+static size_t cdr_declarator(
+  struct cdr_size *cs, const idl_declarator_t *declarator, const idl_type_spec_t *type_spec, bool key, size_t pos)
+{
+  uint64_t count = 1;
+
+  if (idl_is_array(declarator)) {
+    for (const idl_const_expr_t *ce = declarator->const_expr; ce; ce = idl_next(ce)) {
+      count *= ((const idl_literal_t *)ce)->value.uint32;
+      if (count > UINT32_MAX)
+        return SIZE_MAX;
+    }
+  }
+
+  return cdr_repeat(cs, type_spec, key, count, pos);
+}
+
+static size_t cdr_struct_key(struct cdr_size *cs, const idl_struct_t *_struct, size_t pos);
+
+/* the key of a base type is serialized after the keylist of the derived
+   type, but before the @key members of the derived type */
+static size_t cdr_base_key(struct cdr_size *cs, const idl_struct_t *_struct, size_t pos)
+{
+  if (!_struct->inherit_spec)
+    return pos;
+  return cdr_struct_key(cs, idl_unalias(_struct->inherit_spec->base, 0u), pos);
+}
+
+static size_t cdr_struct_key(struct cdr_size *cs, const idl_struct_t *_struct, size_t pos)
+{
+  const idl_member_t *mem = NULL;
+  const idl_declarator_t *decl = NULL;
+
+  if (cs->pstate->flags & IDL_FLAG_KEYLIST) {
+    const idl_key_t *key = NULL;
+    if (_struct->keylist) {
+      IDL_FOREACH(key, _struct->keylist->keys) {
+        const idl_type_spec_t *type_spec = _struct;
+        for (size_t i = 0; i < key->field_name->length; i++) {
+          decl = resolve_member(type_spec, key->field_name->names[i]->identifier);
+          assert(decl);
+          type_spec = ((const idl_member_t *)((const idl_node_t *)decl)->parent)->type_spec;
+        }
+        pos = cdr_declarator(cs, decl, type_spec, true, pos);
+      }
+    }
+    return cdr_base_key(cs, _struct, pos);
+  }
+
+  pos = cdr_base_key(cs, _struct, pos);
+  IDL_FOREACH(mem, _struct->members) {
+    if (!mem->key.value)
+      continue;
+    IDL_FOREACH(decl, mem->declarators) {
+      pos = cdr_declarator(cs, decl, mem->type_spec, true, pos);
+    }
+  }
+  return pos;
+}
+
+static size_t cdr_struct(struct cdr_size *cs, const idl_struct_t *_struct, size_t pos)
+{
+  const idl_member_t *mem = NULL;
+  const idl_declarator_t *decl = NULL;
+
+  if (_struct->inherit_spec)
+    pos = cdr_type_spec(cs, _struct->inherit_spec->base, false, pos);
+  IDL_FOREACH(mem, _struct->members) {
+    IDL_FOREACH(decl, mem->declarators) {
+      pos = cdr_declarator(cs, decl, mem->type_spec, false, pos);
+    }
+  }
+  return pos;
+}
+
+static size_t cdr_union(struct cdr_size *cs, const idl_union_t *_union, size_t pos)
+{
+  const idl_case_t *_case = NULL;
+  size_t union_max;
+
+  /* the serialized size depends on the discriminator value */
+  cs->fixed = false;
+  pos = cdr_type_spec(cs, _union->switch_type_spec->type_spec, false, pos);
+  union_max = pos;
+  IDL_FOREACH(_case, _union->cases) {
+    size_t case_max = cdr_declarator(cs, _case->declarator, _case->type_spec, false, pos);
+    if (case_max > union_max)
+      union_max = case_max;
+  }
+  return union_max;
+}
+
+static size_t cdr_type_spec(struct cdr_size *cs, const idl_type_spec_t *type_spec, bool key, size_t pos)
+{
+  bool keylist = (cs->pstate->flags & IDL_FLAG_KEYLIST) != 0;
+
+  if (pos == SIZE_MAX)
+    return SIZE_MAX;
+
+  if (idl_is_alias(type_spec)) {
+    return cdr_declarator(cs, type_spec, idl_type_spec(type_spec), key, pos);
+  } else if (idl_is_string(type_spec)) {
+    uint32_t maximum = ((const idl_string_t *)type_spec)->maximum;
+    cs->fixed = false;
+    if (maximum == 0)
+      return SIZE_MAX;
+    return cdr_add(cdr_primitive(pos, 4), (size_t)maximum + 1);
+  } else if (idl_is_sequence(type_spec)) {
+    const idl_sequence_t *seq = type_spec;
+    cs->fixed = false;
+    if (seq->maximum == 0)
+      return SIZE_MAX;
+    return cdr_repeat(cs, seq->type_spec, key, seq->maximum, cdr_primitive(pos, 4));
+  } else if (idl_is_struct(type_spec)) {
+    if (key && !idl_is_keyless(type_spec, keylist))
+      return cdr_struct_key(cs, type_spec, pos);
+    return cdr_struct(cs, type_spec, pos);
+  } else if (idl_is_union(type_spec)) {
+    const idl_union_t *_union = type_spec;
+    if (key && !idl_is_keyless(type_spec, keylist))
+      return cdr_type_spec(cs, _union->switch_type_spec->type_spec, false, pos);
+    return cdr_union(cs, _union, pos);
+  } else if (idl_is_enum(type_spec)) {
+    return cdr_primitive(pos, 4);
+  } else {
+    size_t size = cdr_base_type_size(type_spec);
+    if (size == 0) {
+      cs->fixed = false;
+      return SIZE_MAX;
+    }
+    return cdr_primitive(pos, size);
+  }
+}
+
+static const char *size_value(char *str, size_t size, size_t value)
+{
+  if (value == SIZE_MAX)
+    return "SIZE_MAX";
+  idl_snprintf(str, size, "%" PRIu64, (uint64_t)value);
+  return str;
+}
+
+/* stable hash of the definition of a type, 64-bit FNV-1a over a canonical
+   description of the type and all types it depends on. Types are nested no
+   deeper than TYPE_HASH_DEPTH, so that recursive types terminate */
+#define TYPE_HASH_DEPTH (32u)
+
+struct type_hash {
+  struct generator *gen;
+  const idl_pstate_t *pstate;
+  uint64_t value;
+  uint32_t depth;
+};
+
+static void th_bytes(struct type_hash *th, const void *data, size_t size)
+{
+  const unsigned char *ptr = data;
+  for (size_t i = 0; i < size; i++) {
+    th->value ^= ptr[i];
+    th->value *= UINT64_C(0x100000001b3);
+  }
+}
+
+static void th_uint(struct type_hash *th, uint64_t value)
+{
+  unsigned char bytes[8];
+  for (size_t i = 0; i < sizeof(bytes); i++)
+    bytes[i] = (unsigned char)(value >> (8 * i));
+  th_bytes(th, bytes, sizeof(bytes));
+}
+
+static void th_string(struct type_hash *th, const char *str)
+{
+  /* include the terminator to separate consecutive strings */
+  th_bytes(th, str, strlen(str) + 1);
+}
+
+static idl_retcode_t th_name(struct type_hash *th, const void *node)
+{
+  char *name = NULL;
+  if (IDL_PRINTA(&name, get_cpp11_fully_scoped_name, node, th->gen) < 0)
+    return IDL_RETCODE_NO_MEMORY;
+  th_string(th, name);
+  return IDL_RETCODE_OK;
+}
+
+static idl_retcode_t th_type_spec(struct type_hash *th, const idl_type_spec_t *type_spec);
+
+static idl_retcode_t th_declarator(struct type_hash *th, const idl_declarator_t *declarator)
+{
+  th_string(th, get_cpp11_name(declarator));
+  if (idl_is_array(declarator)) {
+    for (const idl_const_expr_t *ce = declarator->const_expr; ce; ce = idl_next(ce))
+      th_uint(th, ((const idl_literal_t *)ce)->value.uint32);
+  }
+  return IDL_RETCODE_OK;
+}
+
+static idl_retcode_t th_struct(struct type_hash *th, const idl_struct_t *_struct)
+{
+  const idl_member_t *mem = NULL;
+  const idl_declarator_t *decl = NULL;
+  idl_retcode_t ret;
+
+  if (_struct->inherit_spec && (ret = th_type_spec(th, _struct->inherit_spec->base)))
+    return ret;
+  IDL_FOREACH(mem, _struct->members) {
+    th_uint(th, mem->key.value);
+    if ((ret = th_type_spec(th, mem->type_spec)))
+      return ret;
+    IDL_FOREACH(decl, mem->declarators) {
+      if ((ret = th_declarator(th, decl)))
+        return ret;
+    }
+  }
+  if ((th->pstate->flags & IDL_FLAG_KEYLIST) && _struct->keylist) {
+    const idl_key_t *key = NULL;
+    IDL_FOREACH(key, _struct->keylist->keys) {
+      for (size_t i = 0; i < key->field_name->length; i++)
+        th_string(th, key->field_name->names[i]->identifier);
+    }
+  }
+  return IDL_RETCODE_OK;
+}
+
+static idl_retcode_t th_union(struct type_hash *th, const idl_union_t *_union)
+{
+  const idl_case_t *_case = NULL;
+  const idl_case_label_t *label = NULL;
+  idl_retcode_t ret;
+
+  if ((ret = th_type_spec(th, _union->switch_type_spec->type_spec)))
+    return ret;
+  IDL_FOREACH(_case, _union->cases) {
+    IDL_FOREACH(label, _case->labels) {
+      char *value = "default";
+      if (idl_mask(label) != IDL_DEFAULT_CASE_LABEL &&
+          IDL_PRINTA(&value, get_cpp11_value, label->const_expr, th->gen) < 0)
+        return IDL_RETCODE_NO_MEMORY;
+      th_string(th, value);
+    }
+    if ((ret = th_type_spec(th, _case->type_spec))
+     || (ret = th_declarator(th, _case->declarator)))
+      return ret;
+  }
+  return IDL_RETCODE_OK;
+}
+
+static idl_retcode_t th_type_spec(struct type_hash *th, const idl_type_spec_t *type_spec)
+{
+  idl_retcode_t ret = IDL_RETCODE_OK;
+
+  th_uint(th, idl_type(type_spec));
+  if (idl_is_alias(type_spec)) {
+    if ((ret = th_declarator(th, type_spec)))
+      return ret;
+    return th_type_spec(th, idl_type_spec(type_spec));
+  } else if (idl_is_string(type_spec)) {
+    th_uint(th, ((const idl_string_t *)type_spec)->maximum);
+  } else if (idl_is_sequence(type_spec)) {
+    const idl_sequence_t *seq = type_spec;
+    th_uint(th, seq->maximum);
+    return th_type_spec(th, seq->type_spec);
+  } else if (idl_is_struct(type_spec) || idl_is_union(type_spec) || idl_is_enum(type_spec)) {
+    if ((ret = th_name(th, type_spec)) || th->depth >= TYPE_HASH_DEPTH)
+      return ret;
+    th->depth++;
+    if (idl_is_struct(type_spec)) {
+      ret = th_struct(th, type_spec);
+    } else if (idl_is_union(type_spec)) {
+      ret = th_union(th, type_spec);
+    } else {
+      const idl_enumerator_t *enumerator = NULL;
+      IDL_FOREACH(enumerator, ((const idl_enum_t *)type_spec)->enumerators)
+        th_string(th, get_cpp11_name(enumerator));
+    }
+    th->depth--;
+  }
+  return ret;
+}
+
 static idl_retcode_t
 emit_topic_type_name(
   const idl_pstate_t* pstate,
@@ -106,9 +481,13 @@ emit_traits(
   struct generator *gen = user_data;
   char *name = NULL;
   const char *fmt, *keyless = "true", *selfcontained = "true";
+  const char *fixedsize = "true", *keysimple = "false";
+  char max_buf[24], key_max_buf[24], hash_buf[8 * 6];
   const idl_struct_t *_struct = node;
+  struct cdr_size cs = { pstate, true }, key_cs = { pstate, true };
+  struct type_hash th = { gen, pstate, UINT64_C(0xcbf29ce484222325), 0 };
+  size_t max_size, key_max_size;
 
-  (void)pstate;
   (void)revisit;
   (void)path;
 
@@ -124,6 +503,10 @@ emit_traits(
         "  {\n"
         "    return \"%2$s\";\n" /* skip preceeding "::" according to convention */
         "  }\n\n"
+        "  static ::std::vector<uint8_t> getTypeHash()\n"
+        "  {\n"
+        "    return { %9$s };\n"
+        "  }\n\n"
         "  static ddsi_sertype *getSerType()\n"
         "  {\n"
         "    auto *st = new ddscxx_sertype<%1$s>();\n"
@@ -136,15 +519,49 @@ emit_traits(
         "  static bool isSelfContained()\n"
         "  {\n"
         "    return %4$s;\n"
+        "  }\n\n"
+        "  static constexpr bool isFixedSize()\n"
+        "  {\n"
+        "    return %5$s;\n"
+        "  }\n\n"
+        "  static constexpr size_t getMaxSerializedSize()\n"
+        "  {\n"
+        "    return %6$s;\n"
+        "  }\n\n"
+        "  static constexpr size_t getKeyMaxSize()\n"
+        "  {\n"
+        "    return %7$s;\n"
+        "  }\n\n"
+        "  static constexpr bool isKeySimple()\n"
+        "  {\n"
+        "    return %8$s;\n"
+        "  }\n\n"
+        "  static ::org::eclipse::cyclonedds::topic::DataRepresentationId_t getDataRepresentationId()\n"
+        "  {\n"
+        "    return ::org::eclipse::cyclonedds::topic::XCDR_REPRESENTATION;\n"
         "  }\n"
         "};\n\n";
   if (IDL_PRINTA(&name, get_cpp11_fully_scoped_name, _struct, gen) < 0)
     return IDL_RETCODE_NO_MEMORY;
   if (!idl_is_keyless(node, pstate->flags & IDL_FLAG_KEYLIST))
     keyless = "false";
-  if (!sc_struct(_struct))
+  if (!sc_struct(gen, _struct))
     selfcontained = "false";
-  if (idl_fprintf(gen->header.handle, fmt, name, name+2, keyless, selfcontained) < 0)
+  max_size = cdr_struct(&cs, _struct, 0);
+  if (!cs.fixed || max_size == SIZE_MAX)
+    fixedsize = "false";
+  key_max_size = cdr_struct_key(&key_cs, _struct, 0);
+  /* keys that fit in the keyhash are not MD5 hashed */
+  if (key_max_size <= 16)
+    keysimple = "true";
+  if (th_type_spec(&th, _struct))
+    return IDL_RETCODE_NO_MEMORY;
+  for (size_t i = 0; i < 8; i++)
+    idl_snprintf(hash_buf + 6 * i, 7, "0x%02x%s",
+      (unsigned)((th.value >> (56 - 8 * i)) & 0xffu), i < 7 ? ", " : "");
+  if (idl_fprintf(gen->header.handle, fmt, name, name+2, keyless, selfcontained, fixedsize,
+        size_value(max_buf, sizeof(max_buf), max_size),
+        size_value(key_max_buf, sizeof(key_max_buf), key_max_size), keysimple, hash_buf) < 0)
     return IDL_RETCODE_NO_MEMORY;
 
   return IDL_RETCODE_OK;
@@ -81,7 +81,6 @@ emit_parameter(
   void *user_data)
 {
   struct generator *gen = user_data;
-  bool simple;
   char *type;
   const char *name, *fmt, *sep;
   const idl_type_spec_t *type_spec;
@@ -95,10 +94,9 @@ emit_parameter(
   else
     type_spec = idl_type_spec(node);
 
-  simple = idl_mask(idl_unalias(type_spec, 0)) & (IDL_BASE_TYPE|IDL_ENUM);
   sep = is_first(node) ? "" : ",\n";
-  fmt = simple ? "%s    %s %s"
-               : "%s    const %s& %s";
+  /* taken by value, the member is move-constructed from the parameter */
+  fmt = "%s    %s %s";
   name = get_cpp11_name(node);
   if (IDL_PRINTA(&type, get_cpp11_type, type_spec, gen) < 0)
     return IDL_RETCODE_NO_MEMORY;
@@ -122,7 +120,7 @@ emit_member_initializer(
   (void)revisit;
   (void)path;
 
-  fmt = "%1$s    %2$s_(%2$s)";
+  fmt = "%1$s    %2$s_(std::move(%2$s))";
   sep = is_first(node) ? "" : ",\n";
   name = get_cpp11_name(node);
   if (idl_fprintf(gen->header.handle, fmt, sep, name) < 0)
@@ -167,7 +165,7 @@ emit_member_methods(
     fmt = "  const %1$s& %2$s() const { return this->%2$s_; }\n"
           "  %1$s& %2$s() { return this->%2$s_; }\n"
           "  void %2$s(const %1$s& _val_) { this->%2$s_ = _val_; }\n"
-          "  void %2$s(%1$s&& _val_) { this->%2$s_ = _val_; }\n";
+          "  void %2$s(%1$s&& _val_) { this->%2$s_ = std::move(_val_); }\n";
 
   if (idl_fprintf(gen->header.handle, fmt, type, name) < 0)
     return IDL_RETCODE_NO_MEMORY;
@@ -175,6 +173,28 @@ emit_member_methods(
   return IDL_RETCODE_OK;
 }
 
+static idl_retcode_t
+emit_member_swap(
+  const idl_pstate_t *pstate,
+  bool revisit,
+  const idl_path_t *path,
+  const void *node,
+  void *user_data)
+{
+  struct generator *gen = user_data;
+  const char *name, *fmt;
+
+  (void)pstate;
+  (void)revisit;
+  (void)path;
+
+  name = get_cpp11_name(node);
+  fmt = "    swap(this->%1$s_, _other.%1$s_);\n";
+  if (idl_fprintf(gen->header.handle, fmt, name) < 0)
+    return IDL_RETCODE_NO_MEMORY;
+  return IDL_RETCODE_OK;
+}
+
 static idl_retcode_t
 emit_member_comparison_operator(
   const idl_pstate_t *pstate,
@@ -198,6 +218,141 @@ emit_member_comparison_operator(
   return IDL_RETCODE_OK;
 }
 
+/* members of which the type takes an allocator, i.e. (std::pmr) strings,
+   sequences and allocator-aware structs, but not the inline containers */
+static bool is_allocator_aware(const struct generator *gen, const void *node)
+{
+  const idl_type_spec_t *type_spec;
+
+  if (idl_is_array(node))
+    return false;
+  type_spec = idl_unalias(idl_type_spec(node), 0);
+  if (idl_is_array(type_spec) || is_inline_bounded(gen, type_spec))
+    return false;
+  return idl_is_string(type_spec) ||
+         idl_is_sequence(type_spec) ||
+         idl_is_struct(type_spec);
+}
+
+struct allocator_initializer {
+  struct generator *generator;
+  /* format for members that do and do not take the allocator */
+  const char *aware_fmt;
+  const char *plain_fmt;
+  const char *sep;
+  bool uses_alloc;
+  bool uses_other;
+};
+
+static idl_retcode_t
+emit_allocator_initializer(
+  const idl_pstate_t *pstate,
+  bool revisit,
+  const idl_path_t *path,
+  const void *node,
+  void *user_data)
+{
+  struct allocator_initializer *init = user_data;
+  const char *name, *fmt;
+  bool aware;
+
+  (void)pstate;
+  (void)revisit;
+  (void)path;
+
+  aware = is_allocator_aware(init->generator, node);
+  fmt = aware ? init->aware_fmt : init->plain_fmt;
+  /* members that do not need the allocator are default initialized */
+  if (!fmt)
+    return IDL_RETCODE_OK;
+  name = get_cpp11_name(node);
+  if (idl_fprintf(init->generator->header.handle, fmt, init->sep, name) < 0)
+    return IDL_RETCODE_NO_MEMORY;
+  init->sep = ",\n";
+  init->uses_alloc = init->uses_alloc || aware;
+  init->uses_other = true;
+  return IDL_RETCODE_OK;
+}
+
+static idl_retcode_t
+emit_allocator_constructors(
+  const idl_pstate_t *pstate,
+  const idl_struct_t *_struct,
+  struct generator *gen)
+{
+  idl_retcode_t ret;
+  idl_visitor_t visitor;
+  struct allocator_initializer init;
+  const char *name, *fmt;
+  char *base = NULL;
+  static const struct {
+    const char *signature;
+    const char *base_fmt;
+    const char *aware_fmt;
+    const char *plain_fmt;
+  } ctors[] = {
+    { "  explicit %1$s(const allocator_type& _alloc)",
+      "    %1$s(_alloc)",
+      "%1$s    %2$s_(_alloc)",
+      NULL },
+    { "  %1$s(const %1$s& _other, const allocator_type& _alloc)",
+      "    %1$s(_other, _alloc)",
+      "%1$s    %2$s_(_other.%2$s_, _alloc)",
+      "%1$s    %2$s_(_other.%2$s_)" },
+    { "  %1$s(%1$s&& _other, const allocator_type& _alloc)",
+      "    %1$s(std::move(_other), _alloc)",
+      "%1$s    %2$s_(std::move(_other.%2$s_), _alloc)",
+      "%1$s    %2$s_(std::move(_other.%2$s_))" }
+  };
+
+  name = get_cpp11_name(_struct);
+  if (_struct->inherit_spec &&
+      IDL_PRINTA(&base, get_cpp11_fully_scoped_name, _struct->inherit_spec->base, gen) < 0)
+    return IDL_RETCODE_NO_MEMORY;
+
+  fmt = "  using allocator_type = std::pmr::polymorphic_allocator<char>;\n\n";
+  if (fputs(fmt, gen->header.handle) < 0)
+    return IDL_RETCODE_NO_MEMORY;
+
+  memset(&visitor, 0, sizeof(visitor));
+  visitor.visit = IDL_DECLARATOR;
+  visitor.accept[IDL_ACCEPT_DECLARATOR] = &emit_allocator_initializer;
+
+  for (size_t i = 0; i < sizeof(ctors)/sizeof(ctors[0]); i++) {
+    if (idl_fprintf(gen->header.handle, ctors[i].signature, name) < 0)
+      return IDL_RETCODE_NO_MEMORY;
+    /* the initializer list is opened lazily, it may turn out to be empty */
+    init.generator = gen;
+    init.aware_fmt = ctors[i].aware_fmt;
+    init.plain_fmt = ctors[i].plain_fmt;
+    init.sep = " :\n";
+    init.uses_alloc = init.uses_other = false;
+    if (base) {
+      if (fputs(init.sep, gen->header.handle) < 0 ||
+          idl_fprintf(gen->header.handle, ctors[i].base_fmt, base) < 0)
+        return IDL_RETCODE_NO_MEMORY;
+      init.sep = ",\n";
+      init.uses_alloc = init.uses_other = true;
+    }
+    if (_struct->members && (ret = idl_visit(pstate, _struct->members, &visitor, &init)))
+      return ret;
+    /* keep unused parameters from raising warnings */
+    if (i && !init.uses_other)
+      fmt = " { (void)_other; (void)_alloc; }\n";
+    else if (!init.uses_alloc)
+      fmt = " { (void)_alloc; }\n";
+    else
+      fmt = " { }\n";
+    if (fputs(fmt, gen->header.handle) < 0)
+      return IDL_RETCODE_NO_MEMORY;
+  }
+
+  if (fputs("\n", gen->header.handle) < 0)
+    return IDL_RETCODE_NO_MEMORY;
+
+  return IDL_RETCODE_OK;
+}
+
 static idl_retcode_t
 emit_struct(
   const idl_pstate_t *pstate,
@@ -240,13 +395,23 @@ emit_struct(
   if (_struct->members && (ret = idl_visit(pstate, _struct->members, &visitor, user_data)))
     return ret;
 
-  /* constructors */
+  /* constructors. the moves are noexcept exactly when those of all members
+     are, which is not the case for std::pmr containers or for sequence and
+     string templates that may copy when moved */
   fmt = "\n"
         "public:\n"
-        "  %1$s() = default;\n\n";
+        "  %1$s() = default;\n"
+        "  %1$s(const %1$s&) = default;\n"
+        "  %1$s(%1$s&&) = default;\n"
+        "  %1$s& operator=(const %1$s&) = default;\n"
+        "  %1$s& operator=(%1$s&&) = default;\n\n";
   if (idl_fprintf(gen->header.handle, fmt, name) < 0)
     return IDL_RETCODE_NO_MEMORY;
 
+  /* allocator-extended constructors */
+  if (gen->pmr && (ret = emit_allocator_constructors(pstate, _struct, gen)))
+    return ret;
+
   if (_struct->members)
   {
     fmt = "  explicit %1$s(\n";
@@ -275,6 +440,37 @@ emit_struct(
   if (_struct->members && (ret = idl_visit(pstate, _struct->members, &visitor, user_data)))
     return ret;
 
+  /* swap */
+  fmt = "\n"
+        "  void swap(%s& _other)\n"
+        "  {\n"
+        "    using std::swap;\n";
+  if (idl_fprintf(gen->header.handle, fmt, name) < 0)
+    return IDL_RETCODE_NO_MEMORY;
+  if (_struct->inherit_spec)
+  {
+    char* base = NULL;
+    if (IDL_PRINTA(&base, get_cpp11_fully_scoped_name, _struct->inherit_spec->base, gen) < 0)
+      return IDL_RETCODE_NO_MEMORY;
+    fmt = "    swap(static_cast<%1$s&>(*this), static_cast<%1$s&>(_other));\n";
+    if (idl_fprintf(gen->header.handle, fmt, base) < 0)
+      return IDL_RETCODE_NO_MEMORY;
+  }
+  visitor.accept[IDL_ACCEPT_DECLARATOR] = &emit_member_swap;
+  if (_struct->members && (ret = idl_visit(pstate, _struct->members, &visitor, user_data)))
+    return ret;
+  if (!_struct->members &&
+      !_struct->inherit_spec &&
+      fputs("    (void)_other;\n", gen->header.handle) < 0)
+    return IDL_RETCODE_NO_MEMORY;
+  fmt = "  }\n\n"
+        "  friend void swap(%1$s& _a, %1$s& _b)\n"
+        "  {\n"
+        "    _a.swap(_b);\n"
+        "  }\n";
+  if (idl_fprintf(gen->header.handle, fmt, name) < 0)
+    return IDL_RETCODE_NO_MEMORY;
+
   /* comparison operators */
   fmt = "\n"
         "  bool operator==(const %s& _other) const\n"
@@ -638,6 +834,15 @@ emit_case_methods(
     "    m__u = u;\n"
     "  }\n\n";
 
+  static const char *move_setter =
+    "    if (!_is_compatible_discriminator(%1$s, d)) {\n"
+    "      throw dds::core::InvalidArgumentError(\n"
+    "        \"Discriminator does not match current discriminator\");\n"
+    "    }\n"
+    "    m__d = d;\n"
+    "    m__u = std::move(u);\n"
+    "  }\n\n";
+
   name = get_cpp11_name(branch->declarator);
   if (IDL_PRINTA(&type, get_cpp11_type, branch->type_spec, gen) < 0)
     return IDL_RETCODE_NO_MEMORY;
@@ -681,7 +886,7 @@ emit_case_methods(
         "  {\n";
   if (idl_fprintf(gen->header.handle, fmt, name, type, discr_type, value) < 0)
     return IDL_RETCODE_NO_MEMORY;
-  if (idl_fprintf(gen->header.handle, setter, value) < 0)
+  if (idl_fprintf(gen->header.handle, move_setter, value) < 0)
     return IDL_RETCODE_NO_MEMORY;
   return IDL_RETCODE_OK;
 }
@@ -777,6 +982,24 @@ emit_union(
   if (fputs(")\n { }\n\n", gen->header.handle) < 0)
     return IDL_RETCODE_NO_MEMORY;
 
+  fmt = "  %1$s(const %1$s&) = default;\n"
+        "  %1$s(%1$s&&) = default;\n"
+        "  %1$s& operator=(const %1$s&) = default;\n"
+        "  %1$s& operator=(%1$s&&) = default;\n\n"
+        "  void swap(%1$s& _other)\n"
+        "  {\n"
+        "    using std::swap;\n"
+        "    swap(m__d, _other.m__d);\n"
+        "    swap(m__u, _other.m__u);\n"
+        "  }\n\n"
+        "  friend void swap(%1$s& _a, %1$s& _b)\n"
+        "  {\n"
+        "    _a.swap(_b);\n"
+        "  }\n\n";
+  /* the variant decides whether the moves are noexcept, see emit_struct */
+  if (idl_fprintf(gen->header.handle, fmt, name) < 0)
+    return IDL_RETCODE_NO_MEMORY;
+
   /* getters and setters */
   visitor.visit = IDL_SWITCH_TYPE_SPEC | IDL_CASE;
   visitor.accept[IDL_ACCEPT_SWITCH_TYPE_SPEC] = emit_discriminator_methods;